@@ -0,0 +1,109 @@
+#pragma once
+
+#include "String.h"
+
+/*********************************************** CLASSES ***************************************************/
+
+/*///////////////////////////////////////// FixedString class ////////////////////////////////////////////*/
+
+/* Text of exactly (N) characters stored inside the object, so it can outlive the constant expression that built it.
+It's a structural type, so with C++20 it can be a template argument: template<FixedString Name> struct Field; */
+template<size_t N> struct FixedString
+{
+	//Types
+	typedef char value_type;
+	typedef const char* const_iterator;
+
+	//Constructors
+	constexpr FixedString() noexcept = default;
+	constexpr FixedString(const char (&str)[N + 1]) noexcept;
+	constexpr FixedString(const char* cptr, size_t n);
+	explicit STRING_CONSTEXPR FixedString(const String& str);
+
+	//Capacity
+	static constexpr size_t size() noexcept { return N; }
+	static constexpr size_t length() noexcept { return N; }
+	static constexpr bool empty() noexcept { return N == 0; }
+
+	//Element access
+	constexpr const char& operator[](size_t n) const;
+	constexpr const char* c_str() const noexcept { return chars; }
+	constexpr const char* data() const noexcept { return chars; }
+	constexpr const_iterator begin() const noexcept { return chars; }
+	constexpr const_iterator end() const noexcept { return chars + N; }
+
+	//Conversions
+	constexpr std::string_view view() const noexcept { return std::string_view(chars, N); }
+	constexpr operator std::string_view() const noexcept { return view(); }
+	STRING_CONSTEXPR String str() const;
+
+	//Operations
+	template<size_t M> constexpr FixedString<N + M> operator+(const FixedString<M>& rhs) const noexcept;
+	template<size_t M> constexpr bool operator==(const FixedString<M>& rhs) const noexcept { return view() == rhs.view(); }
+	template<size_t M> constexpr bool operator!=(const FixedString<M>& rhs) const noexcept { return view() != rhs.view(); }
+	template<size_t M> constexpr bool operator<(const FixedString<M>& rhs) const noexcept { return view() < rhs.view(); }
+
+	//Public, so the type stays structural
+	char chars[N + 1] = {};
+};
+
+/* FixedString("text") has the length of the literal, without the terminator */
+template<size_t N> FixedString(const char (&)[N]) -> FixedString<N - 1>;
+
+/****************************************** FIXEDSTRING FUNCTIONS *********************************************/
+
+/* Copy the string literal */
+template<size_t N> constexpr FixedString<N>::FixedString(const char (&str)[N + 1]) noexcept
+{
+	for (size_t i = 0; i < N; i++)
+		chars[i] = str[i];
+}
+
+/* Copy (n) characters from const char*, (n) has to be N */
+template<size_t N> constexpr FixedString<N>::FixedString(const char* cptr, size_t n)
+{
+	if (n != N)
+		throw std::out_of_range("Length doesn't match the FixedString!");
+	for (size_t i = 0; i < N; i++)
+		chars[i] = cptr[i];
+}
+
+/* Copy the String, its size has to be N. Usual use is FixedString<make().size()> text(make()),
+where make() builds the String in a constant expression */
+template<size_t N> STRING_CONSTEXPR FixedString<N>::FixedString(const String& str)
+{
+	if (str.size() != N)
+		throw std::out_of_range("String's size doesn't match the FixedString!");
+	for (size_t i = 0; i < N; i++)
+		chars[i] = str[i];
+}
+
+/* Return reference to the const character at the given position */
+template<size_t N> constexpr const char& FixedString<N>::operator[](size_t n) const
+{
+	if (n >= N)
+		throw std::out_of_range("Index is out of the range!");
+	return chars[n];
+}
+
+/* Return the text as a String */
+template<size_t N> STRING_CONSTEXPR String FixedString<N>::str() const
+{
+	String result;
+	result.reserve(N);
+	for (size_t i = 0; i < N; i++)
+		result.push_back(chars[i]);
+	return result;
+}
+
+/* Return the FixedString made by appending the other one to this one */
+template<size_t N> template<size_t M>
+constexpr FixedString<N + M> FixedString<N>::operator+(const FixedString<M>& rhs) const noexcept
+{
+	FixedString<N + M> result;
+	for (size_t i = 0; i < N; i++)
+		result.chars[i] = chars[i];
+	for (size_t i = 0; i < M; i++)
+		result.chars[N + i] = rhs.chars[i];
+	return result;
+}
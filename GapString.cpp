@@ -0,0 +1,381 @@
+#include <cstring>
+using std::strlen;
+using std::memcpy;
+using std::memmove;
+using std::memset;
+
+#include <stdexcept>
+using std::out_of_range;
+using std::runtime_error;
+
+#include <memory>
+using std::allocator;
+
+#include <functional>
+using std::less;
+using std::less_equal;
+
+#include "GapString.h"
+
+allocator<char> GapString::alloc;
+
+/*********************************************** HELPERS ***************************************************/
+
+/* Move the gap, so it starts at (pos), moving the characters in between to the other side of it */
+void GapString::move_gap(size_t pos)
+{
+	if (pos < gapStart) {
+		size_t n = gapStart - pos;
+		memmove(buf + gapEnd - n, buf + pos, n);
+		gapStart -= n;
+		gapEnd -= n;
+	}
+	else if (pos > gapStart) {
+		size_t n = pos - gapStart;
+		memmove(buf + gapStart, buf + gapEnd, n);
+		gapStart += n;
+		gapEnd += n;
+	}
+}
+
+/* Make sure the gap has room for (n) characters, growing the buffer geometrically */
+void GapString::make_gap(size_t n)
+{
+	if (gapEnd - gapStart >= n)
+		return;
+	size_t sz = size(), newCap = cap * 2;
+	if (newCap < sz + n)
+		newCap = sz + n;
+	if (newCap < 16)
+		newCap = 16;
+	char* newBuf = allocate(newCap);
+	size_t tail = cap - gapEnd;
+	if (gapStart)
+		memcpy(newBuf, buf, gapStart);
+	if (tail)
+		memcpy(newBuf + newCap - tail, buf + gapEnd, tail);
+	deallocate();
+	buf = newBuf;
+	gapEnd = newCap - tail;
+	cap = newCap;
+}
+
+/* Check if the pointer points into the buffer, moving the gap would shift the text under it */
+bool GapString::aliases(const char* ptr) const noexcept
+{
+	return buf && less_equal<const char*>()(buf, ptr) && less<const char*>()(ptr, buf + cap);
+}
+
+/*********************************************** GAPSTRING FUNCTIONS ***************************************************/
+
+/* Copy the text of the String */
+GapString::GapString(const String& str)
+{
+	insert(0, str.data(), str.size());
+}
+
+/* Copy the text of const char* */
+GapString::GapString(const char* cptr)
+{
+	insert(0, cptr, strlen(cptr));
+}
+
+/* Copy (n) characters of const char* */
+GapString::GapString(const char* cptr, size_t n)
+{
+	insert(0, cptr, n);
+}
+
+/* Copy the other GapString, the copy has its gap at the end */
+GapString::GapString(const GapString& str)
+{
+	size_t sz = str.size();
+	if (sz == 0)
+		return;
+	buf = allocate(sz);
+	cap = gapStart = gapEnd = sz;
+	memcpy(buf, str.buf, str.gapStart);
+	memcpy(buf + str.gapStart, str.buf + str.gapEnd, str.cap - str.gapEnd);
+}
+
+/* Move the buffer from the other GapString */
+GapString::GapString(GapString&& str) noexcept
+	: buf(str.buf), cap(str.cap), gapStart(str.gapStart), gapEnd(str.gapEnd)
+{
+	str.buf = nullptr;
+	str.cap = str.gapStart = str.gapEnd = 0;
+}
+
+/* Assign the other GapString to this one */
+GapString& GapString::operator=(const GapString& str)
+{
+	if (&str != this) {
+		GapString copy(str);
+		swap(copy);
+	}
+	return *this;
+}
+
+/* Move the other GapString to this one */
+GapString& GapString::operator=(GapString&& str) noexcept
+{
+	if (&str != this) {
+		GapString moved(std::move(str));
+		swap(moved);
+	}
+	return *this;
+}
+
+/* Make room for at least (n) characters */
+void GapString::reserve(size_t n)
+{
+	if (n > size())
+		make_gap(n - size());
+}
+
+/* Return reference to the character at the given position */
+char& GapString::operator[](size_t n)
+{
+	if (n >= size())
+		throw out_of_range("Index is out of the range!");
+	return (n < gapStart) ? buf[n] : buf[n + (gapEnd - gapStart)];
+}
+
+/* Return reference to the const character at the given position */
+const char& GapString::operator[](size_t n) const
+{
+	if (n >= size())
+		throw out_of_range("Index is out of the range!");
+	return (n < gapStart) ? buf[n] : buf[n + (gapEnd - gapStart)];
+}
+
+/* Return reference to the last character, if GapString is empty, throw runtime_error */
+char& GapString::back()
+{
+	if (empty())
+		throw runtime_error("back() used on empty GapString!");
+	return (*this)[size() - 1];
+}
+
+/* Return reference to the last, const character, if GapString is empty, throw runtime_error */
+const char& GapString::back() const
+{
+	if (empty())
+		throw runtime_error("back() used on empty GapString!");
+	return (*this)[size() - 1];
+}
+
+/* Return reference to the first character, if GapString is empty, throw runtime_error */
+char& GapString::front()
+{
+	if (empty())
+		throw runtime_error("front() used on empty GapString!");
+	return (*this)[0];
+}
+
+/* Return reference to the first, const character, if GapString is empty, throw runtime_error */
+const char& GapString::front() const
+{
+	if (empty())
+		throw runtime_error("front() used on empty GapString!");
+	return (*this)[0];
+}
+
+/* Append copy of the String */
+GapString& GapString::operator+=(const String& str)
+{
+	return append(str);
+}
+
+/* Append const char* */
+GapString& GapString::operator+=(const char* cptr)
+{
+	return append(cptr);
+}
+
+/* Append the character */
+GapString& GapString::operator+=(char ch)
+{
+	push_back(ch);
+	return *this;
+}
+
+/* Append copy of the String */
+GapString& GapString::append(const String& str)
+{
+	return insert(size(), str.data(), str.size());
+}
+
+/* Append const char* */
+GapString& GapString::append(const char* cptr)
+{
+	return insert(size(), cptr, strlen(cptr));
+}
+
+/* Append (n) characters of const char* */
+GapString& GapString::append(const char* cptr, size_t n)
+{
+	return insert(size(), cptr, n);
+}
+
+/* Append (n) copies of the character */
+GapString& GapString::append(size_t n, char ch)
+{
+	return insert(size(), n, ch);
+}
+
+/* Append the character */
+void GapString::push_back(char ch)
+{
+	insert(size(), 1, ch);
+}
+
+/* Remove the last character, if GapString is empty, throw runtime_error */
+void GapString::pop_back()
+{
+	if (empty())
+		throw runtime_error("pop_back() used on empty GapString!");
+	erase(size() - 1, 1);
+}
+
+/* Insert copy of the String at the given position */
+GapString& GapString::insert(size_t pos, const String& str)
+{
+	return insert(pos, str.data(), str.size());
+}
+
+/* Insert const char* at the given position */
+GapString& GapString::insert(size_t pos, const char* cptr)
+{
+	return insert(pos, cptr, strlen(cptr));
+}
+
+/* Insert (n) characters of const char* at the given position, moving the gap there */
+GapString& GapString::insert(size_t pos, const char* cptr, size_t n)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	if (n == 0)
+		return *this;
+	if (aliases(cptr)) {
+		String copy(cptr, cptr + n);
+		return insert(pos, copy.data(), n);
+	}
+	move_gap(pos);
+	make_gap(n);
+	memcpy(buf + gapStart, cptr, n);
+	gapStart += n;
+	return *this;
+}
+
+/* Insert (n) copies of the character at the given position, moving the gap there */
+GapString& GapString::insert(size_t pos, size_t n, char ch)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	if (n == 0)
+		return *this;
+	move_gap(pos);
+	make_gap(n);
+	memset(buf + gapStart, ch, n);
+	gapStart += n;
+	return *this;
+}
+
+/* Erase (len) characters starting at the given position, by widening the gap over them */
+GapString& GapString::erase(size_t pos, size_t len)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	if (len > size() - pos)
+		len = size() - pos;
+	move_gap(pos);
+	gapEnd += len;
+	return *this;
+}
+
+/* Replace (len) characters starting at the given position with copy of the String */
+GapString& GapString::replace(size_t pos, size_t len, const String& str)
+{
+	return replace(pos, len, str.data(), str.size());
+}
+
+/* Replace (len) characters starting at the given position with const char* */
+GapString& GapString::replace(size_t pos, size_t len, const char* cptr)
+{
+	return replace(pos, len, cptr, strlen(cptr));
+}
+
+/* Replace (len) characters starting at the given position with (n) characters of const char* */
+GapString& GapString::replace(size_t pos, size_t len, const char* cptr, size_t n)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	if (aliases(cptr)) {
+		String copy(cptr, cptr + n);
+		return replace(pos, len, copy.data(), n);
+	}
+	erase(pos, len);
+	return insert(pos, cptr, n);
+}
+
+/* Replace (len) characters starting at the given position with (n) copies of the character */
+GapString& GapString::replace(size_t pos, size_t len, size_t n, char ch)
+{
+	erase(pos, len);
+	return insert(pos, n, ch);
+}
+
+/* Swap the GapStrings */
+void GapString::swap(GapString& str) noexcept
+{
+	std::swap(buf, str.buf);
+	std::swap(cap, str.cap);
+	std::swap(gapStart, str.gapStart);
+	std::swap(gapEnd, str.gapEnd);
+}
+
+/* Return the text as a contiguous String */
+String GapString::str() const
+{
+	String result;
+	result.reserve(size());
+	result.append(buf, buf + gapStart);
+	result.append(buf + gapEnd, buf + cap);
+	return result;
+}
+
+/* Move the gap to the end and return the text, terminated. It stays valid until the next change */
+const char* GapString::c_str()
+{
+	move_gap(size());
+	make_gap(1);
+	buf[gapStart] = '\0';
+	return buf;
+}
+
+/* Check if both GapStrings hold the same text */
+bool operator==(const GapString& lhs, const GapString& rhs)
+{
+	size_t sz = lhs.size();
+	if (sz != rhs.size())
+		return false;
+	for (size_t i = 0; i < sz; i++) {
+		if (lhs[i] != rhs[i])
+			return false;
+	}
+	return true;
+}
+
+/* Check if the GapStrings hold different texts */
+bool operator!=(const GapString& lhs, const GapString& rhs)
+{
+	return !(lhs == rhs);
+}
+
+/* Write the text into the stream, both sides of the gap */
+std::ostream& operator<<(std::ostream& os, const GapString& str)
+{
+	os.write(str.buf, str.gapStart);
+	return os.write(str.buf + str.gapEnd, str.cap - str.gapEnd);
+}
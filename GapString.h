@@ -0,0 +1,110 @@
+#pragma once
+
+#include <memory>
+#include <iostream>
+
+#include "String.h"
+
+/*********************************************** CLASSES ***************************************************/
+
+/*/////////////////////////////////////////// GapString class ///////////////////////////////////////////////*/
+
+/* Text with a movable gap of free space inside its buffer, kept where the last edit happened.
+Inserting and erasing at the gap is O(1) amortized, only moving the gap costs the characters it passes over,
+so edits clustered around a cursor stay cheap. str() copies the text out as a contiguous String */
+class GapString
+{
+private:
+	//Helping functions
+	void move_gap(size_t pos);
+	void make_gap(size_t n);
+	bool aliases(const char* ptr) const noexcept;
+	char* allocate(size_t n) { return alloc.allocate(n); }
+	void deallocate() { if (buf) alloc.deallocate(buf, cap); }
+public:
+	//Types
+	typedef char value_type;
+	typedef size_t size_type;
+
+	//Public const member
+	static const size_t npos = -1;
+
+public:
+	//Constructors, Destructor
+	GapString() = default;
+	GapString(const String& str);
+	GapString(const char* cptr);
+	GapString(const char* cptr, size_t n);
+	GapString(const GapString& str);
+	GapString(GapString&& str) noexcept;
+	~GapString() { deallocate(); }
+
+	//Assignment overloads
+	GapString& operator=(const GapString& str);
+	GapString& operator=(GapString&& str) noexcept;
+
+	//Capacity
+	size_t size() const noexcept { return cap - (gapEnd - gapStart); }
+	size_t length() const noexcept { return size(); }
+	size_t capacity() const noexcept { return cap; }
+	bool empty() const noexcept { return size() == 0; }
+	size_t gap_position() const noexcept { return gapStart; }
+
+	void clear() noexcept { gapStart = 0; gapEnd = cap; }
+	void reserve(size_t n);
+
+	//Element access
+	char& operator[](size_t n);
+	const char& operator[](size_t n) const;
+	char& at(size_t n) { return (*this)[n]; }
+	const char& at(size_t n) const { return (*this)[n]; }
+	char& back();
+	const char& back() const;
+	char& front();
+	const char& front() const;
+
+	//Modifiers
+	GapString& operator+=(const String& str);
+	GapString& operator+=(const char* cptr);
+	GapString& operator+=(char ch);
+
+	GapString& append(const String& str);
+	GapString& append(const char* cptr);
+	GapString& append(const char* cptr, size_t n);
+	GapString& append(size_t n, char ch);
+
+	void push_back(char ch);
+	void pop_back();
+
+	GapString& insert(size_t pos, const String& str);
+	GapString& insert(size_t pos, const char* cptr);
+	GapString& insert(size_t pos, const char* cptr, size_t n);
+	GapString& insert(size_t pos, size_t n, char ch);
+
+	GapString& erase(size_t pos, size_t len = npos);
+
+	GapString& replace(size_t pos, size_t len, const String& str);
+	GapString& replace(size_t pos, size_t len, const char* cptr);
+	GapString& replace(size_t pos, size_t len, const char* cptr, size_t n);
+	GapString& replace(size_t pos, size_t len, size_t n, char ch);
+
+	void swap(GapString& str) noexcept;
+
+	//GapString operations
+	String str() const;
+	const char* c_str();
+
+	//Non-member function overloads
+	friend bool operator==(const GapString& lhs, const GapString& rhs);
+	friend bool operator!=(const GapString& lhs, const GapString& rhs);
+	friend std::ostream& operator<<(std::ostream& os, const GapString& str);
+private:
+	static std::allocator<char> alloc;
+	char* buf = nullptr;
+	size_t cap = 0;
+	size_t gapStart = 0; // The text is [0, gapStart) and [gapEnd, cap) of the buffer
+	size_t gapEnd = 0;
+};
+
+//Just the buffer pointer and its positions, like String
+template<> struct is_trivially_relocatable<GapString> : std::true_type {};
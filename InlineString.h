@@ -0,0 +1,294 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "String.h"
+
+/* What InlineString does, when a change doesn't fit in its capacity */
+enum class Overflow_Policy
+{
+	Throw,    // Throw length_error and leave the text as it was
+	Truncate, // Keep the characters that fit
+	Assert    // assert() in debug builds, truncate when asserts are off
+};
+
+/*********************************************** CLASSES ***************************************************/
+
+/*///////////////////////////////////////// InlineString class ////////////////////////////////////////////*/
+
+/* Text of up to (N) characters stored inside the object, with its length in the smallest unsigned type that can hold N
+(one byte up to 255). It never allocates and is trivially copyable, so it can be kept in arrays and shared memory.
+Searching and comparing follow String */
+template<size_t N, Overflow_Policy Policy = Overflow_Policy::Throw> class InlineString
+{
+public:
+	//Types
+	typedef char value_type;
+	typedef char* iterator;
+	typedef const char* const_iterator;
+	typedef std::conditional_t<(N <= UINT8_MAX), uint8_t, std::conditional_t<(N <= UINT16_MAX), uint16_t, uint32_t>> length_type;
+
+	//Public const member
+	static const size_t npos = -1;
+
+public:
+	//Constructors
+	constexpr InlineString() noexcept = default;
+	constexpr InlineString(const char* cptr) { append(cptr); }
+	constexpr InlineString(const char* cptr, size_t n) { append(cptr, n); }
+	constexpr InlineString(size_t n, char ch) { append(n, ch); }
+	explicit InlineString(const String& str) { append(str); }
+
+	//Capacity
+	constexpr size_t size() const noexcept { return len; }
+	constexpr size_t length() const noexcept { return len; }
+	static constexpr size_t max_size() noexcept { return N; }
+	static constexpr size_t capacity() noexcept { return N; }
+	constexpr bool empty() const noexcept { return len == 0; }
+	constexpr bool full() const noexcept { return len == N; }
+
+	constexpr void clear() noexcept { resize(0); }
+	constexpr void resize(size_t n, char ch = '\0');
+
+	//Element access
+	constexpr char& operator[](size_t n);
+	constexpr const char& operator[](size_t n) const;
+	constexpr char& at(size_t n) { return (*this)[n]; }
+	constexpr const char& at(size_t n) const { return (*this)[n]; }
+	constexpr char& back();
+	constexpr const char& back() const;
+	constexpr char& front();
+	constexpr const char& front() const;
+
+	constexpr iterator begin() noexcept { return chars; }
+	constexpr const_iterator begin() const noexcept { return chars; }
+	constexpr iterator end() noexcept { return chars + len; }
+	constexpr const_iterator end() const noexcept { return chars + len; }
+
+	//Modifiers
+	constexpr InlineString& append(const InlineString& str) { return append_text(str.chars, str.len); }
+	InlineString& append(const String& str) { return append_text(str.data(), str.size()); }
+	constexpr InlineString& append(const char* cptr) { return append_text(cptr, std::char_traits<char>::length(cptr)); }
+	constexpr InlineString& append(const char* cptr, size_t n) { return append_text(cptr, n); }
+	constexpr InlineString& append(size_t n, char ch);
+
+	constexpr InlineString& operator+=(const InlineString& str) { return append(str); }
+	InlineString& operator+=(const String& str) { return append(str); }
+	constexpr InlineString& operator+=(const char* cptr) { return append(cptr); }
+	constexpr InlineString& operator+=(char ch) { return append(1, ch); }
+
+	constexpr void push_back(char ch) { append(1, ch); }
+	constexpr void pop_back();
+	constexpr InlineString& erase(size_t pos, size_t n = npos);
+
+	//String operations
+	constexpr const char* c_str() const noexcept { return chars; }
+	constexpr const char* data() const noexcept { return chars; }
+	constexpr std::string_view view() const noexcept { return std::string_view(chars, len); }
+	constexpr operator std::string_view() const noexcept { return view(); }
+	String str() const { return String(begin(), end()); }
+
+	constexpr size_t find(const InlineString& str, size_t pos = 0) const noexcept { return view().find(str.view(), pos); }
+	constexpr size_t find(const char* cptr, size_t pos = 0) const { return view().find(cptr, pos); }
+	constexpr size_t find(const char* cptr, size_t pos, size_t n) const { return view().find(cptr, pos, n); }
+	constexpr size_t find(char ch, size_t pos = 0) const noexcept { return view().find(ch, pos); }
+	constexpr size_t rfind(const InlineString& str, size_t pos = npos) const noexcept { return view().rfind(str.view(), pos); }
+	constexpr size_t rfind(const char* cptr, size_t pos = npos) const { return view().rfind(cptr, pos); }
+	constexpr size_t rfind(const char* cptr, size_t pos, size_t n) const { return view().rfind(cptr, pos, n); }
+	constexpr size_t rfind(char ch, size_t pos = npos) const noexcept { return view().rfind(ch, pos); }
+
+	constexpr size_t find_first_of(const char* cptr, size_t pos = 0) const { return view().find_first_of(cptr, pos); }
+	constexpr size_t find_first_of(char ch, size_t pos = 0) const noexcept { return view().find_first_of(ch, pos); }
+	constexpr size_t find_last_of(const char* cptr, size_t pos = npos) const { return view().find_last_of(cptr, pos); }
+	constexpr size_t find_last_of(char ch, size_t pos = npos) const noexcept { return view().find_last_of(ch, pos); }
+	constexpr size_t find_first_not_of(const char* cptr, size_t pos = 0) const { return view().find_first_not_of(cptr, pos); }
+	constexpr size_t find_first_not_of(char ch, size_t pos = 0) const noexcept { return view().find_first_not_of(ch, pos); }
+	constexpr size_t find_last_not_of(const char* cptr, size_t pos = npos) const { return view().find_last_not_of(cptr, pos); }
+	constexpr size_t find_last_not_of(char ch, size_t pos = npos) const noexcept { return view().find_last_not_of(ch, pos); }
+
+	constexpr InlineString substr(size_t pos = 0, size_t n = npos) const;
+	constexpr int compare(const InlineString& str) const noexcept { return sign(view().compare(str.view())); }
+	int compare(const String& str) const noexcept { return sign(view().compare(std::string_view(str.data(), str.size()))); }
+	constexpr int compare(const char* cptr) const { return sign(view().compare(cptr)); }
+	constexpr int compare(size_t pos, size_t n, const char* cptr) const;
+
+	//Non-member function overloads
+	friend constexpr bool operator==(const InlineString& lhs, const InlineString& rhs) noexcept { return lhs.compare(rhs) == 0; }
+	friend constexpr bool operator==(const InlineString& lhs, const char* rhs) { return lhs.compare(rhs) == 0; }
+	friend constexpr bool operator!=(const InlineString& lhs, const InlineString& rhs) noexcept { return lhs.compare(rhs) != 0; }
+	friend constexpr bool operator!=(const InlineString& lhs, const char* rhs) { return lhs.compare(rhs) != 0; }
+	friend constexpr bool operator<(const InlineString& lhs, const InlineString& rhs) noexcept { return lhs.compare(rhs) < 0; }
+	friend constexpr bool operator<=(const InlineString& lhs, const InlineString& rhs) noexcept { return lhs.compare(rhs) <= 0; }
+	friend constexpr bool operator>(const InlineString& lhs, const InlineString& rhs) noexcept { return lhs.compare(rhs) > 0; }
+	friend constexpr bool operator>=(const InlineString& lhs, const InlineString& rhs) noexcept { return lhs.compare(rhs) >= 0; }
+
+	friend std::ostream& operator<<(std::ostream& os, const InlineString& str) { return os.write(str.chars, str.len); }
+private:
+	//Helping functions
+	constexpr InlineString& append_text(const char* cptr, size_t n);
+	constexpr size_t room(size_t used, size_t n) const;
+	constexpr size_t filled() const noexcept { return (len < N) ? len : N; }
+	static constexpr int sign(int value) noexcept { return (value > 0) - (value < 0); }
+
+	char chars[N + 1] = {}; // Always terminated, so c_str() is free
+	length_type len = 0;
+};
+
+/****************************************** INLINESTRING FUNCTIONS *********************************************/
+
+/* Return how many of (n) new characters fit after the (used) ones, applying the overflow policy to the ones that don't */
+template<size_t N, Overflow_Policy Policy>
+constexpr size_t InlineString<N, Policy>::room(size_t used, size_t n) const
+{
+	const size_t left = N - used;
+	if (n <= left)
+		return n;
+	if constexpr (Policy == Overflow_Policy::Throw)
+		throw std::length_error("InlineString's capacity exceeded!");
+	else if constexpr (Policy == Overflow_Policy::Assert)
+		assert(!"InlineString's capacity exceeded!");
+	return left;
+}
+
+/* Append (n) characters of the text, that doesn't have to be terminated. The length is read once, as the characters
+written could alias it, and bounded by filled(), so the compiler sees the writes stay inside the characters */
+template<size_t N, Overflow_Policy Policy>
+constexpr InlineString<N, Policy>& InlineString<N, Policy>::append_text(const char* cptr, size_t n)
+{
+	const size_t used = filled();
+	n = room(used, n);
+	char* out = chars + used;
+	for (size_t i = 0; i < n; i++)
+		out[i] = cptr[i];
+	out[n] = '\0';
+	len = length_type(used + n);
+	return *this;
+}
+
+/* Append (n) copies of the character */
+template<size_t N, Overflow_Policy Policy>
+constexpr InlineString<N, Policy>& InlineString<N, Policy>::append(size_t n, char ch)
+{
+	const size_t used = filled();
+	n = room(used, n);
+	char* out = chars + used;
+	for (size_t i = 0; i < n; i++)
+		out[i] = ch;
+	out[n] = '\0';
+	len = length_type(used + n);
+	return *this;
+}
+
+/* Change the length to (n), new characters are copies of (ch) */
+template<size_t N, Overflow_Policy Policy>
+constexpr void InlineString<N, Policy>::resize(size_t n, char ch)
+{
+	const size_t used = filled();
+	if (n > used) {
+		append(n - used, ch);
+		return;
+	}
+	chars[n] = '\0';
+	len = length_type(n);
+}
+
+/* Return reference to the character at the given position */
+template<size_t N, Overflow_Policy Policy>
+constexpr char& InlineString<N, Policy>::operator[](size_t n)
+{
+	if (n >= len)
+		throw std::out_of_range("Index is out of the range!");
+	return chars[n];
+}
+
+/* Return reference to the const character at the given position */
+template<size_t N, Overflow_Policy Policy>
+constexpr const char& InlineString<N, Policy>::operator[](size_t n) const
+{
+	if (n >= len)
+		throw std::out_of_range("Index is out of the range!");
+	return chars[n];
+}
+
+/* Return reference to the last character, if InlineString is empty, throw runtime_error */
+template<size_t N, Overflow_Policy Policy>
+constexpr char& InlineString<N, Policy>::back()
+{
+	if (empty())
+		throw std::runtime_error("back() used on empty InlineString!");
+	return chars[len - 1];
+}
+
+/* Return reference to the last, const character, if InlineString is empty, throw runtime_error */
+template<size_t N, Overflow_Policy Policy>
+constexpr const char& InlineString<N, Policy>::back() const
+{
+	if (empty())
+		throw std::runtime_error("back() used on empty InlineString!");
+	return chars[len - 1];
+}
+
+/* Return reference to the first character, if InlineString is empty, throw runtime_error */
+template<size_t N, Overflow_Policy Policy>
+constexpr char& InlineString<N, Policy>::front()
+{
+	if (empty())
+		throw std::runtime_error("front() used on empty InlineString!");
+	return chars[0];
+}
+
+/* Return reference to the first, const character, if InlineString is empty, throw runtime_error */
+template<size_t N, Overflow_Policy Policy>
+constexpr const char& InlineString<N, Policy>::front() const
+{
+	if (empty())
+		throw std::runtime_error("front() used on empty InlineString!");
+	return chars[0];
+}
+
+/* Remove the last character, if InlineString is empty, throw runtime_error */
+template<size_t N, Overflow_Policy Policy>
+constexpr void InlineString<N, Policy>::pop_back()
+{
+	if (empty())
+		throw std::runtime_error("pop_back() used on empty InlineString!");
+	chars[--len] = '\0';
+}
+
+/* Erase (n) characters starting at the given position */
+template<size_t N, Overflow_Policy Policy>
+constexpr InlineString<N, Policy>& InlineString<N, Policy>::erase(size_t pos, size_t n)
+{
+	if (pos > len)
+		throw std::out_of_range("Position out of range!");
+	if (n > len - pos)
+		n = len - pos;
+	for (size_t i = pos; i + n < len; i++)
+		chars[i] = chars[i + n];
+	len = length_type(len - n);
+	chars[len] = '\0';
+	return *this;
+}
+
+/* Return a copy of the given amount of characters, starting at the given position */
+template<size_t N, Overflow_Policy Policy>
+constexpr InlineString<N, Policy> InlineString<N, Policy>::substr(size_t pos, size_t n) const
+{
+	if (pos > len)
+		throw std::out_of_range("Position out of range!");
+	if (n > len - pos)
+		n = len - pos;
+	InlineString result;
+	result.append_text(chars + pos, n);
+	return result;
+}
+
+/* Compare (n) characters starting at the given position to const char*, return 1, -1 or 0 */
+template<size_t N, Overflow_Policy Policy>
+constexpr int InlineString<N, Policy>::compare(size_t pos, size_t n, const char* cptr) const
+{
+	if (pos > len)
+		throw std::out_of_range("Position out of range!");
+	return sign(view().substr(pos, n).compare(cptr));
+}
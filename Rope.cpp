@@ -0,0 +1,413 @@
+#include <stdexcept>
+using std::out_of_range;
+using std::runtime_error;
+
+#include <utility>
+using std::pair;
+using std::move;
+
+#include <cstring>
+using std::strlen;
+
+#include "Rope.h"
+
+/*********************************************** HELPERS ***************************************************/
+
+/* Return the size of the subtree, empty trees are nullptr */
+size_t Rope::size_of(const Node_Ptr& node) noexcept
+{
+	return node ? node->size : 0;
+}
+
+/* Return the height of the subtree, -1 for the empty one */
+int Rope::height_of(const Node_Ptr& node) noexcept
+{
+	return node ? node->height : -1;
+}
+
+/* Create a leaf holding the text, or nullptr if it's empty */
+Rope::Node_Ptr Rope::make_leaf(String text)
+{
+	if (text.empty())
+		return nullptr;
+	auto node = std::make_shared<Node>();
+	node->size = text.size();
+	node->text = move(text);
+	return node;
+}
+
+/* Create an inner node over both subtrees, they can't be empty */
+Rope::Node_Ptr Rope::make_node(Node_Ptr left, Node_Ptr right)
+{
+	auto node = std::make_shared<Node>();
+	node->size = left->size + right->size;
+	node->height = 1 + ((left->height > right->height) ? left->height : right->height);
+	node->left = move(left);
+	node->right = move(right);
+	return node;
+}
+
+/* Create a node over both subtrees, rotating it if their heights differ by 2 */
+Rope::Node_Ptr Rope::rebalance(Node_Ptr left, Node_Ptr right)
+{
+	if (left->height > right->height + 1) {
+		if (height_of(left->left) >= height_of(left->right))
+			return make_node(left->left, make_node(left->right, move(right)));
+		const Node_Ptr& inner = left->right;
+		return make_node(make_node(left->left, inner->left), make_node(inner->right, move(right)));
+	}
+	if (right->height > left->height + 1) {
+		if (height_of(right->right) >= height_of(right->left))
+			return make_node(make_node(move(left), right->left), right->right);
+		const Node_Ptr& inner = right->left;
+		return make_node(make_node(move(left), inner->left), make_node(inner->right, right->right));
+	}
+	return make_node(move(left), move(right));
+}
+
+/* Join two trees, taking O(difference of their heights). Small neighbouring leaves are merged into one */
+Rope::Node_Ptr Rope::concat(const Node_Ptr& left, const Node_Ptr& right)
+{
+	if (!left)
+		return right;
+	if (!right)
+		return left;
+	if (left->leaf() && right->leaf() && left->size + right->size <= max_leaf)
+		return make_leaf(left->text + right->text);
+	if (left->height > right->height + 1)
+		return rebalance(left->left, concat(left->right, right));
+	if (right->height > left->height + 1)
+		return rebalance(concat(left, right->left), right->right);
+	return make_node(left, right);
+}
+
+/* Split the tree into the first (pos) characters and the rest */
+pair<Rope::Node_Ptr, Rope::Node_Ptr> Rope::split(const Node_Ptr& node, size_t pos)
+{
+	if (!node || pos == 0)
+		return { nullptr, node };
+	if (pos >= node->size)
+		return { node, nullptr };
+	if (node->leaf())
+		return { make_leaf(node->text.substr(0, pos)), make_leaf(node->text.substr(pos)) };
+
+	size_t leftSize = node->left->size;
+	if (pos < leftSize) {
+		auto parts = split(node->left, pos);
+		return { parts.first, concat(parts.second, node->right) };
+	}
+	if (pos == leftSize)
+		return { node->left, node->right };
+	auto parts = split(node->right, pos - leftSize);
+	return { concat(node->left, parts.first), parts.second };
+}
+
+/* Build a balanced tree out of (n) characters, with leaves of at most max_leaf characters */
+Rope::Node_Ptr Rope::build(const char* cptr, size_t n)
+{
+	if (n <= max_leaf)
+		return make_leaf(String(cptr, cptr + n));
+	size_t leaves = (n + max_leaf - 1) / max_leaf;
+	size_t half = (leaves / 2) * max_leaf; // Left side gets whole leaves
+	return make_node(build(cptr, half), build(cptr + half, n - half));
+}
+
+/* Insert the text into the leaf holding (pos), if it still fits there, copying only the path to it.
+Return nullptr if it doesn't fit */
+Rope::Node_Ptr Rope::insert_into_leaf(const Node_Ptr& node, size_t pos, const char* cptr, size_t n)
+{
+	if (node->leaf()) {
+		if (node->size + n > max_leaf)
+			return nullptr;
+		String text;
+		text.reserve(node->size + n);
+		text.append(node->text, 0, pos).append(cptr, cptr + n).append(node->text, pos);
+		return make_leaf(move(text));
+	}
+	// Inserting at the border goes to the end of the left side, so typing keeps extending the same leaf
+	if (pos <= node->left->size) {
+		Node_Ptr left = insert_into_leaf(node->left, pos, cptr, n);
+		return left ? make_node(move(left), node->right) : nullptr;
+	}
+	Node_Ptr right = insert_into_leaf(node->right, pos - node->left->size, cptr, n);
+	return right ? make_node(node->left, move(right)) : nullptr;
+}
+
+/* Return the text of the leaf holding the character at (pos), and the range of positions the leaf holds */
+const char* Rope::leaf_at(size_t pos, size_t& leafStart, size_t& leafEnd) const
+{
+	if (pos >= size())
+		throw out_of_range("Index is out of the range!");
+	const Node* node = root.get();
+	size_t start = 0;
+	while (!node->leaf()) {
+		if (pos - start < node->left->size) {
+			node = node->left.get();
+		}
+		else {
+			start += node->left->size;
+			node = node->right.get();
+		}
+	}
+	leafStart = start;
+	leafEnd = start + node->size;
+	return node->text.data();
+}
+
+/*********************************************** ROPE FUNCTIONS ***************************************************/
+
+/* Copy the text of the String */
+Rope::Rope(const String& str) : root(build(str.data(), str.size()))
+{
+}
+
+/* Copy the text of const char* */
+Rope::Rope(const char* cptr) : root(build(cptr, strlen(cptr)))
+{
+}
+
+/* Copy (n) characters of const char* */
+Rope::Rope(const char* cptr, size_t n) : root(build(cptr, n))
+{
+}
+
+/* Return an iterator to the beginning of the Rope */
+Rope::const_iterator Rope::begin() const noexcept
+{
+	return const_iterator(this, 0);
+}
+
+/* Return an iterator past the end of the Rope */
+Rope::const_iterator Rope::end() const noexcept
+{
+	return const_iterator(this, size());
+}
+
+/* Return a const iterator to the beginning of the Rope */
+Rope::const_iterator Rope::cbegin() const noexcept
+{
+	return begin();
+}
+
+/* Return a const iterator past the end of the Rope */
+Rope::const_iterator Rope::cend() const noexcept
+{
+	return end();
+}
+
+/* Return reference to the character at the given position */
+const char& Rope::operator[](size_t n) const
+{
+	size_t start, end;
+	const char* leaf = leaf_at(n, start, end);
+	return leaf[n - start];
+}
+
+/* Return reference to the character at the given position */
+const char& Rope::at(size_t n) const
+{
+	return (*this)[n];
+}
+
+/* Return reference to the first character, if Rope is empty, throw runtime_error */
+const char& Rope::front() const
+{
+	if (empty())
+		throw runtime_error("front() used on empty Rope!");
+	return (*this)[0];
+}
+
+/* Return reference to the last character, if Rope is empty, throw runtime_error */
+const char& Rope::back() const
+{
+	if (empty())
+		throw runtime_error("back() used on empty Rope!");
+	return (*this)[size() - 1];
+}
+
+/* Append the other Rope, sharing its nodes */
+Rope& Rope::append(const Rope& rope)
+{
+	root = concat(root, rope.root);
+	return *this;
+}
+
+/* Append copy of the String */
+Rope& Rope::append(const String& str)
+{
+	return insert(size(), str.data(), str.size());
+}
+
+/* Append const char* */
+Rope& Rope::append(const char* cptr)
+{
+	return insert(size(), cptr, strlen(cptr));
+}
+
+/* Append (n) characters of const char* */
+Rope& Rope::append(const char* cptr, size_t n)
+{
+	return insert(size(), cptr, n);
+}
+
+/* Append the character */
+void Rope::push_back(char ch)
+{
+	insert(size(), &ch, 1);
+}
+
+/* Append the other Rope */
+Rope& Rope::operator+=(const Rope& rope)
+{
+	return append(rope);
+}
+
+/* Append copy of the String */
+Rope& Rope::operator+=(const String& str)
+{
+	return append(str);
+}
+
+/* Append const char* */
+Rope& Rope::operator+=(const char* cptr)
+{
+	return append(cptr);
+}
+
+/* Append the character */
+Rope& Rope::operator+=(char ch)
+{
+	push_back(ch);
+	return *this;
+}
+
+/* Insert the other Rope at the given position, sharing its nodes */
+Rope& Rope::insert(size_t pos, const Rope& rope)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	auto parts = split(root, pos);
+	root = concat(concat(parts.first, rope.root), parts.second);
+	return *this;
+}
+
+/* Insert copy of the String at the given position */
+Rope& Rope::insert(size_t pos, const String& str)
+{
+	return insert(pos, str.data(), str.size());
+}
+
+/* Insert const char* at the given position */
+Rope& Rope::insert(size_t pos, const char* cptr)
+{
+	return insert(pos, cptr, strlen(cptr));
+}
+
+/* Insert (n) characters of const char* at the given position. Short texts are put straight into the leaf,
+longer ones split the tree there */
+Rope& Rope::insert(size_t pos, const char* cptr, size_t n)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	if (n == 0)
+		return *this;
+	if (root) {
+		if (Node_Ptr changed = insert_into_leaf(root, pos, cptr, n)) {
+			root = move(changed);
+			return *this;
+		}
+	}
+	auto parts = split(root, pos);
+	root = concat(concat(parts.first, build(cptr, n)), parts.second);
+	return *this;
+}
+
+/* Erase (len) characters starting at the given position */
+Rope& Rope::erase(size_t pos, size_t len)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	if (len > size() - pos)
+		len = size() - pos;
+	auto head = split(root, pos);
+	auto tail = split(head.second, len);
+	root = concat(head.first, tail.second);
+	return *this;
+}
+
+/* Replace (len) characters starting at the given position with the other Rope */
+Rope& Rope::replace(size_t pos, size_t len, const Rope& rope)
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	auto head = split(root, pos);
+	auto tail = split(head.second, len);
+	root = concat(concat(head.first, rope.root), tail.second);
+	return *this;
+}
+
+/* Return the Rope of (len) characters starting at the given position, it shares the nodes with this one */
+Rope Rope::substr(size_t pos, size_t len) const
+{
+	if (pos > size())
+		throw out_of_range("Position out of range!");
+	Rope result;
+	result.root = split(split(root, pos).second, len).first;
+	return result;
+}
+
+/* Return the whole text as one String */
+String Rope::flatten() const
+{
+	String result;
+	result.reserve(size());
+	for_each_chunk([&result](const char* text, size_t n) { result.append(text, text + n); });
+	return result;
+}
+
+/* Return the Rope made of both Ropes, sharing their nodes */
+Rope operator+(const Rope& lhs, const Rope& rhs)
+{
+	Rope result;
+	result.root = Rope::concat(lhs.root, rhs.root);
+	return result;
+}
+
+/* Check if both Ropes hold the same text */
+bool operator==(const Rope& lhs, const Rope& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+	if (lhs.root == rhs.root)
+		return true;
+	auto it = rhs.begin();
+	bool equal = true;
+	lhs.for_each_chunk([&](const char* text, size_t n) {
+		for (size_t i = 0; equal && i < n; i++, ++it)
+			equal = (text[i] == *it);
+	});
+	return equal;
+}
+
+/* Check if the Ropes hold different texts */
+bool operator!=(const Rope& lhs, const Rope& rhs)
+{
+	return !(lhs == rhs);
+}
+
+/* Write the text of the Rope into the stream */
+std::ostream& operator<<(std::ostream& os, const Rope& rope)
+{
+	rope.for_each_chunk([&os](const char* text, size_t n) { os.write(text, n); });
+	return os;
+}
+
+/*********************************************** ITERATOR FUNCTIONS ***************************************************/
+
+/* Return the character, finding its leaf only when the iterator left the last one */
+Rope::const_iterator::reference Rope::const_iterator::operator*() const
+{
+	if (!m_leaf || m_pos < m_start || m_pos >= m_end)
+		m_leaf = m_rope->leaf_at(m_pos, m_start, m_end);
+	return m_leaf[m_pos - m_start];
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <memory>
+#include <iterator>
+#include <iostream>
+
+#include "String.h"
+
+/*********************************************** CLASSES ***************************************************/
+
+/*///////////////////////////////////////////// Rope class //////////////////////////////////////////////////*/
+
+/* Text kept in a balanced (AVL) tree, whose leaves are Strings of up to max_leaf characters.
+Inserting, erasing, concatenating, taking substrings and indexing walk one path of the tree, so they take O(log n)
+instead of copying the whole text. Nodes are never changed once built, so copies and substrings share them */
+class Rope
+{
+private:
+	struct Node;
+	typedef std::shared_ptr<const Node> Node_Ptr;
+
+	//Helping functions
+	static Node_Ptr make_leaf(String text);
+	static Node_Ptr make_node(Node_Ptr left, Node_Ptr right);
+	static Node_Ptr rebalance(Node_Ptr left, Node_Ptr right);
+	static Node_Ptr concat(const Node_Ptr& left, const Node_Ptr& right);
+	static std::pair<Node_Ptr, Node_Ptr> split(const Node_Ptr& node, size_t pos);
+	static Node_Ptr build(const char* cptr, size_t n);
+	static Node_Ptr insert_into_leaf(const Node_Ptr& node, size_t pos, const char* cptr, size_t n);
+	static size_t size_of(const Node_Ptr& node) noexcept;
+	static int height_of(const Node_Ptr& node) noexcept;
+	const char* leaf_at(size_t pos, size_t& leafStart, size_t& leafEnd) const;
+public:
+	//Types
+	typedef char value_type;
+	typedef size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	class const_iterator;
+	typedef const_iterator iterator;
+
+	//Public const members
+	static const size_t npos = -1;
+	static const size_t max_leaf = 1024;
+
+public:
+	//Constructors
+	Rope() = default;
+	Rope(const String& str);
+	Rope(const char* cptr);
+	Rope(const char* cptr, size_t n);
+
+	//Iterators
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept;
+	const_iterator cbegin() const noexcept;
+	const_iterator cend() const noexcept;
+
+	//Capacity
+	size_t size() const noexcept { return size_of(root); }
+	size_t length() const noexcept { return size_of(root); }
+	bool empty() const noexcept { return !root; }
+	int depth() const noexcept { return height_of(root); }
+	void clear() noexcept { root.reset(); }
+
+	//Element access
+	const char& operator[](size_t n) const;
+	const char& at(size_t n) const;
+	const char& front() const;
+	const char& back() const;
+
+	//Modifiers
+	Rope& operator+=(const Rope& rope);
+	Rope& operator+=(const String& str);
+	Rope& operator+=(const char* cptr);
+	Rope& operator+=(char ch);
+
+	Rope& append(const Rope& rope);
+	Rope& append(const String& str);
+	Rope& append(const char* cptr);
+	Rope& append(const char* cptr, size_t n);
+	void push_back(char ch);
+
+	Rope& insert(size_t pos, const Rope& rope);
+	Rope& insert(size_t pos, const String& str);
+	Rope& insert(size_t pos, const char* cptr);
+	Rope& insert(size_t pos, const char* cptr, size_t n);
+
+	Rope& erase(size_t pos, size_t len = npos);
+	Rope& replace(size_t pos, size_t len, const Rope& rope);
+
+	void swap(Rope& rope) noexcept { root.swap(rope.root); }
+
+	//Rope operations
+	Rope substr(size_t pos = 0, size_t len = npos) const;
+	String flatten() const;
+	template<typename Function> void for_each_chunk(Function fn) const;
+
+	//Non-member function overloads
+	friend Rope operator+(const Rope& lhs, const Rope& rhs);
+	friend bool operator==(const Rope& lhs, const Rope& rhs);
+	friend bool operator!=(const Rope& lhs, const Rope& rhs);
+	friend std::ostream& operator<<(std::ostream& os, const Rope& rope);
+private:
+	Node_Ptr root;
+};
+
+/*///////////////////////////////////////////// Node struct //////////////////////////////////////////////////*/
+
+/* Leaf with text, or an inner node with both children. Inner nodes cache the size and height of their subtree */
+struct Rope::Node
+{
+	String text;
+	Node_Ptr left;
+	Node_Ptr right;
+	size_t size = 0;
+	int height = 0; // 0 for leaves
+
+	bool leaf() const noexcept { return !left; }
+};
+
+/*////////////////////////////////////////// Rope iterator class ///////////////////////////////////////////////*/
+
+/* Random-access iterator over the characters of a Rope. It remembers the leaf it's in, so walking the text
+only searches the tree once per leaf. Like String's iterators, it's invalidated by changes to the Rope */
+class Rope::const_iterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = char;
+	using difference_type = std::ptrdiff_t;
+	using reference = const char&;
+	using pointer = const char*;
+public:
+	const_iterator() = default;
+	const_iterator(const Rope* rope, size_t pos) : m_rope(rope), m_pos(pos) {}
+
+	/* Iterate operations */
+	const_iterator& operator++() { m_pos++; return *this; }
+	const_iterator operator++(int) { const_iterator result(*this); m_pos++; return result; }
+	const_iterator& operator--() { m_pos--; return *this; }
+	const_iterator operator--(int) { const_iterator result(*this); m_pos--; return result; }
+
+	const_iterator operator+(difference_type n) const { const_iterator result(*this); result.m_pos += n; return result; }
+	const_iterator& operator+=(difference_type n) { m_pos += n; return *this; }
+	const_iterator operator-(difference_type n) const { const_iterator result(*this); result.m_pos -= n; return result; }
+	const_iterator& operator-=(difference_type n) { m_pos -= n; return *this; }
+	difference_type operator-(const const_iterator& rhs) const { return difference_type(m_pos - rhs.m_pos); }
+	friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+
+	/* Access operations */
+	reference operator*() const;
+	reference operator[](difference_type n) const { return *(*this + n); }
+	size_t position() const noexcept { return m_pos; }
+
+	/* Rational operations */
+	bool operator==(const const_iterator& rhs) const { return m_pos == rhs.m_pos; }
+	bool operator!=(const const_iterator& rhs) const { return m_pos != rhs.m_pos; }
+	bool operator<(const const_iterator& rhs) const { return m_pos < rhs.m_pos; }
+	bool operator<=(const const_iterator& rhs) const { return m_pos <= rhs.m_pos; }
+	bool operator>(const const_iterator& rhs) const { return m_pos > rhs.m_pos; }
+	bool operator>=(const const_iterator& rhs) const { return m_pos >= rhs.m_pos; }
+private:
+	const Rope* m_rope = nullptr;
+	size_t m_pos = 0;
+	mutable const char* m_leaf = nullptr; // Text of the leaf, that holds the characters [m_start, m_end)
+	mutable size_t m_start = 0;
+	mutable size_t m_end = 0;
+};
+
+/****************************************** ROPE TEMPLATE FUNCTIONS *********************************************/
+
+/* Call the function with (const char*, size_t) for every leaf, in order */
+template<typename Function> void Rope::for_each_chunk(Function fn) const
+{
+	if (!root)
+		return;
+	const Node* stack[64];
+	size_t top = 0;
+	const Node* node = root.get();
+	while (node || top) {
+		for (; node; node = node->left.get())
+			stack[top++] = node;
+		node = stack[--top];
+		if (node->leaf())
+			fn(node->text.data(), node->text.size());
+		node = node->right.get();
+	}
+}
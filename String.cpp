@@ -1,2366 +1,2380 @@
-#include <cstring>
-using std::strlen;
-using std::strcat;
-
-#include <stdexcept>
-using std::out_of_range;
-using std::runtime_error;
-
-#include <memory>
-using std::allocator;
-using std::uninitialized_copy;
-
-#include <initializer_list>
-using std::initializer_list;
-
-#include "String.h"
-
-allocator<char> String::alloc;
-
-/* Allocate new memory, and move the text to the new place */
-void String::reallocate()
-{
-	size_t s = sz ? sz * 2 : 1;
-	char* newBeg = alloc.allocate(s);
-	char* oldBeg = cp, *temp = newBeg;
-	for (size_t i = 0; i < sz; i++)
-		alloc.construct(newBeg++, std::move(*oldBeg++)); // Move the text from the old place to the new
-	free();
-	cp = newBeg; // Change pointer to new allocator
-	cap = s;
-}
-
-/* Destruct elements, free memory */
-void String::free()
-{
-	if (cp) {
-		for (int i = sz - 1; i >= 0; i--)
-			alloc.destroy(cp + i);
-		alloc.deallocate(cp, cap);
-	}
-	cp = nullptr;
-	sz = cap = 0;
-}
-
-/* Copy text from const char* */
-String::String(const char* ptr) : sz(strlen(ptr)), cp(alloc.allocate(sz)), cap(sz)
-{
-	uninitialized_copy(ptr, ptr + sz, cp);
-}
-
-/* Copy (len) characters from const char* */
-String::String(const char* ptr, size_t len) : sz((len < strlen(ptr)) ? len : strlen(ptr)),
-	cp(alloc.allocate(sz)), cap(sz)
-{
-	uninitialized_copy(ptr, ptr + sz, cp);
-}
-
-/* Copy character (len) times */
-String::String(size_t len, char ch) : sz(len), cp(alloc.allocate(sz)), cap(sz)
-{
-	for (size_t i = 0; i < len; i++)
-		alloc.construct(cp + i, ch);
-}
-
-/* Copy text from initializer_list */
-String::String(initializer_list<char> ls) : sz(ls.size()), cp(alloc.allocate(sz)), cap(sz)
-{
-	auto beg = ls.begin();
-	for (size_t i = 0; i < sz; i++)
-		alloc.construct(cp + i, *beg++);
-}
-
-
-
-/* Copy the other String */
-String::String(const String& str) : sz(str.sz), cp(alloc.allocate(sz)), cap(sz)
-{
-	uninitialized_copy(str.cp, str.cp + sz, cp);
-}
-
-/* Copy (len) characters from String, starting from (pos) character */
-String::String(const String& str, size_t pos, size_t len)
-{
-	if (str.sz > pos)
-		sz = len;
-	else
-		sz = str.sz;
-	if (pos > str.sz)
-		throw out_of_range("Position out of range!");
-	if (len == npos) {
-		sz = str.sz - pos;
-	}
-	cp = alloc.allocate(sz);
-	cap = sz;
-	for (size_t i = 0; i < sz; i++)
-		alloc.construct(cp + i, *(str.cp + pos + i)); // Copie (sz) characters, starting from pos
-}
-
-/* Move the text from one String to the other */
-String::String(String&& str) noexcept : sz(str.sz), cp(str.cp), cap(str.cap)
-{
-	str.cp = nullptr;
-	str.sz = str.cap = 0;
-}
-
-/* Assign one String, to the other */
-String& String::operator=(const String& str)
-{
-	if (cap >= str.cap) {
-		if (cp) {
-			for (int i = sz; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-	}
-	else {
-		free();
-		cp = alloc.allocate(str.cap);
-	}
-	uninitialized_copy(str.cp, str.cp + str.sz, cp);
-	sz = str.sz;
-	cap = str.cap;
-	return *this;
-}
-
-/* Assign text from const char* to this String */
-String& String::operator=(const char* ptr)
-{
-	if (cap >= strlen(ptr)) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = strlen(ptr);
-	}
-	else {
-		free();
-		sz = cap = strlen(ptr);
-		cp = alloc.allocate(cap);
-	}
-	uninitialized_copy(ptr, ptr + sz, cp);
-	return *this;
-}
-
-/* Assign char to this String */
-String& String::operator=(char ch)
-{
-	if (cap >= 1) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = 1;
-	}
-	else {
-		free();
-		sz = cap = 1;
-		cp = alloc.allocate(1);
-	}
-	alloc.construct(cp, ch);
-	return *this;
-}
-
-/* Assign chars from initializer_list to this String */
-String& String::operator=(std::initializer_list<char> ls)
-{
-	if (cap >= ls.size()) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = ls.size();
-	}
-	else {
-		free();
-		sz = cap = ls.size();
-		cp = alloc.allocate(cap);
-	}
-	uninitialized_copy(ls.begin(), ls.end(), cp);
-	return *this;
-}
-
-/* Assign and move one String to the other */
-String& String::operator=(String&& str) noexcept
-{
-	if (this != &str) {
-		free();
-		sz = str.sz;
-		cp = str.cp;
-		cap = str.cap;
-		str.cp = nullptr;
-		str.sz = str.cap = 0;
-	}
-	return *this;
-}
-
-/* Return an iterator to the beginning of this String */
-String::iterator String::begin() noexcept
-{
-	return iterator(cp);
-}
-
-/* Return a const iterator to the beginning of this String */
-String::const_iterator String::begin() const noexcept
-{
-	return const_iterator(cp);
-}
-
-/* Return an iterator to the end of this String */
-String::iterator String::end() noexcept
-{
-	return iterator(cp + sz);
-}
-
-/* Return a const iterator to the end of this String */
-String::const_iterator String::end() const noexcept
-{
-	return const_iterator(cp + sz);
-}
-
-/* Return a reverse iterator to the reverse beginning of this String */
-String::reverse_iterator String::rbegin() noexcept
-{
-	return reverse_iterator(cp + (sz - 1));
-}
-
-/* Return a const reverse iterator to the reverse beginning of this String */
-String::const_reverse_iterator String::rbegin() const noexcept
-{
-	return const_reverse_iterator(cp + (sz - 1));
-}
-
-/* Return a reverse iterator to the reverse end of this String */
-String::reverse_iterator String::rend() noexcept
-{
-	return reverse_iterator(cp - 1);
-}
-
-/* Return a const reverse iterator to the reverse end of this String */
-String::const_reverse_iterator String::rend() const noexcept
-{
-	return const_reverse_iterator(cp - 1);
-}
-
-/* Return a const iterator to the beginning of this String */
-String::const_iterator String::cbegin() const noexcept
-{
-	return const_iterator(cp);
-}
-
-/* Return a const iterator to the end of this String */
-String::const_iterator String::cend() const noexcept
-{
-	return const_iterator(cp + sz);
-}
-
-/* Return a const reverse iterator to the reverse beginning of this String  */
-String::const_reverse_iterator String::crbegin() const noexcept
-{
-	return const_reverse_iterator(cp + sz);
-}
-
-/* Return a const reverse iterator to the reverse end of this String  */
-String::const_reverse_iterator String::crend() const noexcept
-{
-	return const_reverse_iterator(cp - 1);
-}
-
-/* Resize String to the given size, if it is smaller than the current size, remove some characters,
-if it is higher, add null characters */
-void String::resize(size_t n)
-{
-	if (n > sz) {
-		if (n > cap) {
-			auto newCp = alloc.allocate(n);
-			size_t tempSz = sz;
-			for (size_t i = 0; i < sz; i++)
-				alloc.construct(newCp + i, std::move(*(cp + i)));
-			free();
-			cp = newCp;
-			sz = tempSz;
-			cap = n;
-		}
-		for (size_t i = sz; i < n; i++) {
-			alloc.construct(cp + i, NULL);
-		}
-		sz = n;
-	}
-	else if (n < sz) {
-		for (size_t i = sz - 1; i != n; i--)
-			alloc.destroy(cp + i);
-		sz = n;
-	}
-}
-
-/* Resize String to (n) size, if needed fill the rest of the String with given character */
-void String::resize(size_t n, char ch)
-{
-	if (n > sz) {
-		if (n > cap) {
-			auto newCp = alloc.allocate(n);
-			size_t tempSz = sz;
-			for (size_t i = 0; i < sz; i++)
-				alloc.construct(newCp + i, std::move(*(cp + i)));
-			free();
-			cp = newCp;
-			sz = tempSz;
-			cap = n;
-		}
-		for (size_t i = sz; i < n; i++) {
-			alloc.construct(cp + i, ch);
-		}
-		sz = n;
-	}
-	else if (n < sz) {
-		for (size_t i = sz - 1; i != n; i--)
-			alloc.destroy(cp + i);
-		sz = n;
-	}
-}
-
-/* Increase String's capacity to the given size, can't change the size and contents of the String */
-void String::reserve(size_t n)
-{
-	if (n > sz) {
-		if (n > cap) {
-			auto newCp = alloc.allocate(n);
-			size_t tempSz = sz;
-			for (size_t i = 0; i < sz; i++)
-				alloc.construct(newCp + i, std::move(*(cp + i)));
-			free();
-			cap = n;
-			sz = tempSz;
-			cp = newCp;
-		}
-	}
-}
-
-/* Shrink the capacity to the size of String */
-void String::shrink_to_fit()
-{
-	if (cap != sz) {
-		auto newCp = alloc.allocate(sz);
-		size_t tempSz = sz;
-		for (size_t i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		sz = cap = tempSz;
-		cp = newCp;
-	}
-}
-
-/* Return reference to the character at the given position */
-char& String::operator[](size_t pos)
-{
-	if (pos >= sz)
-		throw out_of_range("Index is out of the range!");
-	return *(cp + pos);
-}
-
-/* Return reference to const character at the given position */
-const char& String::operator[](size_t pos) const
-{
-	if (pos >= sz)
-		throw out_of_range("Index is out of the range!");
-	return *(cp + pos);
-}
-
-/* Return reference to the character at the given position */
-char& String::at(size_t pos)
-{
-	if (pos >= sz)
-		throw out_of_range("Index is out of the range!");
-	return *(cp + pos);
-}
-
-/* Return reference to the const character at the given position */
-const char& String::at(size_t pos) const
-{
-	if (pos >= sz)
-		throw out_of_range("Index is out of the range!");
-	return *(cp + pos);
-}
-
-/* Return reference to the last character of String, if String is empty, throw runtime_error */
-char& String::back()
-{
-	if (empty())
-		throw runtime_error("back() used on empty String!");
-	return *(cp + sz - 1);   //last character is at the index sz - 1
-}
-
-/* Return reference to the last, const character of String, if String is empty, throw runtime_error */
-const char& String::back() const
-{
-	if (empty())
-		throw runtime_error("back() used on empty String!");
-	return *(cp + sz - 1);
-}
-
-/* Return reference to the first character of String, if String is empty, throw runtime_error */
-char& String::front()
-{
-	if (empty())
-		throw runtime_error("back() used on empty String!");
-	return *cp;
-}
-
-/* Return reference to the first, const character of String, if String is empty, throw runtime_error */
-const char& String::front() const
-{
-	if (empty())
-		throw runtime_error("back() used on empty String!");
-	return *cp;
-}
-
-/* Append copy of the second String to the first */
-String& String::append(const String& str)
-{
-	size_t newSize = sz + str.sz;
-	if (cap >= newSize) {
-		for (size_t j = 0; j < str.sz; j++)
-			alloc.construct(cp + sz++, *(str.cp + j));
-	}
-	else {
-		auto newCp = alloc.allocate(newSize);
-		size_t i;
-		for (i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		for (size_t j = 0; j < str.sz; j++)
-			alloc.construct(newCp + i++, *(str.cp + j));
-		cp = newCp;
-		sz = cap = newSize;
-	}
-	return *this;
-}
-
-/* Append copy of some characters of the second String, starting at the given postion,
-if length isn't given, copies the entire String starting at the given position */
-String& String::append(const String& str, size_t subpos, size_t sublen)
-{
-	if (subpos >= str.sz)
-		throw out_of_range("Position out of the range!");
-
-	//Calculate sublen, if it is higher than size (str.sz) at position (subpos)
-	if ((str.sz - subpos) < sublen)
-		sublen = str.sz - subpos;
-	size_t newSize = sz + sublen;
-	if (cap >= newSize) {
-		for (size_t j = 0; j < sublen; j++)
-			alloc.construct(cp + sz++, *(str.cp + j + subpos));
-	}
-	else {
-		auto newCp = alloc.allocate(newSize);
-		size_t i;
-		for (i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		for (size_t j = 0; j < sublen; j++)
-			alloc.construct(newCp + i++, *(str.cp + j + subpos));
-		cp = newCp;
-		sz = cap = newSize;
-	}
-	return *this;
-}
-
-/* Append const char* to String */
-String& String::append(const char* ptr)
-{
-	size_t ptrSize = strlen(ptr), newSize = sz + ptrSize;
-	if (cap >= newSize) {
-		for (size_t j = 0; j < ptrSize; j++)
-			alloc.construct(cp + sz++, *(ptr + j));
-	}
-	else {
-		auto newCp = alloc.allocate(newSize);
-		size_t i;
-		for (i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		for (size_t j = 0; j < ptrSize; j++)
-			alloc.construct(newCp + i++, *(ptr + j));
-		cp = newCp;
-		sz = cap = newSize;
-	}
-	return *this;
-}
-
-/* Append given number of characters from const char* to String */
-String& String::append(const char* ptr, size_t n)
-{
-	if (n > strlen(ptr))
-		n = strlen(ptr);
-	size_t newSize = sz + n;
-	if (cap >= newSize) {
-		for (size_t j = 0; j < n; j++)
-			alloc.construct(cp + sz++, *(ptr + j));
-	}
-	else {
-		auto newCp = alloc.allocate(newSize);
-		size_t i;
-		for (i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		for (size_t j = 0; j < n; j++)
-			alloc.construct(newCp + i++, *(ptr + j));
-		cp = newCp;
-		sz = cap = newSize;
-	}
-	return *this;
-}
-
-/* Append given number of copies of the character to String */
-String& String::append(size_t n, char ch)
-{
-	size_t newSize = sz + n;
-	if (cap >= newSize) {
-		for (size_t j = 0; j < n; j++)
-			alloc.construct(cp + sz++, ch);
-	}
-	else {
-		auto newCp = alloc.allocate(newSize);
-		size_t i;
-		for (i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		for (size_t j = 0; j < n; j++)
-			alloc.construct(newCp + i++, ch);
-		cp = newCp;
-		sz = cap = newSize;
-	}
-	return *this;
-}
-
-/* Append copy of initializer_list to String */
-String& String::append(std::initializer_list<char> ls)
-{
-	size_t newSize = sz + ls.size();
-	auto beg = ls.begin();
-	size_t lstSize = ls.size();
-	if (cap >= newSize) {
-		for (size_t j = 0; j < lstSize; j++)
-			alloc.construct(cp + sz++, *(beg + j));
-	}
-	else {
-		auto newCp = alloc.allocate(newSize);
-		size_t i;
-		for (i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		for (size_t j = 0; j < lstSize; j++)
-			alloc.construct(newCp + i++, *(beg + j));
-		cp = newCp;
-		sz = cap = newSize;
-	}
-	return *this;
-}
-
-/* Append given String to this one */
-String& String::operator+=(const String& str)
-{
-	return append(str);
-}
-
-/* Append given const char* to this String */
-String& String::operator+=(const char* ptr)
-{
-	return append(ptr);
-}
-
-/* Append given character to this String */
-String& String::operator+=(char c)
-{
-	return append(1, c);
-}
-
-/* Append given list of characters to this String */
-String& String::operator+=(std::initializer_list<char> ls)
-{
-	return append(ls);
-}
-
-/* Push back character, can reallocate memory if needed */
-void String::push_back(char ch)
-{
-	if (sz < cap) {
-		alloc.construct(cp + sz, ch);
-		sz++;
-	}
-	else {
-		size_t newSize = sz + 1;
-		auto newCp = alloc.allocate(newSize);
-		for (size_t i = 0; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		alloc.construct(newCp + newSize - 1, ch);
-		cp = newCp;
-		sz = cap = newSize;
-	}
-}
-
-/* Assign given string to this one */
-String& String::assign(const String& str)
-{
-	return *this = str;
-}
-
-/* Assign given number of characters from the given String starting at certain position
-to this String */
-String& String::assign(const String& str, size_t subpos, size_t sublen)
-{
-	if (subpos >= str.sz)
-		throw out_of_range("Position out of the range!");
-	if ((str.sz - subpos) < sublen)
-		sublen = str.sz - subpos;
-	if (cap >= sublen) {
-		for (int i = sz - 1; i >= 0; i--)
-			alloc.destroy(cp + i);
-		for (size_t j = 0; j < sublen; j++)
-			alloc.construct(cp + j, *(str.cp + j + subpos));
-		sz = sublen;
-	}
-	else {
-		auto newCp = alloc.allocate(sublen);
-		for (size_t i = 0; i < sublen; i++)
-			alloc.construct(newCp + i, *(str.cp + i + subpos));
-		free();
-		cp = newCp;
-		sz = cap = sublen;
-	}
-	return *this;
-}
-
-/* Assign const char* to this String */
-String& String::assign(const char* ptr)
-{
-	return *this = ptr;
-}
-
-/* Assign first given number of characters from const char* to this String */
-String& String::assign(const char* ptr, size_t n)
-{
-	if (n > strlen(ptr))
-		n = strlen(ptr);
-	if (cap >= n) {
-		for (int i = sz - 1; i >= 0; i--)
-			alloc.destroy(cp + i);
-		for (size_t j = 0; j < n; j++)
-			alloc.construct(cp + j, *(ptr + j));
-		sz = n;
-	}
-	else {
-		auto newCp = alloc.allocate(n);
-		free();
-		for (size_t i = 0; i < n; i++)
-			alloc.construct(newCp + i, *(ptr + i));
-		cp = newCp;
-		sz = cap = n;
-	}
-	return *this;
-}
-
-/* Assign given number of certain character to this String */
-String& String::assign(size_t n, char ch)
-{
-	if (cap >= n) {
-		for (int i = sz - 1; i >= 0; i--)
-			alloc.destroy(cp + i);
-		for (size_t j = 0; j < n; j++)
-			alloc.construct(cp + j, ch);
-		sz = n;
-	}
-	else {
-		free();
-		cp = alloc.allocate(n);
-		for (size_t i = 0; i < n; i++)
-			alloc.construct(cp + i, ch);
-		sz = cap = n;
-	}
-	return *this;
-}
-
-/* Assign list of characters to this String */
-String& String::assign(std::initializer_list<char> ls)
-{
-	size_t lstSize = ls.size();
-	auto beg = ls.begin();
-	if (cap >= lstSize) {
-		for (int i = sz - 1; i >= 0; i--)
-			alloc.destroy(cp + i);
-		for (size_t j = 0; j < lstSize; j++)
-			alloc.construct(cp + j, *(beg + j));
-		sz = lstSize;
-	}
-	else {
-		free();
-		sz = cap = lstSize;
-		cp = alloc.allocate(sz);
-		for (size_t i = 0; i < sz; i++)
-			alloc.construct(cp + i, *(beg + i));
-	}
-	return *this;
-}
-
-/* Assign rvalue String to this one */
-String& String::assign(String&& str) noexcept
-{
-	return operator=(std::move(str));
-}
-
-/* Insert second String into the first, at the given postition */
-String& String::insert(size_t pos, const String& str)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	const size_t newSize = sz + str.sz;
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	for (size_t j = 0; j < str.sz; j++)
-		alloc.construct(cp + i++, *(str.cp + j));
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return *this;
-}
-
-/* Insert given amount of character from the String, to the given position, 
-start copying at the certain posiition */
-String& String::insert(size_t pos, const String& str, size_t subpos, size_t sublen)
-{
-	if (subpos >= str.sz)
-		throw out_of_range("Position out of the range!");
-	if ((str.sz - subpos) < sublen)
-		sublen = str.sz - subpos;
-	size_t newSize = sz + sublen;
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	for (size_t j = 0; j < sublen; j++)
-		alloc.construct(cp + i++, *(str.cp + j + subpos));
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return *this;
-}
-
-/* Insert const char* to this String, at the given position */
-String& String::insert(size_t pos, const char* ptr)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	const size_t ptrSize = strlen(ptr);
-	const size_t newSize = sz + ptrSize;
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	for (size_t j = 0; j < ptrSize; j++)
-		alloc.construct(cp + i++, *(ptr + j));
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return *this;
-}
-
-/* Insert copy of the first given number of characters from const char* to the given position 
-of this String */
-String& String::insert(size_t pos, const char* ptr, size_t n)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (n > strlen(ptr))
-		n = strlen(ptr);
-	const size_t newSize = sz + n;
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	for (size_t j = 0; j < n; j++)
-		alloc.construct(cp + i++, *(ptr + j));
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return *this;
-}
-
-/* Inserts given number of certain character to the String at the given position */
-String& String::insert(size_t pos, size_t n, char ch)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	const size_t newSize = sz + n;
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	for (size_t j = 0; j < n; j++)
-		alloc.construct(cp + i++, ch);
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return *this;
-}
-
-/* Insert given amount of certain character in place where the iterator points */
-String::iterator String::insert(const_iterator p, size_t n, char ch)
-{
-	bool match = false;
-	size_t index = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (beg == p) {
-			match = true;
-			break;
-		}
-	}
-	if (match == false) {
-		match = (end() == p);
-		if (match == false)
-			return end();
-	}
-
-	const size_t newSize = sz + n;
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-
-	size_t i = 0;
-	for (; i < index; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	for (size_t j = 0; j < n; j++)
-		alloc.construct(cp + i++, ch);
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return (begin() + index + n);
-}
-
-/* Insert given character in the place where iterator points to */
-String::iterator String::insert(const_iterator p, char ch)
-{
-	return insert(p, 1, ch);
-}
-
-/* Insert the given list of characters in the place where iterator points to */
-String& String::insert(const_iterator p, std::initializer_list<char> lst)
-{
-	bool match = false;
-	size_t index = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (beg == p) {
-			match = true;
-			break;
-		}
-	}
-	if (match == false) {
-		match = (end() == p);
-		if (match == false)
-			return *this;
-	}
-
-	const size_t newSize = sz + lst.size();
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-
-	size_t i = 0;
-	for (; i < index; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	auto beg = lst.begin();
-	for (size_t j = 0; j < lst.size(); j++)
-		alloc.construct(cp + i++, *beg++);
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return *this;
-}
-
-/* Erase certain amount of characters from this String, starting from the given position */
-String& String::erase(size_t pos, size_t len)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > sz)
-		len = sz - pos;
-	String old(*this);
-	if (cp) {
-		for (int i = sz - 1; i >= 0; i--) 
-			alloc.destroy(cp + i);
-	}
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t rest = i + len;
-	for (; rest < sz; rest++)
-		alloc.construct(cp + i++, *(old.cp + rest));
-	sz -= len;
-	return *this;
-}
-
-/* Erase the character in this String pointed by the given iterator */
-String::iterator String::erase(const_iterator p)
-{
-	bool match = false;
-	size_t index = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (p == beg) {
-			match = true;
-			break;
-		}
-	}
-	if (match == false)
-		return end();
-
-	String old(*this);
-	for (int i = sz - 1; i >= 0; i--)
-		alloc.destroy(cp + i);
-	size_t i = 0;
-	for (; i < index; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t rest = i + 1;
-	for (; rest < sz; rest++, i++)
-		alloc.construct(cp + i, *(old.cp + rest));
-	sz -= 1;
-	return iterator(cp + index);
-}
-
-
-/* Erase the characters in this String pointed by the given iterators range */
-String::iterator String::erase(const_iterator first, const_iterator last)
-{
-	bool match1 = false;
-	bool match2 = false;
-	size_t index_last = 0, index = 0;
-	size_t index_first = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (first == beg) {
-			match1 = true;
-			index_first = index;
-		}
-		if (last == beg) {
-			match2 = true;
-			index_last = index;
-		}
-	}
-	if (match2 == false) {
-		match2 = (last == end());
-		index_last = index;
-	}
-	if (match1 == false || match2 == false)
-		return end();
-
-	String old(*this);
-	for (int i = sz - 1; i >= 0; i--)
-		alloc.destroy(cp + i);
-	size_t i = 0;
-	for (; i < index_first; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t rest = i + (index_last - index_first);
-	for (; rest < sz; rest++, i++)
-		alloc.construct(cp + i, *(old.cp + rest));
-	sz -= (index_last - index_first);
-	return iterator(cp + index_first);
-}
-
-/* Swap the contents of the String, update the size and capacity */
-void String::swap(String& str)
-{
-	std::swap(cp, str.cp);
-	std::swap(sz, str.sz);
-	std::swap(cap, str.cap);
-}
-
-/* Replace certain amount of characters of the String, starting at the given position in the second String */
-String& String::replace(size_t pos, size_t len, const String& str)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-	size_t newSize = sz - len + str.sz;
-
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < pos; i++) //move the old text that is before (pos)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + len;
-	for (size_t j = 0; j < str.sz; j++) //copy text from the second String
-		alloc.construct(newCp + i++, *(str.cp + j));
-	for (size_t j = left; j < sz; j++) //move the rest of the old text
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace the given range with the copy of the given String */
-String& String::replace(const_iterator first, const_iterator last, const String& str)
-{
-	bool match1 = false;
-	bool match2 = false;
-	size_t index_last = 0, index = 0;
-	size_t index_first = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (first == beg) {
-			match1 = true;
-			index_first = index;
-		}
-		if (last == beg) {
-			match2 = true;
-			index_last = index;
-		}
-	}
-	if (match2 == false) {
-		match2 = (last == end());
-		index_last = index;
-	}
-	if (match1 == false || match2 == false)
-		return *this;
-
-	size_t newSize = sz - (index_last - index_first) + str.sz;
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < index_first; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + (index_last - index_first);
-
-	for (size_t j = 0; j < str.sz; j++)
-		alloc.construct(newCp + i++, *(str.cp + j));
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace given amount of characters of this String, starting at the given, with certain number of characters
-from the Second string, starting at the given position */
-String& String::replace(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen)
-{
-	if (pos >= sz || subpos >= str.sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-	if (sublen > (str.sz - subpos))
-		sublen = sz - subpos;
-	size_t newSize = sz - len + sublen;
-
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + len;
-	for (size_t j = 0; j < sublen; j++)
-		alloc.construct(newCp + i++, *(str.cp + j + subpos));
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace given number of characters of this String, starting at certain position, with const char* */
-String& String::replace(size_t pos, size_t len, const char* cptr)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-	size_t ptrSize = strlen(cptr);
-	size_t newSize = sz - len + ptrSize;
-
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + len;
-	for (size_t j = 0; j < ptrSize; j++)
-		alloc.construct(newCp + i++, *(cptr + j));
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace the given range with copy of the const char* */
-String& String::replace(const_iterator first, const_iterator last, const char* cptr)
-{
-	bool match1 = false;
-	bool match2 = false;
-	size_t index_last = 0, index = 0;
-	size_t index_first = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (first == beg) {
-			match1 = true;
-			index_first = index;
-		}
-		if (last == beg) {
-			match2 = true;
-			index_last = index;
-		}
-	}
-	if (match2 == false) {
-		match2 = (last == end());
-		index_last = index;
-	}
-	if (match1 == false || match2 == false)
-		return *this;
-
-	size_t ptrSize = strlen(cptr);
-	size_t newSize = sz - (index_last - index_first) + ptrSize;
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < index_first; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + (index_last - index_first);
-
-	for (size_t j = 0; j < ptrSize; j++)
-		alloc.construct(newCp + i++, *(cptr + j));
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace given amount of characters of this String, starting at certain position, with given amount of characters
-from const char* */
-String& String::replace(size_t pos, size_t len, const char* cptr, size_t n)
-{
-	size_t ptrSize = strlen(cptr);
-	if (n > ptrSize)
-		n = ptrSize;
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-	size_t newSize = sz - len + n;
-
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + len;
-	for (size_t j = 0; j < n; j++)
-		alloc.construct(newCp + i++, *(cptr + j));
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace the given range with the copy of certain amount of characters from const char* */
-String& String::replace(const_iterator first, const_iterator last, const char* cptr, size_t n)
-{
-	bool match1 = false;
-	bool match2 = false;
-	size_t index_last = 0, index = 0;
-	size_t index_first = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (first == beg) {
-			match1 = true;
-			index_first = index;
-		}
-		if (last == beg) {
-			match2 = true;
-			index_last = index;
-		}
-	}
-	if (match2 == false) {
-		match2 = (last == end());
-		index_last = index;
-	}
-	if (match1 == false || match2 == false)
-		return *this;
-
-	size_t ptrSize = strlen(cptr);
-	if (n > ptrSize)
-		n = ptrSize;
-
-	size_t newSize = sz - (index_last - index_first) + n;
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < index_first; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + (index_last - index_first);
-
-	for (size_t j = 0; j < n; j++)
-		alloc.construct(newCp + i++, *(cptr + j));
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace given amount of characters of this String, starting at certain position, with given character */
-String& String::replace(size_t pos, size_t len, size_t n, char ch)
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-	size_t newSize = sz - len + n;
-
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < pos; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + len;
-	for (size_t j = 0; j < n; j++)
-		alloc.construct(newCp + i++, ch);
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace the given range with certain number of the given character */
-String& String::replace(const_iterator first, const_iterator last, size_t n, char ch)
-{
-	bool match1 = false;
-	bool match2 = false;
-	size_t index_last = 0, index = 0;
-	size_t index_first = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (first == beg) {
-			match1 = true;
-			index_first = index;
-		}
-		if (last == beg) {
-			match2 = true;
-			index_last = index;
-		}
-	}
-	if (match2 == false) {
-		match2 = (last == end());
-		index_last = index;
-	}
-	if (match1 == false || match2 == false)
-		return *this;
-
-	size_t newSize = sz - (index_last - index_first) + n;
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < index_first; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + (index_last - index_first);
-
-	for (size_t j = 0; j < n; j++)
-		alloc.construct(newCp + i++, ch);
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Replace the given range with the copy of the list of characters */
-String& String::replace(const_iterator first, const_iterator last, std::initializer_list<char> lst)
-{
-	bool match1 = false;
-	bool match2 = false;
-	size_t index_last = 0, index = 0;
-	size_t index_first = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (first == beg) {
-			match1 = true;
-			index_first = index;
-		}
-		if (last == beg) {
-			match2 = true;
-			index_last = index;
-		}
-	}
-	if (match2 == false) {
-		match2 = (last == end());
-		index_last = index;
-	}
-	if (match1 == false || match2 == false)
-		return *this;
-
-	size_t lstSize = lst.size();
-	size_t newSize = sz - (index_last - index_first) + lstSize;
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-	size_t i = 0;
-	for (; i < index_first; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + (index_last - index_first);
-
-	auto beg = lst.begin();
-	for (size_t j = 0; j < lstSize; j++)
-		alloc.construct(newCp + i++, *beg++);
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
-
-/* Erase the last character of this String */
-void String::pop_back()
-{
-	if (sz != 0)
-		alloc.destroy(cp + --sz);
-}
-
-/* Return const char*, that points to the same place as this String, adds null to the end */
-const char* String::c_str()
-{
-	if (cap == sz) {
-		char* newCp = alloc.allocate(sz + 1);
-		size_t size = sz;
-		uninitialized_copy(cp, cp + sz, newCp);
-		newCp[sz] = '\0';
-		free();
-		sz = size;
-		cp = newCp;
-		cap = sz;
-	}
-
-	else
-		cp[sz] = '\0';
-	return cp;
-}
-
-/* Return const char*, that points to the same place as this String, adds null to the end */
-const char* String::data()
-{
-	return this->c_str();
-}
-
-/* Return the copy of the allocator, that this String uses */
-String::allocator_type String::get_allocator() const noexcept
-{
-	return alloc;
-}
-
-/* Copy given amount of characters of the String, starting at certain position, to the char* */
-size_t String::copy(char* cptr, size_t len, size_t pos) const
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = (sz - pos);
-	for (size_t i = 0, p = pos; i < len; p++)
-		cptr[i++] = *(cp + p);
-	return len;
-}
-
-/* Find given text in this String, starting at the given position */
-size_t String::find(const String& str, size_t pos) const noexcept
-{
-	if (!str.cp)
-		return npos;
-	bool matched = false;
-	for (size_t i = pos; i < sz; i++) {
-		if (*(cp + i) == *(str.cp)) {
-			matched = true;
-			size_t found = i;
-			for (size_t j = 1; j < str.sz; j++) {
-				i++;
-				if (i >= sz || *(cp + i) != *(str.cp + j)) {
-					matched = false;
-					break;
-				}
-			}
-			if (matched)
-				return found;
-		}
-	}
-	return npos;
-}
-
-/* Find given text, in this String, starting at the given position */
-size_t String::find(const char* cptr, size_t pos) const
-{
-	if (!cptr)
-		return npos;
-	bool matched = false;
-	size_t ptrSize = strlen(cptr);
-	for (size_t i = pos; i < sz; i++) {
-		if (*(cp + i) == *(cptr)) {
-			matched = true;
-			size_t found = i;
-			for (size_t j = 1; j < ptrSize; j++) {
-				i++;
-				if (i >= sz || *(cp + i) != *(cptr + j)) {
-					matched = false;
-					break;
-				}
-			}
-			if (matched)
-				return found;
-		}
-	}
-	return npos;
-}
-
-/* Find certain amount of characters of the given text, in this String, starting at the given position */
-size_t String::find(const char* cptr, size_t pos, size_t n) const
-{
-	if (!cptr)
-		return npos;
-	bool matched = false;
-	if (n > strlen(cptr))
-		n = strlen(cptr);
-	for (size_t i = pos; i < sz; i++) {
-		if (*(cp + i) == *(cptr)) {
-			matched = true;
-			size_t found = i;
-			for (size_t j = 1; j < n; j++) {
-				i++;
-				if (i >= sz || *(cp + i) != *(cptr + j)) {
-					matched = false;
-					break;
-				}
-			}
-			if (matched)
-				return found;
-		}
-	}
-	return npos;
-}
-
-/* Find given character, in this String, starting at the given position */
-size_t String::find(char c, size_t pos) const noexcept
-{
-	for (size_t i = pos; i < sz; i++) {
-		if (*(cp + i) == c)
-			return i;
-	}
-	return npos;
-}
-
-/* Find the last copy of the given String, in this String, starting at the given position */
-size_t String::rfind(const String& str, size_t pos) const noexcept
-{
-	if (!str.cp)
-		return false;
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		if (*(cp + i) == *(str.cp + (str.sz - 1))) {
-			long long int found = i - str.sz + 1;
-			for (long long int j = (long long int) str.sz - 2; j >= 0; j--) {
-				i--;
-				if ((i == 0 || j == 0) && (*(cp + i) == *(str.cp + j)))
-					return (size_t)found;
-
-				if (*(cp + i) != *(str.cp + j))
-					break;
-			}
-		}
-	}
-	return npos;
-}
-
-/* Find the last copy of the given text, in this String, starting at the given position */
-size_t String::rfind(const char* cptr, size_t pos) const
-{
-	if (!cptr)
-		return false;
-	long long int ptrSize = strlen(cptr);
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		if (*(cp + i) == *(cptr + (ptrSize - 1))) {
-			long long int found = i - ptrSize + 1;
-			for (long long int j = (long long int) ptrSize - 2; j >= 0; j--) {
-				i--;
-				if ((i == 0 || j == 0) && (*(cp + i) == *(cptr + j)))
-					return (size_t)found;
-
-				if (*(cp + i) != *(cptr + j))
-					break;
-			}
-		}
-	}
-	return npos;
-}
-
-/* Find the last copy of certain amount of characters from the given text, in this String, starting at the given position */
-size_t String::rfind(const char* cptr, size_t pos, size_t n) const
-{
-	if (!cptr)
-		return false;
-	if (n > strlen(cptr))
-		n = strlen(cptr);
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		if (*(cp + i) == *(cptr + (n - 1))) {
-			long long int found = i - n + 1;
-			for (long long int j = (long long int) n - 2; j >= 0; j--) {
-				i--;
-				if ((i == 0 || j == 0) && (*(cp + i) == *(cptr + j)))
-					return (size_t)found;
-
-				if (*(cp + i) != *(cptr + j))
-					break;
-			}
-		}
-	}
-	return npos;
-}
-
-/* Find the copy of the character, in this String, starting at the given position */
-size_t String::rfind(char c, size_t pos) const noexcept
-{
-	for (long long int i = (long long int) sz - 1; i >= pos; i++) {
-		if (*(cp + i) == c)
-			return (size_t)i;
-	}
-	return npos;
-}
-
-/* Find the first character that matches one of the characters in the String, 
-starting at the given position, return its index */
-size_t String::find_first_of(const String& str, size_t pos) const noexcept
-{
-	for (size_t i = pos; i < sz; i++) {
-		for (size_t j = 0; j < str.sz; j++) {
-			if (*(cp + i) == *(cp + j))
-				return i;
-		}
-	}
-	return npos;
-}
-
-/* Find the first character that matches one of the characters of the text, 
-starting at the given position, return its index */
-size_t String::find_first_of(const char* cptr, size_t pos) const
-{
-	size_t ptrSize = strlen(cptr);
-	for (size_t i = pos; i < sz; i++) {
-		for (size_t j = 0; j < ptrSize; j++) {
-			if (*(cp + i) == *(cptr + j))
-				return i;
-		}
-	}
-	return npos;
-}
-
-/* Find the first character that matches one of the given amount of characters from the text,
-starting at the given position, returns its index */
-size_t String::find_first_of(const char* cptr, size_t pos, size_t n) const
-{
-	if (n > strlen(cptr))
-		n = strlen(cptr);
-	for (size_t i = pos; i < sz; i++) {
-		for (size_t j = 0; j < n; j++) {
-			if (*(cp + i) == *(cptr + j))
-				return i;
-		}
-	}
-	return npos;
-}
-
-/* Find the first character that matches the given character
-starting at the given position, return its index */
-size_t String::find_first_of(char ch, size_t pos) const noexcept
-{
-	for (size_t i = pos; i < sz; i++) {
-		if (*(cp + i) == ch)
-			return i;
-	}
-	return npos;
-}
-
-/* Find the last character that matches one of the characters in the String, 
-starting at the given position, return its index */
-size_t String::find_last_of(const String& str, size_t pos) const noexcept
-{
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		for (size_t j = 0; j < str.sz; j++) {
-			if (*(cp + i) == *(str.cp + j))
-				return (size_t) i;
-		}
-	}
-	return npos;
-}
-
-/* Find the last character that matches one of the characters of the text,
-starting at the given position, return its index */
-size_t String::find_last_of(const char* cptr, size_t pos) const
-{
-	size_t ptrSize = strlen(cptr);
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		for (size_t j = 0; j < ptrSize; j++) {
-			if (*(cp + i) == *(cptr + j))
-				return (size_t) i;
-		}
-	}
-	return npos;
-}
-
-/* Find the last character that matches one of the given amount of characters from the text,
-starting at the given position, return its index */
-size_t String::find_last_of(const char* cptr, size_t pos, size_t n) const
-{
-	if (n > strlen(cptr))
-		n = strlen(cptr);
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		for (size_t j = 0; j < n; j++) {
-			if (*(cp + i) == *(cptr + j))
-				return (size_t) i;
-		}
-	}
-	return npos;
-}
-
-/* Find the last character that matches the given character
-starting at the given position, return its index */
-size_t String::find_last_of(char ch, size_t pos) const noexcept
-{
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		if (*(cp + i) == ch)
-			return (size_t) i;
-	}
-	return npos;
-}
-
-/* Find the first character that isn't in the given String, starting at the given position, return its index */
-size_t String::find_first_not_of(const String& str, size_t pos) const noexcept
-{
-	size_t counter;
-	for (size_t i = pos; i < sz; i++) {
-		for (counter = 0; counter < str.sz; counter++) {
-			if (*(cp + i) == *(str.cp + counter))
-				break;
-		}
-		if (counter == str.sz)
-			return i;
-	}
-	return npos;
-}
-
-/* Find the first character that isn't in the given text, starting at the given position, return its index */
-size_t String::find_first_not_of(const char* cptr, size_t pos) const
-{
-	size_t ptrSize = strlen(cptr);
-	size_t counter;
-	for (size_t i = pos; i < sz; i++) {
-		for (counter = 0; counter < ptrSize; counter++) {
-			if (*(cp + i) == *(cptr + counter))
-				break;
-		}
-		if (counter == ptrSize)
-			return i;
-	}
-	return npos;
-}
-
-/* Find the first character that isn't in the given amount of characters from the given text,
-starting at the given position, returns it index */
-size_t String::find_first_not_of(const char* cptr, size_t pos, size_t n) const
-{
-	if (n > strlen(cptr))
-		n = strlen(cptr);
-	size_t counter;
-	for (size_t i = pos; i < sz; i++) {
-		for (counter = 0; counter < n; counter++) {
-			if (*(cp + i) == *(cptr + counter))
-				break;
-		}
-		if (counter == n)
-			return i;
-	}
-	return npos;
-}
-
-/* Find the first character that isn't the given character, return its index */
-size_t String::find_first_not_of(char ch, size_t pos) const noexcept
-{
-	for (size_t i = pos; i < sz; i++) {
-		if (*(cp + i) != ch)
-			return i;
-	}
-	return npos;
-}
-
-/* Find the last character that isn't in the given String, starting at the given position, return its index */
-size_t String::find_last_not_of(const String& str, size_t pos) const noexcept
-{
-	size_t counter;
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		for (counter = 0; counter < str.sz; counter++) {
-			if (*(cp + i) == *(str.cp + counter))
-				break;
-		}
-		if (counter == str.sz)
-			return (size_t) i;
-	}
-	return npos;
-}
-
-/* Find the last character that isn't in the given text, starting at the given position, return its index */
-size_t String::find_last_not_of(const char* cptr, size_t pos) const
-{
-	size_t ptrSize = strlen(cptr);
-	size_t counter;
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		for (counter = 0; counter < ptrSize; counter++) {
-			if (*(cp + i) == *(cptr + counter))
-				break;
-		}
-		if (counter == ptrSize)
-			return (size_t) i;
-	}
-	return npos;
-}
-
-/* Find the last character that isn't in the given amount of characters from the given text,
-starting at the given position, return its index */
-size_t String::find_last_not_of(const char* cptr, size_t pos, size_t n) const
-{
-	if (n > strlen(cptr))
-		n = strlen(cptr);
-	size_t counter;
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		for (counter = 0; counter < n; counter++) {
-			if (*(cp + i) == *(cptr + counter))
-				break;
-		}
-		if (counter == n)
-			return (size_t) i;
-	}
-	return npos;
-}
-
-/* Find the last character that isn't the same as the given character, return its index */
-size_t String::find_last_not_of(char ch, size_t pos) const noexcept
-{
-	for (long long int i = (long long int) sz - 1; i >= pos; i--) {
-		if (*(cp + i) != ch)
-			return (size_t) i;
-	}
-	return npos;
-}
-
-/* Return a copy of the given amount of characters of this String, starting at the given position */
-String String::substr(size_t pos, size_t len) const
-{
-	if (pos == sz)
-		return String();
-	else if (pos > sz)
-		out_of_range("Position out of range!");
-	if (len > sz - pos)
-		len = sz - pos;
-	String result;
-	result.reserve(len);
-	for (size_t i = 0; i < len; i++)
-		result += *(cp + i + pos);
-	return result;
-}
-
-/* Compare one String to the other, 
- return:
-	1 if this String is greater than the given one
-	-1 if this String is lower than the given one
-	0 if two Strings are equal */
-int String::compare(const String& str) const noexcept
-{
-	for (size_t i = 0; i < sz && i < str.sz; i++) {
-		if (*(cp + i) > *(str.cp + i))
-			return 1;
-		if (*(cp + i) < *(str.cp + i))
-			return -1;
-	}
-	
-	if (sz > str.sz)
-		return 1;
-	if (sz < str.sz)
-		return -1;
-	return 0;
-}
-
-/* Compares one given amount of characters of this String 
- starting at the specified position, to the other one, 
- return:
-	1 if this String is greater than the second one
-	-1 if this String is lower than the second one
-	0 if two Strings are equal */
-int String::compare(size_t pos, size_t len, const String & str) const
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-
-	for (size_t i = 0; i < len && i < str.sz; i++) {
-		if (*(cp + pos + i) > *(str.cp + i))
-			return 1;
-		if (*(cp + pos + i) < *(str.cp + i))
-			return -1;
-	}
-
-	if (len > str.sz)
-		return 1;
-	if (len < str.sz)
-		return -1;
-	return 0;
-}
-
-/* Compares one given amount of characters of this String 
- starting at the specified position to the given amount characters of the other String, 
- starting at the specified position, if second length isn't given, it is as long as the string, 
- return:
-	1 if this String is greater than the second one
-	-1 if this String is lower than the second one
-	0 if two Strings are equal */
-int String::compare(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen) const
-{
-	if (pos >= sz || subpos >= str.sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-	if (sublen > (str.sz - subpos))
-		sublen = str.sz - subpos;
-
-	for (size_t i = 0; i < len && i < sublen; ++i) {
-		if (*(cp + pos + i) > *(str.cp + subpos + i))
-			return 1;
-		if (*(cp + pos + i) < *(str.cp + subpos + i))
-			return -1;
-	}
-
-	if (len > sublen)
-		return 1;
-	if (len < sublen)
-		return -1;
-	return 0;
-}
-
-/* Compare this String to the const char*, 
- return:
-	1 if this String is greater than const char*
-	-1 if this String is lower than const char*
-	0 if this String and const char* are equal */
-int String::compare(const char* cptr) const
-{
-	size_t sizeCptr = strlen(cptr);
-	for (size_t i = 0; i < sz && i < sizeCptr; ++i) {
-		if (*(cp + i) > *(cptr + i))
-			return 1;
-		if (*(cp + i) < *(cptr + i))
-			return -1;
-	}
-
-	if (sz > sizeCptr)
-		return 1;
-	if (sz < sizeCptr)
-		return -1;
-	return 0;
-}
-
-/* Compare this given amount of characters of the String, 
- starting at the position specified position, to the const char*, 
- return:
-	1 if this String is greater than const char*
-	-1 if this String is lower than const char*
-	0 if this String and const char* are equal */
-int String::compare(size_t pos, size_t len, const char* cptr) const
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-
-	size_t sizeCptr = strlen(cptr);
-	for (size_t i = 0; i < len && i < sizeCptr; ++i) {
-		if (*(cp + pos + i) > *(cptr + i))
-			return 1;
-		if (*(cp + pos + i) < *(cptr + i))
-			return -1;
-	}
-
-	if (len > sizeCptr)
-		return 1;
-	if (len < sizeCptr)
-		return -1;
-	return 0;
-}
-
-/* Compares this given amount of characters of the String, 
- starting at the specified position, to the given amount of characters of const char*, 
- return:
-	1 if this String is greater than const char*
-	-1 if this String is lower than const char*
-	0 if this String and const char* are equal */
-int String::compare(size_t pos, size_t len, const char* cptr, size_t n) const
-{
-	if (pos >= sz)
-		throw out_of_range("Position out of range!");
-	if (len > (sz - pos))
-		len = sz - pos;
-	size_t sizeCptr = strlen(cptr);
-	if (n > sizeCptr)
-		n = sizeCptr;
-
-	for (size_t i = 0; i < len && i < n; ++i) {
-		if (*(cp + pos + i) > *(cptr + i))
-			return 1;
-		if (*(cp + pos + i) < *(cptr + i))
-			return -1;
-	}
-
-	if (len > n)
-		return 1;
-	if (len < n)
-		return -1;
-	return 0;
-}
-
-/* Return String local copy by appending one String to the other */
-String operator+(const String& lhs, const String& rhs)
-{
-	String result;
-	result.sz = result.cap = lhs.sz + rhs.sz;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, *(lhs.cp + i));
-	for (size_t j = 0; j < rhs.sz; j++)
-		result.alloc.construct(result.cp + i++, *(rhs.cp + j));
-	return result;
-}
-
-/* Return local copy of the String built by appending one String to other the rvalue String */
-String operator+(const String& lhs, String&& rhs)
-{
-	String result;
-	result.sz = result.cap = lhs.sz + rhs.sz;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, *(lhs.cp + i));
-	for (size_t j = 0; j < rhs.sz; j++)
-		result.alloc.construct(result.cp + i++, std::move(*(rhs.cp + j)));
-	return result;
-}
-
-/* Return a local copy of the rvalue String appended with lvalue String */
-String operator+(String&& lhs, const String& rhs)
-{
-	String result;
-	result.sz = result.cap = lhs.sz + rhs.sz;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, std::move(*(lhs.cp + i)));
-	for (size_t j = 0; j < rhs.sz; j++)
-		result.alloc.construct(result.cp + i++, *(rhs.cp + j));
-	return result;
-}
-
-/* Return local copy of the rvalue String appended with another rvalue String */
-String operator+(String&& lhs, String&& rhs)
-{
-	String result;
-	result.sz = result.cap = lhs.sz + rhs.sz;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, std::move(*(lhs.cp + i)));
-	for (size_t j = 0; j < rhs.sz; j++)
-		result.alloc.construct(result.cp + i++, std::move(*(rhs.cp + j)));
-	return result;
-}
-
-/* Return copy of the String constructed by appending String and const char* */
-String operator+(const String& lhs, const char* rhs)
-{
-	String result;
-	size_t ptrSize = strlen(rhs);
-	result.sz = result.cap = lhs.sz + ptrSize;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, *(lhs.cp + i));
-	for (size_t j = 0; j < ptrSize; j++)
-		result.alloc.construct(result.cp + i++, *(rhs + j));
-	return result;
-}
-
-/* Return copy of the rvalue String appended with const char* */
-String operator+(String&& lhs, const char* rhs)
-{
-	String result;
-	size_t ptrSize = strlen(rhs);
-	result.sz = result.cap = lhs.sz + ptrSize;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, std::move(*(lhs.cp + i)));
-	for (size_t j = 0; j < ptrSize; j++)
-		result.alloc.construct(result.cp + i++, *(rhs + j));
-	return result;
-}
-
-/* Return copy of the String created by appending const char* to String */
-String operator+(const char* lhs, const String& rhs)
-{
-	String result;
-	size_t ptrSize = strlen(lhs);
-	result.sz = result.cap = ptrSize + rhs.sz;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < ptrSize; i++)
-		result.alloc.construct(result.cp + i, *(lhs + i));
-	for (size_t j = 0; j < rhs.sz; j++)
-		result.alloc.construct(result.cp + i++, *(rhs.cp + j));
-	return result;
-}
-
-/* Return copy of the String created by appending const char* to rvalue String */
-String operator+(const char* lhs, String&& rhs)
-{
-	String result;
-	size_t ptrSize = strlen(lhs);
-	result.sz = result.cap = ptrSize + rhs.sz;
-	result.cp = result.alloc.allocate(result.sz);
-	size_t i;
-	for (i = 0; i < ptrSize; i++)
-		result.alloc.construct(result.cp + i, *(lhs + i));
-	for (size_t j = 0; j < rhs.sz; j++)
-		result.alloc.construct(result.cp + i++, std::move(*(rhs.cp + j)));
-	return result;
-}
-
-/* Return copy of the String, that is created by appending String and char */
-String operator+(const String& lhs, char rhs)
-{
-	String result;
-	result.sz = result.cap = lhs.sz + 1;
-	result.cp = result.alloc.allocate(result.sz);
-	for (size_t i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, *(lhs.cp + i));
-	result.alloc.construct(result.cp + lhs.sz, rhs);
-	return result;
-}
-
-/* Return copy of the String, created by appending rvalue String with a char */
-String operator+(String&& lhs, char rhs)
-{
-	String result;
-	result.sz = result.cap = lhs.sz + 1;
-	result.cp = result.alloc.allocate(result.sz);
-	for (size_t i = 0; i < lhs.sz; i++)
-		result.alloc.construct(result.cp + i, std::move(*(lhs.cp + i)));
-	result.alloc.construct(result.cp + lhs.sz, rhs);
-	return result;
-}
-
-/* Return copy of the String, created by appending char with a String */
-String operator+(char lhs, const String& rhs) 
-{
-	String result;
-	result.sz = result.cap = rhs.sz + 1;
-	result.cp = result.alloc.allocate(result.sz);
-	result.alloc.construct(result.cp, lhs);
-	size_t size = 1;
-	for (size_t i = 0; i < rhs.sz; i++)
-		result.alloc.construct(result.cp + size++, *(rhs.cp + i));
-	return result;
-}
-
-/* Return copy of the String, created by appending char with a rvalue String */
-String operator+(char lhs, String&& rhs)
-{
-	String result;
-	result.sz = result.cap = rhs.sz + 1;
-	result.cp = result.alloc.allocate(result.sz);
-	result.alloc.construct(result.cp, lhs);
-	size_t size = 1;
-	for (size_t i = 0; i < rhs.sz; i++)
-		result.alloc.construct(result.cp + size++, std::move(*(rhs.cp + i)));
-	return result;
-}
-
-/* Check if one String is the same as the other one */
-bool operator==(const String& lhs, const String& rhs) noexcept
-{
-	return (lhs.compare(rhs) == 0);
-}
-
-/* Check if const char* is the same as the String */
-bool operator==(const char* lhs, const String& rhs)
-{
-	return (rhs.compare(lhs) == 0);
-}
-
-/* Check if String is the same as the const char* */
-bool operator==(const String& lhs, const char* rhs)
-{
-	return (lhs.compare(rhs) == 0);
-}
-
-/* Check if one String isn't the same as the other one */
-bool operator!=(const String& lhs, const String& rhs) noexcept
-{
-	return !(lhs == rhs);
-}
-
-/* Check if const char* isn't the same as the String */
-bool operator!=(const char* lhs, const String& rhs)
-{
-	return !(lhs == rhs);
-}
-
-/* Check if the String isn't the same as the const char* */
-bool operator!=(const String& lhs, const char* rhs)
-{
-	return !(lhs == rhs);
-}
-
-/* Check if the first String is lesser than the other one */
-bool operator<(const String& lhs, const String& rhs) noexcept
-{
-	return (lhs.compare(rhs) < 0);
-}
-
-/* Check if the const char* is lesser than the String */
-bool operator<(const char* lhs, const String& rhs)
-{
-	return (rhs.compare(lhs) > 0);
-}
-
-/* Check if the String is lesser than the const char* */
-bool operator<(const String& lhs, const char* rhs)
-{
-	return (lhs.compare(rhs) < 0);
-}
-
-/* Check if the first String is lesser than or equal to the second String */
-bool operator<=(const String& lhs, const String& rhs) noexcept
-{
-	return (lhs < rhs) || (lhs == rhs);
-}
-
-/* Check if the const char* is lesser than or equal to the String */
-bool operator<=(const char* lhs, const String& rhs)
-{
-	return (lhs < rhs) || (lhs == rhs);
-}
-
-/* Check if the String is lesser than or equal to the const char* */
-bool operator<=(const String& lhs, const char* rhs)
-{
-	return (lhs < rhs) || (lhs == rhs);
-}
-
-/* Check if the first String is greater than the other one */
-bool operator>(const String& lhs, const String& rhs) noexcept
-{
-	return !(lhs < rhs) && (lhs != rhs);
-}
-
-/* Check if the const char* is greater than the String */
-bool operator>(const char* lhs, const String& rhs)
-{
-	return !(lhs < rhs) && (lhs != rhs);
-}
-
-/* Check if the String is greater than the const char* */
-bool operator>(const String& lhs, const char* rhs)
-{
-	return !(lhs < rhs) && (lhs != rhs);
-}
-
-/* Check if the first String is greater than or equal to the second String */
-bool operator>=(const String& lhs, const String& rhs) noexcept
-{
-	return (lhs > rhs) || (lhs == rhs);
-}
-
-/* Check if the const char* is greater than or equal to the String */
-bool operator>=(const char* lhs, const String& rhs)
-{
-	return (lhs > rhs) || (lhs == rhs);
-}
-
-/* Check if the String is greater than or equal to the const char* */
-bool operator>=(const String& lhs, const char* rhs)
-{
-	return (lhs > rhs) || (lhs == rhs);
-}
-
-/* Swap the Strings */
-void swap(String& lhs, String& rhs)
-{
-	lhs.swap(rhs);
-}
-
-/* Read characters into String from the input stream */
-std::istream& operator>>(std::istream& is, String& str)
-{
-	if (!is)
-		return is;
-	char ch;
-	str.clear();
-	while (ch = is.get()) {
-		if (std::isspace(ch))
-			break;
-		str.push_back(ch);
-	}
-	return is;
-}
-
-/* Write String's contents to output stream */
-std::ostream& operator<<(std::ostream& os, const String& str)
-{
-	if (!os)
-		return os;
-	for (size_t i = 0; i < str.sz; i++)
-		os << *(str.cp + i);
-	return os;
-}
-
-/* Read the entire lines from the input stream, up to the delimiter character into the String */
-std::istream& getline(std::istream& is, String& str, char delim)
-{
-	if (!is)
-		return is;
-	str.clear();
-	char ch;
-	while (is.get(ch) && ch != delim)
-		str.push_back(ch);
-	return is;
-}
-
-/* Read the entire lines from the input stream, up to the  delimiter character into the String */
-std::istream& getline(std::istream&& is, String& str, char delim)
-{
-	if (!is)
-		return is;
-	str.clear();
-	char ch;
-	while (is.get(ch) && ch != delim)
-		str.push_back(ch);
-	return is;
-}
-
-/* Read the entire line from the input stream, up to the newline character into the String */
-std::istream& getline(std::istream& is, String& str)
-{
-	if (!is)
-		return is;
-	str.clear();
-	char ch;
-	while (is.get(ch) && ch != '\n')
-		str.push_back(ch);
-	return is;
-}
-
-/* Read the entire line from the input stream, up to the newline character into the String */
-std::istream& getline(std::istream&& is, String& str)
-{
-	if (!is)
-		return is;
-	str.clear();
-	char ch;
-	while (is.get(ch) && ch != '\n')
-		str.push_back(ch);
-	return is;
-}
+#include <cstring>
+using std::strlen;
+using std::strcat;
+using std::memcpy;
+using std::memcmp;
+using std::memchr;
+using std::memmove;
+
+#include <stdexcept>
+using std::out_of_range;
+using std::runtime_error;
+using std::invalid_argument;
+
+#include <charconv>
+using std::to_chars;
+using std::from_chars;
+using std::errc;
+
+#include <cctype>
+
+#include <memory>
+using std::allocator;
+using std::uninitialized_copy;
+
+#include <initializer_list>
+using std::initializer_list;
+
+#include <atomic>
+
+#include <vector>
+using std::vector;
+
+#include <mutex>
+using std::mutex;
+using std::lock_guard;
+
+#include <unordered_map>
+using std::unordered_map;
+
+#include "String.h"
+
+/* SSE2 is always there on x86-64, other targets use the scalar versions of the kernels.
+Defining STRING_SCALAR builds the scalar versions everywhere, the tests check them against the vector ones */
+#if !defined(STRING_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+#define STRING_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* SSSE3 kernels are compiled for their own target and picked at run time, if the processor supports them */
+#if defined(STRING_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define STRING_SSSE3
+#define STRING_SSSE3_TARGET __attribute__((target("ssse3")))
+#include <tmmintrin.h>
+static bool hasSsse3() { return __builtin_cpu_supports("ssse3"); }
+#elif defined(STRING_SSE2) && defined(_MSC_VER)
+#define STRING_SSSE3
+#define STRING_SSSE3_TARGET
+#include <tmmintrin.h>
+static bool hasSsse3() { int info[4]; __cpuid(info, 1); return (info[2] >> 9) & 1; }
+#endif
+
+allocator<char> String::alloc;
+
+/* Return index of the lowest set bit of the mask, it can't be 0 */
+static inline unsigned lowestBit(unsigned mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+/* Return the ASCII lowercase version of the character, leave other characters untouched */
+static inline char asciiLower(char ch)
+{
+	return char(ch ^ (((unsigned char)(ch - 'A') < 26) << 5));
+}
+
+/* Return the ASCII uppercase version of the character, leave other characters untouched */
+static inline char asciiUpper(char ch)
+{
+	return char(ch ^ (((unsigned char)(ch - 'a') < 26) << 5));
+}
+
+#ifdef STRING_SSE2
+/* Flip the case of every byte in the block, that lies in between (first) and (first + 25) */
+static inline __m128i flipCaseBlock(__m128i block, char first)
+{
+	// Move the range to the bottom of signed bytes, so one signed comparison checks both ends
+	__m128i shifted = _mm_add_epi8(block, _mm_set1_epi8(char(0x80 - first)));
+	__m128i inRange = _mm_cmplt_epi8(shifted, _mm_set1_epi8(char(0x80 + 26)));
+	return _mm_xor_si128(block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+}
+#endif
+
+/* Copy (n) characters converting them to the ASCII lowercase or uppercase, (dest) can be the same as (src) */
+static void convertCase(char* dest, const char* src, size_t n, bool upper)
+{
+	size_t i = 0;
+#ifdef STRING_SSE2
+	const char first = upper ? 'a' : 'A';
+	for (; i + 16 <= n; i += 16) {
+		__m128i block = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dest + i), flipCaseBlock(block, first));
+	}
+#endif
+	for (; i < n; i++)
+		dest[i] = upper ? asciiUpper(src[i]) : asciiLower(src[i]);
+}
+
+/* Return index of the first position where the characters differ ignoring ASCII case, or (n) if they don't */
+static size_t caseMismatch(const char* lhs, const char* rhs, size_t n)
+{
+	size_t i = 0;
+#ifdef STRING_SSE2
+	for (; i + 16 <= n; i += 16) {
+		__m128i a = flipCaseBlock(_mm_loadu_si128((const __m128i*)(lhs + i)), 'A');
+		__m128i b = flipCaseBlock(_mm_loadu_si128((const __m128i*)(rhs + i)), 'A');
+		unsigned differ = ~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFF;
+		if (differ)
+			return i + lowestBit(differ);
+	}
+#endif
+	for (; i < n; i++) {
+		if (asciiLower(lhs[i]) != asciiLower(rhs[i]))
+			return i;
+	}
+	return n;
+}
+
+/* Compare two texts ignoring ASCII case, the same way compare() does */
+static int caseCompare(const char* lhs, size_t lhsLen, const char* rhs, size_t rhsLen)
+{
+	size_t common = (lhsLen < rhsLen) ? lhsLen : rhsLen;
+	size_t i = caseMismatch(lhs, rhs, common);
+	if (i < common)
+		return ((unsigned char) asciiLower(lhs[i]) > (unsigned char) asciiLower(rhs[i])) ? 1 : -1;
+	if (lhsLen > rhsLen)
+		return 1;
+	if (lhsLen < rhsLen)
+		return -1;
+	return 0;
+}
+
+/* Allocate new memory, and move the text to the new place */
+void String::reallocate()
+{
+	size_t s = sz ? sz * 2 : 1, size = sz;
+	char* newBeg = allocate(s, sz);
+	char* oldBeg = cp, *temp = newBeg;
+	for (size_t i = 0; i < sz; i++)
+		construct(temp++, std::move(*oldBeg++)); // Move the text from the old place to the new
+	free();
+	cp = newBeg; // Change pointer to new allocator
+	sz = size;
+	cap = s;
+	terminate();
+}
+
+/* Deleter of the buffers, that release() gives up, when they come from alloc */
+void String::deallocate_released(char* p, size_t n)
+{
+	if (p)
+		deallocate(p, n);
+}
+
+/* Make sure there is room for at least (n) characters, growing the capacity geometrically */
+void String::grow(size_t n)
+{
+	if (n > cap)
+		reserve((n > cap * 2) ? n : cap * 2);
+}
+
+/* Return index of the character the pointer points to, the end of the text included, or npos if it's outside of it */
+size_t String::index_of(const char* ptr) const noexcept
+{
+	if (ptr == cp)
+		return 0;
+	if (!cp || std::less<const char*>()(ptr, cp) || std::less<const char*>()(cp + sz, ptr))
+		return npos;
+	return ptr - cp;
+}
+
+/* Append (n) characters, they may be a part of this String */
+void String::append_chars(const char* ptr, size_t n)
+{
+	if (n == 0)
+		return;
+	if (aliases(ptr)) {
+		const size_t offset = ptr - cp;
+		grow(sz + n);
+		ptr = cp + offset;
+	}
+	else {
+		grow(sz + n);
+	}
+	memcpy(cp + sz, ptr, n);
+	sz += n;
+	terminate();
+}
+
+/* Replace the text with (n) characters, they may be a part of this String */
+void String::assign_chars(const char* ptr, size_t n)
+{
+	if (aliases(ptr)) {
+		memmove(cp, ptr, n);
+		sz = n;
+		terminate();
+		return;
+	}
+	sz = 0;
+	append_chars(ptr, n);
+	terminate();
+}
+
+/* Insert (n) characters at the given position, they may be a part of this String */
+void String::insert_chars(size_t pos, const char* ptr, size_t n)
+{
+	replace_chars(pos, 0, ptr, n);
+}
+
+/* Replace (len) characters at the given position with (n) characters, they may be a part of this String */
+void String::replace_chars(size_t pos, size_t len, const char* ptr, size_t n)
+{
+	if (aliases(ptr) && n) {
+		String copy;
+		copy.append_chars(ptr, n);
+		replace_chars(pos, len, copy.cp, n);
+		return;
+	}
+	const size_t newSize = sz - len + n;
+	grow(newSize);
+	if (cp) {
+		memmove(cp + pos + n, cp + pos + len, sz - pos - len);
+		if (n)
+			memcpy(cp + pos, ptr, n);
+	}
+	sz = newSize;
+	terminate();
+}
+
+
+
+/* Assign char to this String */
+String& String::operator=(char ch)
+{
+	if (cap >= 1) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = 1;
+	}
+	else {
+		free();
+		sz = cap = 1;
+		cp = allocate(1);
+	}
+	construct(cp, ch);
+	terminate();
+	return *this;
+}
+
+/* Assign chars from initializer_list to this String */
+String& String::operator=(std::initializer_list<char> ls)
+{
+	if (cap >= ls.size()) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = ls.size();
+	}
+	else {
+		free();
+		sz = cap = ls.size();
+		cp = allocate(cap);
+	}
+	uninitialized_copy(ls.begin(), ls.end(), cp);
+	terminate();
+	return *this;
+}
+
+//Policy of clear(), buffers up to the high-water mark are always kept
+static std::atomic<size_t> highWater(1 << 20);
+static std::atomic<size_t> shrinkBy(4);
+
+/* Set when clear() frees the buffer: when its capacity is above (highWaterMark) bytes, and more than (shrinkRatio)
+times the size of the cleared text. Ratio 0 makes clear() always keep the buffer */
+void String::set_memory_policy(size_t highWaterMark, size_t shrinkRatio) noexcept
+{
+	highWater.store(highWaterMark, std::memory_order_relaxed);
+	shrinkBy.store(shrinkRatio, std::memory_order_relaxed);
+}
+
+/* Check if the buffer is too big to be kept, after clearing (used) characters */
+bool String::oversized(size_t used) const noexcept
+{
+	const size_t ratio = shrinkBy.load(std::memory_order_relaxed);
+	if (ratio == 0 || cap <= highWater.load(std::memory_order_relaxed))
+		return false;
+	return used < cap / ratio;
+}
+
+/* Return the place for (n) more characters after the text, they aren't initialized.
+They become part of the String after commit(), until then the text isn't terminated */
+char* String::prepare(size_t n)
+{
+	grow(sz + n);
+	return cp + sz;
+}
+
+/* Add (n) characters written after prepare() to the text */
+void String::commit(size_t n)
+{
+	if (n > cap - sz)
+		throw out_of_range("commit() of more characters than the capacity holds!");
+	sz += n;
+	terminate();
+}
+
+//Deleters of the adopted buffers by their address, only adopt(), release() and freeing an adopted buffer use them.
+//Never destroyed, so Strings freed during shutdown can still find theirs
+struct Adopted_Buffers
+{
+	mutex lock;
+	unordered_map<const char*, String::Deleter> deleters;
+};
+
+static Adopted_Buffers& adoptedBuffers()
+{
+	static Adopted_Buffers* instance = new Adopted_Buffers;
+	return *instance;
+}
+
+/* Remember the deleter of the adopted buffer */
+static void keepDeleter(const char* p, String::Deleter deleter)
+{
+	Adopted_Buffers& adopted = adoptedBuffers();
+	lock_guard<mutex> guard(adopted.lock);
+	adopted.deleters[p] = deleter;
+}
+
+/* Forget the deleter of the adopted buffer and return it */
+String::Deleter String::take_deleter(const char* p) noexcept
+{
+	Adopted_Buffers& adopted = adoptedBuffers();
+	lock_guard<mutex> guard(adopted.lock);
+	auto found = adopted.deleters.find(p);
+	const Deleter deleter = found->second;
+	adopted.deleters.erase(found);
+	return deleter;
+}
+
+/* Give up the buffer without copying the text, the String is left empty. The caller owns the buffer and frees it
+with its deleter, a String without a buffer returns null data */
+String::Buffer String::release() noexcept
+{
+	Buffer buffer{ cp, sz, cap, cap.adopted() ? take_deleter(cp) : &deallocate_released };
+	cp = nullptr;
+	sz = cap = 0;
+	cap.set_adopted(false);
+	return buffer;
+}
+
+/* Take over the buffer of (capacity + 1) characters, holding the text of (size) characters, without copying it.
+The current buffer is freed, the adopted one is freed with deleter(ptr, capacity) once the String is done with it.
+Adopting the String's own buffer keeps it, with the given size, capacity and deleter */
+void String::adopt(char* ptr, size_t size, size_t capacity, Deleter deleter)
+{
+	if (!deleter)
+		throw invalid_argument("adopt() needs a deleter!");
+	if (size > capacity)
+		throw out_of_range("Size is bigger than the capacity!");
+	// A released buffer of alloc is own again, the deleters of the others are kept before anything changes
+	const bool own = (deleter == &deallocate_released);
+	if (ptr && !own)
+		keepDeleter(ptr, deleter);
+	else if (ptr && ptr == cp && cap.adopted())
+		take_deleter(cp);
+	if (ptr != cp)
+		free();
+	if (!ptr)
+		return;
+	cp = ptr;
+	sz = size;
+	cap = capacity;
+	cap.set_adopted(!own);
+	terminate();
+}
+
+/* Resize String to the given size, if it is smaller than the current size, remove some characters,
+if it is higher, add null characters */
+void String::resize(size_t n)
+{
+	if (n > sz) {
+		if (n > cap) {
+			auto newCp = allocate(n, sz);
+			size_t tempSz = sz;
+			for (size_t i = 0; i < sz; i++)
+				construct(newCp + i, std::move(*(cp + i)));
+			free();
+			cp = newCp;
+			sz = tempSz;
+			cap = n;
+		}
+		for (size_t i = sz; i < n; i++) {
+			construct(cp + i, '\0');
+		}
+		sz = n;
+	}
+	else if (n < sz) {
+		for (size_t i = sz - 1; i != n; i--)
+			destroy(cp + i);
+		sz = n;
+	}
+	terminate();
+}
+
+/* Resize String to (n) size, if needed fill the rest of the String with given character */
+void String::resize(size_t n, char ch)
+{
+	if (n > sz) {
+		if (n > cap) {
+			auto newCp = allocate(n, sz);
+			size_t tempSz = sz;
+			for (size_t i = 0; i < sz; i++)
+				construct(newCp + i, std::move(*(cp + i)));
+			free();
+			cp = newCp;
+			sz = tempSz;
+			cap = n;
+		}
+		for (size_t i = sz; i < n; i++) {
+			construct(cp + i, ch);
+		}
+		sz = n;
+	}
+	else if (n < sz) {
+		for (size_t i = sz - 1; i != n; i--)
+			destroy(cp + i);
+		sz = n;
+	}
+	terminate();
+}
+
+/* Shrink the capacity to the size of String */
+void String::shrink_to_fit()
+{
+	if (cap != sz) {
+		auto newCp = allocate(sz, sz);
+		size_t tempSz = sz;
+		for (size_t i = 0; i < sz; i++)
+			construct(newCp + i, std::move(*(cp + i)));
+		free();
+		sz = cap = tempSz;
+		cp = newCp;
+	}
+	terminate();
+}
+
+/* Assign given string to this one */
+String& String::assign(const String& str)
+{
+	return *this = str;
+}
+
+/* Assign given number of characters from the given String starting at certain position
+to this String */
+String& String::assign(const String& str, size_t subpos, size_t sublen)
+{
+	if (&str == this)
+		return assign(String(str), subpos, sublen);
+	if (subpos > str.sz)
+		throw out_of_range("Position out of the range!");
+	if ((str.sz - subpos) < sublen)
+		sublen = str.sz - subpos;
+	STRING_RECORD(record_copy(sublen));
+	if (cap >= sublen) {
+		for (int i = sz - 1; i >= 0; i--)
+			destroy(cp + i);
+		for (size_t j = 0; j < sublen; j++)
+			construct(cp + j, *(str.cp + j + subpos));
+		sz = sublen;
+	}
+	else {
+		auto newCp = allocate(sublen);
+		for (size_t i = 0; i < sublen; i++)
+			construct(newCp + i, *(str.cp + i + subpos));
+		free();
+		cp = newCp;
+		sz = cap = sublen;
+	}
+	terminate();
+	return *this;
+}
+
+/* Assign const char* to this String */
+String& String::assign(const char* ptr)
+{
+	return *this = ptr;
+}
+
+/* Assign first given number of characters from const char* to this String */
+String& String::assign(const char* ptr, size_t n)
+{
+	if (aliases(ptr))
+		return assign(String(ptr, n));
+	if (n > strlen(ptr))
+		n = strlen(ptr);
+	if (cap >= n) {
+		for (int i = sz - 1; i >= 0; i--)
+			destroy(cp + i);
+		for (size_t j = 0; j < n; j++)
+			construct(cp + j, *(ptr + j));
+		sz = n;
+	}
+	else {
+		auto newCp = allocate(n);
+		free();
+		for (size_t i = 0; i < n; i++)
+			construct(newCp + i, *(ptr + i));
+		cp = newCp;
+		sz = cap = n;
+	}
+	terminate();
+	return *this;
+}
+
+/* Assign given number of certain character to this String */
+String& String::assign(size_t n, char ch)
+{
+	if (cap >= n) {
+		for (int i = sz - 1; i >= 0; i--)
+			destroy(cp + i);
+		for (size_t j = 0; j < n; j++)
+			construct(cp + j, ch);
+		sz = n;
+	}
+	else {
+		free();
+		cp = allocate(n);
+		for (size_t i = 0; i < n; i++)
+			construct(cp + i, ch);
+		sz = cap = n;
+	}
+	terminate();
+	return *this;
+}
+
+/* Assign list of characters to this String */
+String& String::assign(std::initializer_list<char> ls)
+{
+	size_t lstSize = ls.size();
+	auto beg = ls.begin();
+	if (cap >= lstSize) {
+		for (int i = sz - 1; i >= 0; i--)
+			destroy(cp + i);
+		for (size_t j = 0; j < lstSize; j++)
+			construct(cp + j, *(beg + j));
+		sz = lstSize;
+	}
+	else {
+		free();
+		sz = cap = lstSize;
+		cp = allocate(sz);
+		for (size_t i = 0; i < sz; i++)
+			construct(cp + i, *(beg + i));
+	}
+	terminate();
+	return *this;
+}
+
+/* Assign rvalue String to this one */
+String& String::assign(String&& str) noexcept
+{
+	return operator=(std::move(str));
+}
+
+/* Insert second String into the first, at the given postition */
+String& String::insert(size_t pos, const String& str)
+{
+	if (&str == this)
+		return insert(pos, String(str));
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	const size_t newSize = sz + str.sz;
+	String old(*this);
+	if (cap >= newSize) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = newSize;
+	}
+	else {
+		free();
+		cp = allocate(newSize);
+		sz = cap = newSize;
+	}
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t stopPlace = i;
+	for (size_t j = 0; j < str.sz; j++)
+		construct(cp + i++, *(str.cp + j));
+	for (; stopPlace < old.sz; stopPlace++)
+		construct(cp + i++, *(old.cp + stopPlace));
+	terminate();
+	return *this;
+}
+
+/* Insert given amount of character from the String, to the given position, 
+start copying at the certain posiition */
+String& String::insert(size_t pos, const String& str, size_t subpos, size_t sublen)
+{
+	if (&str == this)
+		return insert(pos, String(str), subpos, sublen);
+	if (pos > sz || subpos > str.sz)
+		throw out_of_range("Position out of the range!");
+	if ((str.sz - subpos) < sublen)
+		sublen = str.sz - subpos;
+	size_t newSize = sz + sublen;
+	String old(*this);
+	if (cap >= newSize) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = newSize;
+	}
+	else {
+		free();
+		cp = allocate(newSize);
+		sz = cap = newSize;
+	}
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t stopPlace = i;
+	for (size_t j = 0; j < sublen; j++)
+		construct(cp + i++, *(str.cp + j + subpos));
+	for (; stopPlace < old.sz; stopPlace++)
+		construct(cp + i++, *(old.cp + stopPlace));
+	terminate();
+	return *this;
+}
+
+/* Insert const char* to this String, at the given position */
+String& String::insert(size_t pos, const char* ptr)
+{
+	if (aliases(ptr))
+		return insert(pos, String(ptr));
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	const size_t ptrSize = strlen(ptr);
+	const size_t newSize = sz + ptrSize;
+	String old(*this);
+	if (cap >= newSize) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = newSize;
+	}
+	else {
+		free();
+		cp = allocate(newSize);
+		sz = cap = newSize;
+	}
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t stopPlace = i;
+	for (size_t j = 0; j < ptrSize; j++)
+		construct(cp + i++, *(ptr + j));
+	for (; stopPlace < old.sz; stopPlace++)
+		construct(cp + i++, *(old.cp + stopPlace));
+	terminate();
+	return *this;
+}
+
+/* Insert copy of the first given number of characters from const char* to the given position 
+of this String */
+String& String::insert(size_t pos, const char* ptr, size_t n)
+{
+	if (aliases(ptr))
+		return insert(pos, String(ptr, n));
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	if (n > strlen(ptr))
+		n = strlen(ptr);
+	const size_t newSize = sz + n;
+	String old(*this);
+	if (cap >= newSize) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = newSize;
+	}
+	else {
+		free();
+		cp = allocate(newSize);
+		sz = cap = newSize;
+	}
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t stopPlace = i;
+	for (size_t j = 0; j < n; j++)
+		construct(cp + i++, *(ptr + j));
+	for (; stopPlace < old.sz; stopPlace++)
+		construct(cp + i++, *(old.cp + stopPlace));
+	terminate();
+	return *this;
+}
+
+/* Inserts given number of certain character to the String at the given position */
+String& String::insert(size_t pos, size_t n, char ch)
+{
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	const size_t newSize = sz + n;
+	String old(*this);
+	if (cap >= newSize) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = newSize;
+	}
+	else {
+		free();
+		cp = allocate(newSize);
+		sz = cap = newSize;
+	}
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t stopPlace = i;
+	for (size_t j = 0; j < n; j++)
+		construct(cp + i++, ch);
+	for (; stopPlace < old.sz; stopPlace++)
+		construct(cp + i++, *(old.cp + stopPlace));
+	terminate();
+	return *this;
+}
+
+/* Insert given amount of certain character in place where the iterator points */
+String::iterator String::insert(const_iterator p, size_t n, char ch)
+{
+	bool match = false;
+	size_t index = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (beg == p) {
+			match = true;
+			break;
+		}
+	}
+	if (match == false) {
+		match = (end() == p);
+		if (match == false)
+			return end();
+	}
+
+	const size_t newSize = sz + n;
+	String old(*this);
+	if (cap >= newSize) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = newSize;
+	}
+	else {
+		free();
+		cp = allocate(newSize);
+		sz = cap = newSize;
+	}
+
+	size_t i = 0;
+	for (; i < index; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t stopPlace = i;
+	for (size_t j = 0; j < n; j++)
+		construct(cp + i++, ch);
+	for (; stopPlace < old.sz; stopPlace++)
+		construct(cp + i++, *(old.cp + stopPlace));
+	terminate();
+	return (begin() + index + n);
+}
+
+/* Insert given character in the place where iterator points to */
+String::iterator String::insert(const_iterator p, char ch)
+{
+	return insert(p, 1, ch);
+}
+
+/* Insert the given list of characters in the place where iterator points to */
+String& String::insert(const_iterator p, std::initializer_list<char> lst)
+{
+	bool match = false;
+	size_t index = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (beg == p) {
+			match = true;
+			break;
+		}
+	}
+	if (match == false) {
+		match = (end() == p);
+		if (match == false)
+			return *this;
+	}
+
+	const size_t newSize = sz + lst.size();
+	String old(*this);
+	if (cap >= newSize) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = newSize;
+	}
+	else {
+		free();
+		cp = allocate(newSize);
+		sz = cap = newSize;
+	}
+
+	size_t i = 0;
+	for (; i < index; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t stopPlace = i;
+	auto beg = lst.begin();
+	for (size_t j = 0; j < lst.size(); j++)
+		construct(cp + i++, *beg++);
+	for (; stopPlace < old.sz; stopPlace++)
+		construct(cp + i++, *(old.cp + stopPlace));
+	terminate();
+	return *this;
+}
+
+/* Erase certain amount of characters from this String, starting from the given position */
+String& String::erase(size_t pos, size_t len)
+{
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	if (len > sz - pos)
+		len = sz - pos;
+	String old(*this);
+	if (cp) {
+		for (int i = sz - 1; i >= 0; i--) 
+			destroy(cp + i);
+	}
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t rest = i + len;
+	for (; rest < sz; rest++)
+		construct(cp + i++, *(old.cp + rest));
+	sz -= len;
+	terminate();
+	return *this;
+}
+
+/* Erase the character in this String pointed by the given iterator */
+String::iterator String::erase(const_iterator p)
+{
+	bool match = false;
+	size_t index = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (p == beg) {
+			match = true;
+			break;
+		}
+	}
+	if (match == false)
+		return end();
+
+	String old(*this);
+	for (int i = sz - 1; i >= 0; i--)
+		destroy(cp + i);
+	size_t i = 0;
+	for (; i < index; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t rest = i + 1;
+	for (; rest < sz; rest++, i++)
+		construct(cp + i, *(old.cp + rest));
+	sz -= 1;
+	terminate();
+	return iterator(cp + index);
+}
+
+
+/* Erase the characters in this String pointed by the given iterators range */
+String::iterator String::erase(const_iterator first, const_iterator last)
+{
+	bool match1 = false;
+	bool match2 = false;
+	size_t index_last = 0, index = 0;
+	size_t index_first = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (first == beg) {
+			match1 = true;
+			index_first = index;
+		}
+		if (last == beg) {
+			match2 = true;
+			index_last = index;
+		}
+	}
+	if (match1 == false && first == end()) {
+		match1 = true;
+		index_first = index;
+	}
+	if (match2 == false) {
+		match2 = (last == end());
+		index_last = index;
+	}
+	if (match1 == false || match2 == false)
+		return end();
+
+	String old(*this);
+	for (int i = sz - 1; i >= 0; i--)
+		destroy(cp + i);
+	size_t i = 0;
+	for (; i < index_first; i++)
+		construct(cp + i, *(old.cp + i));
+	size_t rest = i + (index_last - index_first);
+	for (; rest < sz; rest++, i++)
+		construct(cp + i, *(old.cp + rest));
+	sz -= (index_last - index_first);
+	terminate();
+	return iterator(cp + index_first);
+}
+
+/* Swap the contents of the String, update the size and capacity */
+void String::swap(String& str)
+{
+	std::swap(cp, str.cp);
+	std::swap(sz, str.sz);
+	const Capacity capacity = cap;
+	const bool adopted = cap.adopted();
+	cap = str.cap;
+	cap.set_adopted(str.cap.adopted());
+	str.cap = capacity;
+	str.cap.set_adopted(adopted);
+}
+
+/* Replace certain amount of characters of the String, starting at the given position in the second String */
+String& String::replace(size_t pos, size_t len, const String& str)
+{
+	if (&str == this)
+		return replace(pos, len, String(str));
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+	size_t newSize = sz - len + str.sz;
+
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - len);
+	size_t i = 0;
+	for (; i < pos; i++) //move the old text that is before (pos)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + len;
+	for (size_t j = 0; j < str.sz; j++) //copy text from the second String
+		construct(newCp + i++, *(str.cp + j));
+	for (size_t j = left; j < sz; j++) //move the rest of the old text
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace the given range with the copy of the given String */
+String& String::replace(const_iterator first, const_iterator last, const String& str)
+{
+	if (&str == this)
+		return replace(first, last, String(str));
+	bool match1 = false;
+	bool match2 = false;
+	size_t index_last = 0, index = 0;
+	size_t index_first = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (first == beg) {
+			match1 = true;
+			index_first = index;
+		}
+		if (last == beg) {
+			match2 = true;
+			index_last = index;
+		}
+	}
+	if (match1 == false && first == end()) {
+		match1 = true;
+		index_first = index;
+	}
+	if (match2 == false) {
+		match2 = (last == end());
+		index_last = index;
+	}
+	if (match1 == false || match2 == false)
+		return *this;
+
+	size_t newSize = sz - (index_last - index_first) + str.sz;
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - (index_last - index_first));
+	size_t i = 0;
+	for (; i < index_first; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + (index_last - index_first);
+
+	for (size_t j = 0; j < str.sz; j++)
+		construct(newCp + i++, *(str.cp + j));
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace given amount of characters of this String, starting at the given, with certain number of characters
+from the Second string, starting at the given position */
+String& String::replace(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen)
+{
+	if (&str == this)
+		return replace(pos, len, String(str), subpos, sublen);
+	if (pos > sz || subpos > str.sz)
+		throw out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+	if (sublen > (str.sz - subpos))
+		sublen = str.sz - subpos;
+	size_t newSize = sz - len + sublen;
+
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - len);
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + len;
+	for (size_t j = 0; j < sublen; j++)
+		construct(newCp + i++, *(str.cp + j + subpos));
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace given number of characters of this String, starting at certain position, with const char* */
+String& String::replace(size_t pos, size_t len, const char* cptr)
+{
+	if (aliases(cptr))
+		return replace(pos, len, String(cptr));
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+	size_t ptrSize = strlen(cptr);
+	size_t newSize = sz - len + ptrSize;
+
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - len);
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + len;
+	for (size_t j = 0; j < ptrSize; j++)
+		construct(newCp + i++, *(cptr + j));
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace the given range with copy of the const char* */
+String& String::replace(const_iterator first, const_iterator last, const char* cptr)
+{
+	if (aliases(cptr))
+		return replace(first, last, String(cptr));
+	bool match1 = false;
+	bool match2 = false;
+	size_t index_last = 0, index = 0;
+	size_t index_first = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (first == beg) {
+			match1 = true;
+			index_first = index;
+		}
+		if (last == beg) {
+			match2 = true;
+			index_last = index;
+		}
+	}
+	if (match1 == false && first == end()) {
+		match1 = true;
+		index_first = index;
+	}
+	if (match2 == false) {
+		match2 = (last == end());
+		index_last = index;
+	}
+	if (match1 == false || match2 == false)
+		return *this;
+
+	size_t ptrSize = strlen(cptr);
+	size_t newSize = sz - (index_last - index_first) + ptrSize;
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - (index_last - index_first));
+	size_t i = 0;
+	for (; i < index_first; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + (index_last - index_first);
+
+	for (size_t j = 0; j < ptrSize; j++)
+		construct(newCp + i++, *(cptr + j));
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace given amount of characters of this String, starting at certain position, with given amount of characters
+from const char* */
+String& String::replace(size_t pos, size_t len, const char* cptr, size_t n)
+{
+	if (aliases(cptr))
+		return replace(pos, len, String(cptr, n));
+	size_t ptrSize = strlen(cptr);
+	if (n > ptrSize)
+		n = ptrSize;
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+	size_t newSize = sz - len + n;
+
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - len);
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + len;
+	for (size_t j = 0; j < n; j++)
+		construct(newCp + i++, *(cptr + j));
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace the given range with the copy of certain amount of characters from const char* */
+String& String::replace(const_iterator first, const_iterator last, const char* cptr, size_t n)
+{
+	if (aliases(cptr))
+		return replace(first, last, String(cptr, n));
+	bool match1 = false;
+	bool match2 = false;
+	size_t index_last = 0, index = 0;
+	size_t index_first = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (first == beg) {
+			match1 = true;
+			index_first = index;
+		}
+		if (last == beg) {
+			match2 = true;
+			index_last = index;
+		}
+	}
+	if (match1 == false && first == end()) {
+		match1 = true;
+		index_first = index;
+	}
+	if (match2 == false) {
+		match2 = (last == end());
+		index_last = index;
+	}
+	if (match1 == false || match2 == false)
+		return *this;
+
+	size_t ptrSize = strlen(cptr);
+	if (n > ptrSize)
+		n = ptrSize;
+
+	size_t newSize = sz - (index_last - index_first) + n;
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - (index_last - index_first));
+	size_t i = 0;
+	for (; i < index_first; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + (index_last - index_first);
+
+	for (size_t j = 0; j < n; j++)
+		construct(newCp + i++, *(cptr + j));
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace given amount of characters of this String, starting at certain position, with given character */
+String& String::replace(size_t pos, size_t len, size_t n, char ch)
+{
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+	size_t newSize = sz - len + n;
+
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - len);
+	size_t i = 0;
+	for (; i < pos; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + len;
+	for (size_t j = 0; j < n; j++)
+		construct(newCp + i++, ch);
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace the given range with certain number of the given character */
+String& String::replace(const_iterator first, const_iterator last, size_t n, char ch)
+{
+	bool match1 = false;
+	bool match2 = false;
+	size_t index_last = 0, index = 0;
+	size_t index_first = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (first == beg) {
+			match1 = true;
+			index_first = index;
+		}
+		if (last == beg) {
+			match2 = true;
+			index_last = index;
+		}
+	}
+	if (match1 == false && first == end()) {
+		match1 = true;
+		index_first = index;
+	}
+	if (match2 == false) {
+		match2 = (last == end());
+		index_last = index;
+	}
+	if (match1 == false || match2 == false)
+		return *this;
+
+	size_t newSize = sz - (index_last - index_first) + n;
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - (index_last - index_first));
+	size_t i = 0;
+	for (; i < index_first; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + (index_last - index_first);
+
+	for (size_t j = 0; j < n; j++)
+		construct(newCp + i++, ch);
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Replace the given range with the copy of the list of characters */
+String& String::replace(const_iterator first, const_iterator last, std::initializer_list<char> lst)
+{
+	bool match1 = false;
+	bool match2 = false;
+	size_t index_last = 0, index = 0;
+	size_t index_first = 0;
+	for (iterator beg = begin(); beg != end(); beg++, index++) {
+		if (first == beg) {
+			match1 = true;
+			index_first = index;
+		}
+		if (last == beg) {
+			match2 = true;
+			index_last = index;
+		}
+	}
+	if (match1 == false && first == end()) {
+		match1 = true;
+		index_first = index;
+	}
+	if (match2 == false) {
+		match2 = (last == end());
+		index_last = index;
+	}
+	if (match1 == false || match2 == false)
+		return *this;
+
+	size_t lstSize = lst.size();
+	size_t newSize = sz - (index_last - index_first) + lstSize;
+	const size_t newCap = (newSize > cap) ? newSize : cap;
+	auto newCp = allocate(newCap, sz - (index_last - index_first));
+	size_t i = 0;
+	for (; i < index_first; i++)
+		construct(newCp + i, std::move(*(cp + i)));
+	size_t left = i + (index_last - index_first);
+
+	auto beg = lst.begin();
+	for (size_t j = 0; j < lstSize; j++)
+		construct(newCp + i++, *beg++);
+	for (size_t j = left; j < sz; j++)
+		construct(newCp + i++, std::move(*(cp + j)));
+
+	free();
+	sz = newSize;
+	cap = newCap;
+	cp = newCp;
+	terminate();
+	return *this;
+}
+
+/* Erase the last character of this String */
+void String::pop_back()
+{
+	if (sz != 0)
+		destroy(cp + --sz);
+	terminate();
+}
+
+/* Return the copy of the allocator, that this String uses */
+String::allocator_type String::get_allocator() const noexcept
+{
+	return alloc;
+}
+
+/* Copy given amount of characters of the String, starting at certain position, to the char* */
+size_t String::copy(char* cptr, size_t len, size_t pos) const
+{
+	if (pos > sz)
+		throw out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = (sz - pos);
+	for (size_t i = 0, p = pos; i < len; p++)
+		cptr[i++] = *(cp + p);
+	return len;
+}
+
+/* Find the pattern in the text, starting at the given position, return its index or npos.
+Candidates are found by checking the first and the last character of the pattern for 16 positions at once,
+only then the middle of the pattern is compared */
+size_t String::search(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos) noexcept
+{
+	if (pos > textLen || patLen > textLen - pos)
+		return npos;
+	if (patLen == 0)
+		return pos;
+	if (patLen == 1) {
+		const void* found = memchr(text + pos, *pat, textLen - pos);
+		return found ? (const char*) found - text : npos;
+	}
+
+	const size_t last = textLen - patLen; // Last position, where the pattern can start
+	size_t i = pos;
+#ifdef STRING_SSE2
+	const __m128i firstChars = _mm_set1_epi8(*pat);
+	const __m128i finalChars = _mm_set1_epi8(*(pat + patLen - 1));
+	for (; i + 15 <= last; i += 16) {
+		__m128i starts = _mm_loadu_si128((const __m128i*)(text + i));
+		__m128i ends = _mm_loadu_si128((const __m128i*)(text + i + patLen - 1));
+		unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(starts, firstChars), _mm_cmpeq_epi8(ends, finalChars)));
+		while (mask) {
+			size_t candidate = i + lowestBit(mask);
+			if (memcmp(text + candidate + 1, pat + 1, patLen - 2) == 0)
+				return candidate;
+			mask &= mask - 1;
+		}
+	}
+#endif
+	// The rest jumps between the places of the first character
+	while (i <= last) {
+		const char* found = (const char*) memchr(text + i, *pat, last - i + 1);
+		if (!found)
+			return npos;
+		i = found - text;
+		if (*(text + i + patLen - 1) == *(pat + patLen - 1) && memcmp(text + i + 1, pat + 1, patLen - 2) == 0)
+			return i;
+		i++;
+	}
+	return npos;
+}
+
+/* Find the pattern in the text ignoring ASCII case, starting at the given position, return its index or npos */
+size_t String::isearch(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos) noexcept
+{
+	if (pos > textLen || patLen > textLen - pos)
+		return npos;
+	if (patLen == 0)
+		return pos;
+
+	const size_t last = textLen - patLen;
+	const char firstCh = asciiLower(*pat), finalCh = asciiLower(*(pat + patLen - 1));
+	size_t i = pos;
+#ifdef STRING_SSE2
+	const __m128i firstChars = _mm_set1_epi8(firstCh);
+	const __m128i finalChars = _mm_set1_epi8(finalCh);
+	for (; i + 15 <= last; i += 16) {
+		__m128i starts = flipCaseBlock(_mm_loadu_si128((const __m128i*)(text + i)), 'A');
+		__m128i ends = flipCaseBlock(_mm_loadu_si128((const __m128i*)(text + i + patLen - 1)), 'A');
+		unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(starts, firstChars), _mm_cmpeq_epi8(ends, finalChars)));
+		while (mask) {
+			size_t candidate = i + lowestBit(mask);
+			if (patLen <= 2 || caseMismatch(text + candidate + 1, pat + 1, patLen - 2) == patLen - 2)
+				return candidate;
+			mask &= mask - 1;
+		}
+	}
+#endif
+	for (; i <= last; i++) {
+		if (asciiLower(*(text + i)) == firstCh && asciiLower(*(text + i + patLen - 1)) == finalCh
+			&& (patLen <= 2 || caseMismatch(text + i + 1, pat + 1, patLen - 2) == patLen - 2))
+			return i;
+	}
+	return npos;
+}
+
+/* Convert every ASCII uppercase letter of this String to lowercase */
+String& String::to_lower() noexcept
+{
+	convertCase(cp, cp, sz, false);
+	return *this;
+}
+
+/* Convert every ASCII lowercase letter of this String to uppercase */
+String& String::to_upper() noexcept
+{
+	convertCase(cp, cp, sz, true);
+	return *this;
+}
+
+/* Return a copy of this String with every ASCII uppercase letter converted to lowercase */
+String String::lower() const
+{
+	String result;
+	result.reserve(sz);
+	convertCase(result.cp, cp, sz, false);
+	result.sz = sz;
+	result.terminate();
+	return result;
+}
+
+/* Return a copy of this String with every ASCII lowercase letter converted to uppercase */
+String String::upper() const
+{
+	String result;
+	result.reserve(sz);
+	convertCase(result.cp, cp, sz, true);
+	result.sz = sz;
+	result.terminate();
+	return result;
+}
+
+/* Check if this String is the same as the given one, ignoring ASCII case */
+bool String::iequals(const String& str) const noexcept
+{
+	return sz == str.sz && caseMismatch(cp, str.cp, sz) == sz;
+}
+
+/* Check if this String is the same as const char*, ignoring ASCII case */
+bool String::iequals(const char* cptr) const
+{
+	size_t sizeCptr = strlen(cptr);
+	return sz == sizeCptr && caseMismatch(cp, cptr, sz) == sz;
+}
+
+/* Compare this String to the other one ignoring ASCII case, return 1, -1 or 0 like compare() */
+int String::icompare(const String& str) const noexcept
+{
+	return caseCompare(cp, sz, str.cp, str.sz);
+}
+
+/* Compare this String to const char* ignoring ASCII case, return 1, -1 or 0 like compare() */
+int String::icompare(const char* cptr) const
+{
+	return caseCompare(cp, sz, cptr, strlen(cptr));
+}
+
+/* Find given String in this String ignoring ASCII case, starting at the given position */
+size_t String::ifind(const String& str, size_t pos) const noexcept
+{
+	return isearch(cp, sz, str.cp, str.sz, pos);
+}
+
+/* Find given text in this String ignoring ASCII case, starting at the given position */
+size_t String::ifind(const char* cptr, size_t pos) const
+{
+	if (!cptr)
+		return npos;
+	return isearch(cp, sz, cptr, strlen(cptr), pos);
+}
+
+/* Count the matches of the pattern, that start in [pos, end), skipping the ones overlapping the previous match.
+Positions of the matches are added to (found), if it's given */
+size_t String::count_matches(const char* text, size_t textLen, const char* pat, size_t patLen,
+	size_t pos, size_t end, vector<size_t>* found)
+{
+	if (patLen == 0 || end > textLen)
+		return 0;
+	if (end + patLen - 1 < textLen)
+		textLen = end + patLen - 1; // Matches starting at (end) or later aren't needed
+	size_t matches = 0;
+	for (size_t i = search(text, textLen, pat, patLen, pos); i != npos; i = search(text, textLen, pat, patLen, i + patLen)) {
+		if (found)
+			found->push_back(i);
+		matches++;
+	}
+	return matches;
+}
+
+/* Count the copies of the given String in this String, starting at the given position. Overlapping copies count once,
+like the ones replaced one after another */
+size_t String::count(const String& str, size_t pos) const
+{
+	return count_matches(cp, sz, str.cp, str.sz, pos, sz, nullptr);
+}
+
+/* Count the copies of the given text in this String, starting at the given position */
+size_t String::count(const char* cptr, size_t pos) const
+{
+	if (!cptr)
+		return 0;
+	return count_matches(cp, sz, cptr, strlen(cptr), pos, sz, nullptr);
+}
+
+/* Return the positions of the copies of the given String in this String, that count() counts */
+vector<size_t> String::find_all(const String& str, size_t pos) const
+{
+	vector<size_t> found;
+	count_matches(cp, sz, str.cp, str.sz, pos, sz, &found);
+	return found;
+}
+
+/* Return the positions of the copies of the given text in this String, that count() counts */
+vector<size_t> String::find_all(const char* cptr, size_t pos) const
+{
+	vector<size_t> found;
+	if (cptr)
+		count_matches(cp, sz, cptr, strlen(cptr), pos, sz, &found);
+	return found;
+}
+
+/* Characters removed by trimming functions called without a set */
+static const String::Char_Set whitespace(" \t\n\v\f\r");
+
+#ifdef STRING_SSE2
+/* Return the mask of bytes in the block, that are members of the small set */
+static inline unsigned memberMask(__m128i block, const __m128i* members, size_t count)
+{
+	__m128i found = _mm_setzero_si128();
+	for (size_t i = 0; i < count; i++)
+		found = _mm_or_si128(found, _mm_cmpeq_epi8(block, members[i]));
+	return _mm_movemask_epi8(found);
+}
+#endif
+
+/* Return index of the first character, that isn't in the set, or (n) if there isn't one */
+static size_t firstNotInSet(const char* text, size_t n, const String::Char_Set& set)
+{
+	size_t i = 0;
+#ifdef STRING_SSE2
+	if (set.small()) {
+		__m128i members[String::Char_Set::max_members];
+		for (size_t j = 0; j < set.count(); j++)
+			members[j] = _mm_set1_epi8(set.members()[j]);
+		for (; i + 16 <= n; i += 16) {
+			unsigned outside = ~memberMask(_mm_loadu_si128((const __m128i*)(text + i)), members, set.count()) & 0xFFFF;
+			if (outside)
+				return i + lowestBit(outside);
+		}
+	}
+#endif
+	while (i < n && set.contains(text[i]))
+		i++;
+	return i;
+}
+
+/* Return index right after the last character, that isn't in the set, or 0 if there isn't one */
+static size_t lastNotInSet(const char* text, size_t n, const String::Char_Set& set)
+{
+	size_t i = n;
+#ifdef STRING_SSE2
+	if (set.small()) {
+		__m128i members[String::Char_Set::max_members];
+		for (size_t j = 0; j < set.count(); j++)
+			members[j] = _mm_set1_epi8(set.members()[j]);
+		for (; i >= 16; i -= 16) {
+			unsigned outside = ~memberMask(_mm_loadu_si128((const __m128i*)(text + i - 16)), members, set.count()) & 0xFFFF;
+			if (outside) {
+				unsigned highest = 0;
+				while (outside >>= 1)
+					highest++;
+				return i - 16 + highest + 1;
+			}
+		}
+	}
+#endif
+	while (i > 0 && set.contains(text[i - 1]))
+		i--;
+	return i;
+}
+
+/* Remove whitespace from both ends of this String */
+String& String::trim() noexcept
+{
+	return trim(whitespace);
+}
+
+/* Remove characters of the set from both ends of this String */
+String& String::trim(const Char_Set& set) noexcept
+{
+	return rtrim(set).ltrim(set);
+}
+
+/* Remove whitespace from the beginning of this String */
+String& String::ltrim() noexcept
+{
+	return ltrim(whitespace);
+}
+
+/* Remove characters of the set from the beginning of this String, the rest is moved in place */
+String& String::ltrim(const Char_Set& set) noexcept
+{
+	size_t first = firstNotInSet(cp, sz, set);
+	if (first) {
+		memmove(cp, cp + first, sz - first);
+		sz -= first;
+	}
+	terminate();
+	return *this;
+}
+
+/* Remove whitespace from the end of this String */
+String& String::rtrim() noexcept
+{
+	return rtrim(whitespace);
+}
+
+/* Remove characters of the set from the end of this String */
+String& String::rtrim(const Char_Set& set) noexcept
+{
+	sz = lastNotInSet(cp, sz, set);
+	terminate();
+	return *this;
+}
+
+/* Return view of this String without whitespace on both ends */
+std::string_view String::trimmed() const noexcept
+{
+	return trimmed(whitespace);
+}
+
+/* Return view of this String without characters of the set on both ends */
+std::string_view String::trimmed(const Char_Set& set) const noexcept
+{
+	size_t last = lastNotInSet(cp, sz, set);
+	size_t first = firstNotInSet(cp, last, set);
+	return std::string_view(cp + first, last - first);
+}
+
+/* Return view of this String without whitespace at the beginning */
+std::string_view String::ltrimmed() const noexcept
+{
+	return ltrimmed(whitespace);
+}
+
+/* Return view of this String without characters of the set at the beginning */
+std::string_view String::ltrimmed(const Char_Set& set) const noexcept
+{
+	size_t first = firstNotInSet(cp, sz, set);
+	return std::string_view(cp + first, sz - first);
+}
+
+/* Return view of this String without whitespace at the end */
+std::string_view String::rtrimmed() const noexcept
+{
+	return rtrimmed(whitespace);
+}
+
+/* Return view of this String without characters of the set at the end */
+std::string_view String::rtrimmed(const Char_Set& set) const noexcept
+{
+	return std::string_view(cp, lastNotInSet(cp, sz, set));
+}
+
+/* Return the number of bytes, that are the first bytes of UTF-8 sequences (aren't continuation bytes) */
+static size_t countLeadBytes(const char* text, size_t n)
+{
+	size_t count = 0, i = 0;
+#ifdef STRING_SSE2
+	// Continuation bytes 10xxxxxx are the signed bytes lower than -64
+	const __m128i limit = _mm_set1_epi8(-64);
+	for (; i + 16 <= n; i += 16) {
+		unsigned continuation = _mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)(text + i)), limit));
+		unsigned lead = ~continuation & 0xFFFF;
+		while (lead) {
+			lead &= lead - 1;
+			count++;
+		}
+	}
+#endif
+	for (; i < n; i++)
+		count += ((unsigned char) text[i] & 0xC0) != 0x80;
+	return count;
+}
+
+/* Return the byte offset of the code point with the given index, or npos if the text is shorter */
+static size_t codePointOffset(const char* text, size_t n, size_t index)
+{
+	size_t i = 0;
+	// Skip whole blocks while the code point is further than them
+	while (n - i > 64) {
+		size_t leads = countLeadBytes(text + i, 64);
+		if (leads > index)
+			break;
+		index -= leads;
+		i += 64;
+	}
+	for (; i < n; i++) {
+		if (((unsigned char) text[i] & 0xC0) != 0x80) {
+			if (index == 0)
+				return i;
+			index--;
+		}
+	}
+	return (index == 0) ? n : String::npos;
+}
+
+/* Return length of the valid UTF-8 sequence starting at (p), or 0 if it is malformed */
+static size_t utf8SequenceLength(const unsigned char* p, size_t available)
+{
+	unsigned char lead = *p;
+	if (lead < 0x80)
+		return 1;
+
+	size_t seqLen;
+	unsigned char low = 0x80, high = 0xBF; // Allowed range of the second byte
+	if (lead >= 0xC2 && lead <= 0xDF)
+		seqLen = 2;
+	else if (lead >= 0xE0 && lead <= 0xEF) {
+		seqLen = 3;
+		if (lead == 0xE0)
+			low = 0xA0; // Overlong
+		else if (lead == 0xED)
+			high = 0x9F; // Surrogates
+	}
+	else if (lead >= 0xF0 && lead <= 0xF4) {
+		seqLen = 4;
+		if (lead == 0xF0)
+			low = 0x90; // Overlong
+		else if (lead == 0xF4)
+			high = 0x8F; // Above U+10FFFF
+	}
+	else
+		return 0;
+
+	if (available < seqLen || *(p + 1) < low || *(p + 1) > high)
+		return 0;
+	for (size_t i = 2; i < seqLen; i++) {
+		if ((*(p + i) & 0xC0) != 0x80)
+			return 0;
+	}
+	return seqLen;
+}
+
+/* Decode the UTF-8 sequence starting at (first), store its length in (len),
+return its code point, or U+FFFD with length 1 if it is malformed */
+char32_t String::decode_utf8(const char* first, const char* last, size_t& len) noexcept
+{
+	const unsigned char* p = (const unsigned char*) first;
+	len = utf8SequenceLength(p, last - first);
+	switch (len) {
+	case 1:
+		return *p;
+	case 2:
+		return ((*p & 0x1F) << 6) | (*(p + 1) & 0x3F);
+	case 3:
+		return ((*p & 0x0F) << 12) | ((*(p + 1) & 0x3F) << 6) | (*(p + 2) & 0x3F);
+	case 4:
+		return ((*p & 0x07) << 18) | ((*(p + 1) & 0x3F) << 12) | ((*(p + 2) & 0x3F) << 6) | (*(p + 3) & 0x3F);
+	default:
+		len = 1;
+		return 0xFFFD;
+	}
+}
+
+/* Check UTF-8 one sequence at a time, skipping blocks of ASCII characters */
+static bool validateUtf8Scalar(const char* text, size_t n)
+{
+	size_t i = 0;
+	while (i < n) {
+#ifdef STRING_SSE2
+		while (i + 16 <= n && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(text + i))) == 0)
+			i += 16;
+		if (i == n)
+			break;
+#endif
+		size_t len = utf8SequenceLength((const unsigned char*)(text + i), n - i);
+		if (!len)
+			return false;
+		i += len;
+	}
+	return true;
+}
+
+#ifdef STRING_SSSE3
+/* Error flags of the lookup tables, every malformed pair of bytes sets at least one of them */
+enum Utf8_Error : unsigned char {
+	TOO_SHORT = 1 << 0,      // Lead byte not followed by enough continuation bytes
+	TOO_LONG = 1 << 1,       // Continuation byte after ASCII character
+	OVERLONG_3 = 1 << 2,     // 1110 0000 100x xxxx
+	TOO_LARGE = 1 << 3,      // 1111 0100 1001 xxxx and above
+	SURROGATE = 1 << 4,      // 1110 1101 101x xxxx
+	OVERLONG_2 = 1 << 5,     // 1100 000x 10xx xxxx
+	TOO_LARGE_1000 = 1 << 6, // 1111 0101 and above
+	OVERLONG_4 = 1 << 6,     // 1111 0000 1000 xxxx
+	TWO_CONTS = 1 << 7,      // Two continuation bytes in a row
+	CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS
+};
+
+/* Check UTF-8 text 16 bytes at a time using the lookup algorithm of Keiser and Lemire: three table lookups
+classify every pair of bytes, and separate checks make sure the third and fourth bytes are continuations */
+STRING_SSSE3_TARGET static bool validateUtf8Ssse3(const char* text, size_t n)
+{
+	const __m128i byte1High = _mm_setr_epi8(
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		char(TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4));
+	const __m128i byte1Low = _mm_setr_epi8(
+		char(CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4),
+		char(CARRY | OVERLONG_2),
+		char(CARRY),
+		char(CARRY),
+		char(CARRY | TOO_LARGE),
+		char(CARRY | TOO_LARGE | TOO_LARGE_1000), char(CARRY | TOO_LARGE | TOO_LARGE_1000),
+		char(CARRY | TOO_LARGE | TOO_LARGE_1000), char(CARRY | TOO_LARGE | TOO_LARGE_1000),
+		char(CARRY | TOO_LARGE | TOO_LARGE_1000), char(CARRY | TOO_LARGE | TOO_LARGE_1000),
+		char(CARRY | TOO_LARGE | TOO_LARGE_1000), char(CARRY | TOO_LARGE | TOO_LARGE_1000),
+		char(CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE),
+		char(CARRY | TOO_LARGE | TOO_LARGE_1000), char(CARRY | TOO_LARGE | TOO_LARGE_1000));
+	const __m128i byte2High = _mm_setr_epi8(
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		char(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),
+		char(TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),
+		char(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+		char(TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+	// Last bytes of a block, that start sequences longer than what's left of it
+	const __m128i incompleteLimit = _mm_setr_epi8(
+		char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+		char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+	const __m128i nibble = _mm_set1_epi8(0x0F);
+
+	__m128i error = _mm_setzero_si128();
+	__m128i prevInput = _mm_setzero_si128();
+	__m128i prevIncomplete = _mm_setzero_si128();
+	char tail[16] = {};
+	for (size_t i = 0; i < n; i += 16) {
+		__m128i input;
+		if (n - i >= 16)
+			input = _mm_loadu_si128((const __m128i*)(text + i));
+		else {
+			memcpy(tail, text + i, n - i); // Pad the last block with ASCII zeros
+			input = _mm_loadu_si128((const __m128i*) tail);
+		}
+
+		if (_mm_movemask_epi8(input) == 0)
+			error = _mm_or_si128(error, prevIncomplete);
+		else {
+			__m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+			__m128i specialCases = _mm_and_si128(_mm_and_si128(
+				_mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+				_mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble))),
+				_mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+			__m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+			__m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+			__m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xE0 - 0x80)));
+			__m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80)));
+			__m128i must23 = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(char(0x80)));
+			error = _mm_or_si128(error, _mm_xor_si128(must23, specialCases));
+		}
+		prevIncomplete = _mm_subs_epu8(input, incompleteLimit);
+		prevInput = input;
+	}
+	error = _mm_or_si128(error, prevIncomplete);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+#endif
+
+/* Check if this String holds valid UTF-8 text */
+bool String::utf8_valid() const noexcept
+{
+#ifdef STRING_SSSE3
+	static const bool ssse3 = hasSsse3();
+	if (ssse3)
+		return validateUtf8Ssse3(cp, sz);
+#endif
+	return validateUtf8Scalar(cp, sz);
+}
+
+/* Return the number of code points in this String, every byte, that isn't a continuation byte, starts one */
+size_t String::utf8_length() const noexcept
+{
+	return countLeadBytes(cp, sz);
+}
+
+/* Return range of the code points of this String, that can be used in the range-based for loop */
+String::Code_Point_Range String::code_points() const noexcept
+{
+	return Code_Point_Range(cp, sz);
+}
+
+/* Return a copy of the given amount of code points of this String, starting at the code point with index (pos) */
+String String::utf8_substr(size_t pos, size_t len) const
+{
+	size_t first = codePointOffset(cp, sz, pos);
+	if (first == npos)
+		throw out_of_range("Position out of range!");
+	size_t last = (len == npos) ? npos : codePointOffset(cp + first, sz - first, len);
+	last = (last == npos) ? sz : first + last;
+	String result;
+	result.reserve(last - first);
+	if (last > first)
+		memcpy(result.cp, cp + first, last - first);
+	result.sz = last - first;
+	result.terminate();
+	return result;
+}
+
+/* Shorten this String to at most (n) bytes, without splitting a UTF-8 sequence at the end */
+String& String::utf8_truncate(size_t n) noexcept
+{
+	if (n >= sz)
+		return *this;
+	while (n > 0 && ((unsigned char) *(cp + n) & 0xC0) == 0x80)
+		n--;
+	sz = n;
+	terminate();
+	return *this;
+}
+
+/* Pairs of decimal digits, used to convert two digits of a number at once */
+static const char digitPairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/* Return the number of decimal digits of the given value */
+static size_t countDigits(unsigned long long value)
+{
+	size_t digits = 1;
+	for (;;) {
+		if (value < 10)
+			return digits;
+		if (value < 100)
+			return digits + 1;
+		if (value < 1000)
+			return digits + 2;
+		if (value < 10000)
+			return digits + 3;
+		value /= 10000;
+		digits += 4;
+	}
+}
+
+/* Write decimal digits of the value backwards, so that the last one lands right before (end) */
+static void writeDigits(char* end, unsigned long long value)
+{
+	while (value >= 100) {
+		const char* pair = digitPairs + (value % 100) * 2;
+		value /= 100;
+		*--end = pair[1];
+		*--end = pair[0];
+	}
+	if (value >= 10) {
+		const char* pair = digitPairs + value * 2;
+		*--end = pair[1];
+		*--end = pair[0];
+	}
+	else
+		*--end = char('0' + value);
+}
+
+/* Append the decimal representation of the signed value to this String */
+String& String::append_signed(long long value)
+{
+	// Negate in unsigned arithmetic, so the lowest value doesn't overflow
+	unsigned long long magnitude = (value < 0) ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+	size_t digits = countDigits(magnitude) + (value < 0);
+	grow(sz + digits);
+	if (value < 0)
+		cp[sz] = '-';
+	sz += digits;
+	writeDigits(cp + sz, magnitude);
+	terminate();
+	return *this;
+}
+
+/* Append the decimal representation of the unsigned value to this String */
+String& String::append_unsigned(unsigned long long value)
+{
+	size_t digits = countDigits(value);
+	grow(sz + digits);
+	sz += digits;
+	writeDigits(cp + sz, value);
+	terminate();
+	return *this;
+}
+
+/* Append the shortest representation of the double, that reads back to the same value */
+String& String::append_number(double value)
+{
+	char* buffer = prepare(32); // The shortest round-trip form of a double never exceeds 24 characters
+	auto result = to_chars(buffer, buffer + 32, value);
+	commit(result.ptr - buffer);
+	return *this;
+}
+
+/* Append the shortest representation of the float, that reads back to the same value */
+String& String::append_number(float value)
+{
+	char* buffer = prepare(32);
+	auto result = to_chars(buffer, buffer + 32, value);
+	commit(result.ptr - buffer);
+	return *this;
+}
+
+/* Create String from the decimal representation of the signed integer */
+String String::from_int(long long value)
+{
+	String result;
+	result.append_signed(value);
+	return result;
+}
+
+/* Create String from the decimal representation of the unsigned integer */
+String String::from_uint(unsigned long long value)
+{
+	String result;
+	result.append_unsigned(value);
+	return result;
+}
+
+/* Create String from the shortest round-trip representation of the double */
+String String::from_double(double value)
+{
+	String result;
+	result.append_number(value);
+	return result;
+}
+
+/* Skip leading whitespace and an optional plus sign, return index of the first character of the number */
+static size_t numberStart(const char* cp, size_t sz, bool allowPlus)
+{
+	size_t i = 0;
+	while (i < sz && std::isspace((unsigned char) *(cp + i)))
+		i++;
+	if (allowPlus && i + 1 < sz && *(cp + i) == '+' && *(cp + i + 1) != '-')
+		i++;
+	return i;
+}
+
+/* Throw invalid_argument if the base isn't one from_chars() reads, from 2 to 36 */
+static void checkBase(int base)
+{
+	if (base < 2 || base > 36)
+		throw invalid_argument("Base must be between 2 and 36!");
+}
+
+/* Convert this String to the signed integer in the given base, store the number of used characters in (idx),
+throw invalid_argument if there is no number or the base is outside [2, 36], or out_of_range if it doesn't fit */
+long long String::to_int(size_t* idx, int base) const
+{
+	checkBase(base);
+	size_t start = numberStart(cp, sz, true);
+	long long value = 0;
+	auto result = from_chars(cp + start, cp + sz, value, base);
+	if (result.ec == errc::invalid_argument)
+		throw invalid_argument("No conversion could be performed!");
+	if (result.ec == errc::result_out_of_range)
+		throw out_of_range("Value out of range!");
+	if (idx)
+		*idx = result.ptr - cp;
+	return value;
+}
+
+/* Convert this String to the unsigned integer in the given base, store the number of used characters in (idx),
+throw invalid_argument if there is no number or the base is outside [2, 36], or out_of_range if it doesn't fit */
+unsigned long long String::to_uint(size_t* idx, int base) const
+{
+	checkBase(base);
+	size_t start = numberStart(cp, sz, true);
+	unsigned long long value = 0;
+	auto result = from_chars(cp + start, cp + sz, value, base);
+	if (result.ec == errc::invalid_argument)
+		throw invalid_argument("No conversion could be performed!");
+	if (result.ec == errc::result_out_of_range)
+		throw out_of_range("Value out of range!");
+	if (idx)
+		*idx = result.ptr - cp;
+	return value;
+}
+
+/* Convert this String to double, store the number of used characters in (idx),
+throw invalid_argument if there is no number, or out_of_range if it doesn't fit */
+double String::to_double(size_t* idx) const
+{
+	size_t start = numberStart(cp, sz, true);
+	double value = 0;
+	auto result = from_chars(cp + start, cp + sz, value);
+	if (result.ec == errc::invalid_argument)
+		throw invalid_argument("No conversion could be performed!");
+	if (result.ec == errc::result_out_of_range)
+		throw out_of_range("Value out of range!");
+	if (idx)
+		*idx = result.ptr - cp;
+	return value;
+}
+
+/* Return the number of hexadecimal digits of the given value */
+static size_t countHexDigits(unsigned long long value)
+{
+	size_t digits = 1;
+	while (value >>= 4)
+		digits++;
+	return digits;
+}
+
+/* Write hexadecimal digits of the value backwards, so that the last one lands right before (end) */
+static void writeHexDigits(char* end, unsigned long long value, bool upper)
+{
+	const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	do {
+		*--end = digits[value & 0xF];
+		value >>= 4;
+	} while (value);
+}
+
+/* Format the floating-point argument into the buffer, return pointer past the last written character */
+static char* formatFloating(char* first, char* last, double value, bool isFloat, int precision, char type)
+{
+	std::to_chars_result result;
+	if (type == 'f') {
+		int fixedPrecision = (precision < 0) ? 6 : precision;
+		result = isFloat ? to_chars(first, last, (float)value, std::chars_format::fixed, fixedPrecision)
+			: to_chars(first, last, value, std::chars_format::fixed, fixedPrecision);
+	}
+	else if (precision >= 0) {
+		result = isFloat ? to_chars(first, last, (float)value, std::chars_format::general, precision)
+			: to_chars(first, last, value, std::chars_format::general, precision);
+	}
+	else
+		result = isFloat ? to_chars(first, last, (float)value) : to_chars(first, last, value);
+	return result.ptr;
+}
+
+/* Build the formatted text in two passes: the first one measures every piece, so the String grows once,
+the second one writes the pieces right into the String's buffer */
+void String::vformat_to(String& out, const char* fmt, size_t len, const Format_Arg* args)
+{
+	// An argument pointing into the output would be invalidated by growing it, format into a copy instead
+	for (const Format_Arg* arg = args; arg->kind != Format_Kind::None; arg++) {
+		if (arg->kind == Format_Kind::Text && out.cp && arg->text.ptr >= out.cp && arg->text.ptr < out.cp + out.cap) {
+			String temp;
+			vformat_to(temp, fmt, len, args);
+			out.append(temp);
+			return;
+		}
+	}
+
+	char floating[512]; // Fixed notation of the highest double with 99 digits of precision fits in here
+	for (int pass = 0; pass < 2; pass++) {
+		size_t total = 0;
+		const Format_Arg* arg = args;
+		for (size_t i = 0; i < len; i++) {
+			if ((fmt[i] == '{' || fmt[i] == '}') && i + 1 < len && fmt[i + 1] == fmt[i])
+				i++; // Escaped brace
+			else if (fmt[i] == '{') {
+				Format_Spec spec;
+				i++;
+				parse_format_spec(fmt, len, i, spec);
+
+				size_t pieceSize = 0;
+				char* dest = out.cp + out.sz + total;
+				switch (arg->kind) {
+				case Format_Kind::Signed:
+				case Format_Kind::Unsigned: {
+					bool negative = (arg->kind == Format_Kind::Signed && arg->i < 0);
+					unsigned long long magnitude = negative ? 0ULL - (unsigned long long)arg->i : arg->u;
+					bool hex = (spec.type == 'x' || spec.type == 'X');
+					pieceSize = (hex ? countHexDigits(magnitude) : countDigits(magnitude)) + negative;
+					if (pass == 1) {
+						if (negative)
+							*dest = '-';
+						if (hex)
+							writeHexDigits(dest + pieceSize, magnitude, spec.type == 'X');
+						else
+							writeDigits(dest + pieceSize, magnitude);
+					}
+					break;
+				}
+				case Format_Kind::Double:
+				case Format_Kind::Float: {
+					bool isFloat = (arg->kind == Format_Kind::Float);
+					double value = isFloat ? arg->f : arg->d;
+					if (pass == 0)
+						pieceSize = formatFloating(floating, floating + sizeof(floating), value, isFloat,
+							spec.precision, spec.type) - floating;
+					else
+						pieceSize = formatFloating(dest, out.cp + out.cap, value, isFloat,
+							spec.precision, spec.type) - dest;
+					break;
+				}
+				case Format_Kind::Character:
+					pieceSize = 1;
+					if (pass == 1)
+						*dest = arg->ch;
+					break;
+				default:
+					pieceSize = arg->text.len;
+					if (pass == 1 && pieceSize)
+						memcpy(dest, arg->text.ptr, pieceSize);
+					break;
+				}
+				total += pieceSize;
+				arg++;
+				continue;
+			}
+			if (pass == 1)
+				*(out.cp + out.sz + total) = fmt[i];
+			total++;
+		}
+
+		if (pass == 0)
+			out.grow(out.sz + total);
+		else
+			out.sz += total;
+	}
+	out.terminate();
+}
+
+/* Swap the Strings */
+void swap(String& lhs, String& rhs)
+{
+	lhs.swap(rhs);
+}
+
+/* Read characters into String from the input stream, skipping leading whitespace and stopping at the next one */
+std::istream& operator>>(std::istream& is, String& str)
+{
+	std::istream::sentry sentry(is);
+	if (!sentry)
+		return is;
+	str.clear();
+	int ch;
+	while ((ch = is.peek()) != std::char_traits<char>::eof() && !std::isspace(ch))
+		str.push_back((char) is.get());
+	if (ch == std::char_traits<char>::eof())
+		is.setstate(std::ios::eofbit);
+	if (str.empty())
+		is.setstate(std::ios::failbit);
+	return is;
+}
+
+/* Write String's contents to output stream */
+std::ostream& operator<<(std::ostream& os, const String& str)
+{
+	if (!os)
+		return os;
+	for (size_t i = 0; i < str.sz; i++)
+		os << *(str.cp + i);
+	return os;
+}
+
+/* Read the entire lines from the input stream, up to the delimiter character into the String */
+std::istream& getline(std::istream& is, String& str, char delim)
+{
+	if (!is)
+		return is;
+	str.clear();
+	char ch;
+	bool extracted = false;
+	while (is.get(ch)) {
+		extracted = true;
+		if (ch == delim)
+			break;
+		str.push_back(ch);
+	}
+	if (extracted && is.eof())
+		is.clear(std::ios::eofbit); // The last line doesn't need the delimiter
+	return is;
+}
+
+/* Read the entire lines from the input stream, up to the  delimiter character into the String */
+std::istream& getline(std::istream&& is, String& str, char delim)
+{
+	return getline(is, str, delim);
+}
+
+/* Read the entire line from the input stream, up to the newline character into the String */
+std::istream& getline(std::istream& is, String& str)
+{
+	return getline(is, str, '\n');
+}
+
+/* Read the entire line from the input stream, up to the newline character into the String */
+std::istream& getline(std::istream&& is, String& str)
+{
+	return getline(is, str, '\n');
+}
@@ -1,832 +1,2470 @@
-#pragma once
-
-#include <memory>
-#include <initializer_list>
-#include <iostream>
-
-/*********************************************** CLASSES ***************************************************/
-
-/*/////////////////////////////////////////// String class ////////////////////////////////////////////////*/
-
-class String
-{
-private:
-	//Helping functions
-	void reallocate();
-	void free();
-	template<bool constness = false> class Iterator;
-	template<bool constness = false> class Reverse_Iterator;
-public:
-	//Types
-	typedef char value_type;
-	typedef std::char_traits<char> char_traits;
-	typedef std::allocator<char> allocator_type;
-	typedef char& reference;
-	typedef const char& const_reference;
-	typedef char* pointer;
-	typedef const char* const_pointer;
-	typedef std::ptrdiff_t difference_type;
-	typedef size_t size_type;
-	typedef Iterator<> iterator;
-	typedef Iterator<true> const_iterator;
-	typedef Reverse_Iterator<> reverse_iterator;
-	typedef Reverse_Iterator<true> const_reverse_iterator;
-
-	//Public const member
-	static const size_t npos = -1;
-
-public:
-	//Constructors, Destructor
-	String() = default;
-	String(const char* cptr);
-	String(const char* cptr, size_t n);
-	String(size_t n, char ch);
-	String(std::initializer_list<char> lst);
-	template<typename InputIterator> String(InputIterator first, InputIterator last);
-	String(const String& str);
-	String(const String& str, size_t subpos, size_t sublen = npos);
-	String(String&& str) noexcept;
-	~String() { free(); }
-
-	//Assignment overloads
-	String& operator=(const String& str);
-	String& operator=(const char* cptr);
-	String& operator=(char ch);
-	String& operator=(std::initializer_list<char> lst);
-	String& operator=(String&& str) noexcept;
-
-	//Iterators
-	iterator begin() noexcept;
-	const_iterator begin() const noexcept;
-	iterator end() noexcept;
-	const_iterator end() const noexcept;
-
-	reverse_iterator rbegin() noexcept;
-	const_reverse_iterator rbegin() const noexcept;
-	reverse_iterator rend() noexcept;
-	const_reverse_iterator rend() const noexcept;
-
-	const_iterator cbegin() const noexcept;
-	const_iterator cend() const noexcept;
-
-	const_reverse_iterator crbegin() const noexcept;
-	const_reverse_iterator crend() const noexcept;
-	//Capacity
-	size_t size() const noexcept { return sz; }
-	size_t length() const noexcept { return sz; }
-	size_t max_size() const noexcept { return -1; }
-	size_t capacity() const noexcept { return cap; }
-	bool empty() const noexcept { return !cp; }
-
-	void clear() { free(); }
-	void resize(size_t n);
-	void resize(size_t n, char ch);
-	void reserve(size_t n = 0);
-	void shrink_to_fit();
-
-	//Element access
-	char& operator[](size_t n);
-	const char& operator[](size_t n) const;
-
-	char& at(size_t n);
-	const char& at(size_t n) const;
-
-	char& back();
-	const char& back() const;
-
-	char& front();
-	const char& front() const;
-
-	//Modifiers
-	String& operator+=(const String& str);
-	String& operator+=(const char* cptr);
-	String& operator+=(char ch);
-	String& operator+=(std::initializer_list<char> lst);
-
-	String& append(const String& str);
-	String& append(const String&, size_t str, size_t n = npos);
-	String& append(const char* cptr);
-	String& append(const char* cptr, size_t n);
-	String& append(size_t n, char ch);
-	template<typename InputIterator> String& append(InputIterator first, InputIterator last);
-	String& append(std::initializer_list<char> lst);
-
-	void push_back(char ch);
-
-	String& assign(const String& str);
-	String& assign(const String& str, size_t subpos, size_t sublen = npos);
-	String& assign(const char* cptr);
-	String& assign(const char* cptr, size_t n);
-	String& assign(size_t n, char ch);
-	template<typename InputIterator> String& assign(InputIterator first, InputIterator last);
-	String& assign(std::initializer_list<char> lst);
-	String& assign(String&& str) noexcept;
-
-	String& insert(size_t pos, const String& str);
-	String& insert(size_t pos, const String& str, size_t subpos, size_t sublen = npos);
-	String& insert(size_t pos, const char* cptr);
-	String& insert(size_t pos, const char* cptr, size_t n);
-	String& insert(size_t pos, size_t n, char ch);
-	iterator insert(const_iterator p, size_t n, char ch);
-	iterator insert(const_iterator p, char ch);
-	template<typename InputIterator> iterator insert(iterator p, InputIterator first, InputIterator last);
-	String& insert(const_iterator p, std::initializer_list<char> lst);
-
-	String& erase(size_t pos, size_t len = npos);
-	iterator erase(const_iterator p);
-	iterator erase(const_iterator first, const_iterator last);
-
-	String& replace(size_t pos, size_t len, const String& str);
-	String& replace(const_iterator first, const_iterator last, const String& str);
-	String& replace(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen = npos);
-	String& replace(size_t pos, size_t len, const char* cptr);
-	String& replace(const_iterator first, const_iterator last, const char* cptr);
-	String& replace(size_t pos, size_t len, const char* cptr, size_t n);
-	String& replace(const_iterator first, const_iterator last, const char* cptr, size_t n);
-	String& replace(size_t pos, size_t len, size_t n, char ch);
-	String& replace(const_iterator first, const_iterator last, size_t n, char ch);
-	template<typename InputIterator> 
-		String& replace(const_iterator i1, const_iterator i2, InputIterator first, InputIterator last);
-	String& replace(const_iterator first, const_iterator last, std::initializer_list<char> lst);
-
-	void swap(String& str);
-
-	void pop_back();
-
-	//String operations
-	const char* c_str();
-	const char* data();
-	allocator_type get_allocator() const noexcept;
-	size_t copy(char* cptr, size_t len, size_t pos = 0) const;
-
-	size_t find(const String& str, size_t pos = 0) const noexcept;
-	size_t find(const char* cptr, size_t pos = 0) const;
-	size_t find(const char* cptr, size_t pos, size_t n) const;
-	size_t find(char c, size_t pos = 0) const noexcept;
-	size_t rfind(const String& str, size_t pos = 0) const noexcept;
-	size_t rfind(const char* cptr, size_t pos = 0) const;
-	size_t rfind(const char* cptr, size_t pos, size_t n) const;
-	size_t rfind(char c, size_t pos = 0) const noexcept;
-
-	size_t find_first_of(const String& str, size_t pos = 0) const noexcept;
-	size_t find_first_of(const char* cptr, size_t pos = 0) const;
-	size_t find_first_of(const char* cptr, size_t pos, size_t n) const;
-	size_t find_first_of(char ch, size_t pos = 0) const noexcept;
-	size_t find_last_of(const String& str, size_t pos = 0) const noexcept;
-	size_t find_last_of(const char* cptr, size_t pos = 0) const;
-	size_t find_last_of(const char* cptr, size_t pos, size_t n) const;
-	size_t find_last_of(char ch, size_t pos = 0) const noexcept;
-
-	size_t find_first_not_of(const String& str, size_t pos = 0) const noexcept;
-	size_t find_first_not_of(const char* cptr, size_t pos = 0) const;
-	size_t find_first_not_of(const char* cptr, size_t pos, size_t n) const;
-	size_t find_first_not_of(char ch, size_t pos = 0) const noexcept;
-	size_t find_last_not_of(const String& str, size_t pos = 0) const noexcept;
-	size_t find_last_not_of(const char* cptr, size_t pos = 0) const;
-	size_t find_last_not_of(const char* cptr, size_t pos, size_t n) const;
-	size_t find_last_not_of(char ch, size_t pos = 0) const noexcept;
-
-	String substr(size_t pos = 0, size_t len = npos) const;
-	int compare(const String& str) const noexcept;
-	int compare(size_t pos, size_t len, const String& str) const;
-	int compare(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen = npos) const;
-	int compare(const char* cptr) const;
-	int compare(size_t pos, size_t len, const char* cptr) const;
-	int compare(size_t pos, size_t len, const char* cptr, size_t n) const;
-
-	//Non-member function overloads
-	friend String operator+(const String&, const String&);
-	friend String operator+(const String&, String&&);
-	friend String operator+(String&&, const String&);
-	friend String operator+(String&&, String&&);
-	friend String operator+(const String&, const char*);
-	friend String operator+(String&&, const char*);
-	friend String operator+(const char*, const String&);
-	friend String operator+(const char*, String&&);
-	friend String operator+(const String&, char);
-	friend String operator+(String&&, char);
-	friend String operator+(char, const String&);
-	friend String operator+(char, String&&);
-
-	friend bool operator==(const String&, const String&) noexcept;
-	friend bool operator==(const char*, const String&);
-	friend bool operator==(const String&, const char*);
-	friend bool operator!=(const String&, const String&) noexcept;
-	friend bool operator!=(const char*, const String&);
-	friend bool operator!=(const String&, const char*);
-	friend bool operator<(const String&, const String&) noexcept;
-	friend bool operator<(const char*, const String&);
-	friend bool operator<(const String&, const char*);
-	friend bool operator<=(const String&, const String&) noexcept;
-	friend bool operator<=(const char*, const String&);
-	friend bool operator<=(const String&, const char*);
-	friend bool operator>(const String&, const String&) noexcept;
-	friend bool operator>(const char*, const String&);
-	friend bool operator>(const String&, const char*);
-	friend bool operator>=(const String&, const String&) noexcept;
-	friend bool operator>=(const char*, const String&);
-	friend bool operator>=(const String&, const char*);
-
-	friend void swap(String&, String&);
-
-	friend std::istream& operator>>(std::istream&, const String&);
-	friend std::ostream& operator<<(std::ostream&, const String&);
-
-	friend std::istream& getline(std::istream&, String&, char);
-	friend std::istream& getline(std::istream&&, String&, char);
-	friend std::istream& getline(std::istream&, String&);
-	friend std::istream& getline(std::istream&&, String&);
-private:
-	static std::allocator<char> alloc;
-	size_t sz = 0;
-	char* cp = nullptr;
-	size_t cap = 0;
-};
-
-
-/*//////////////////////////////////////////// Iterator class ////////////////////////////////////////////////*/
-
-/* String's iterator. Based of a random-access iterator */
-template<bool constness> class String::Iterator
-{
-public:
-	using iterator_category = std::random_access_iterator_tag;
-	using value_type = typename std::conditional_t<constness, const char, char>;
-	using difference_type = std::ptrdiff_t;
-	using reference = typename std::conditional_t<constness, const char&, char&>;
-	using pointer = typename std::conditional_t<constness, const char*, char*>;
-public:
-	explicit Iterator(char* cp) : m_cp(cp) {}
-
-	/* Conversion */
-	operator const_iterator() const { return const_iterator(m_cp); }
-	friend iterator;
-
-	/* Iterate operations */
-	Iterator& operator++();
-	Iterator operator++(int);
-	Iterator& operator--();
-	Iterator operator--(int);
-
-	Iterator operator+(size_t n) const;
-	Iterator& operator+=(size_t n);
-	Iterator operator-(size_t n) const;
-	Iterator& operator-=(size_t n);
-
-	/* Access operations */
-	template<bool _constness = constness> std::enable_if_t<_constness, reference>
-	operator*() const;
-	template<bool _constness = constness> std::enable_if_t<!_constness, reference>
-	operator*();
-
-	template<bool _constness = constness> std::enable_if_t<_constness, reference>
-	operator[](size_t index) const;
-	template<bool _constness = constness> std::enable_if_t<!_constness, reference>
-	operator[](size_t index);
-
-	/* Rational operations */
-	bool operator<(const const_iterator& rhs) const;
-	bool operator<=(const const_iterator& rhs) const;
-	bool operator>(const const_iterator& rhs) const;
-	bool operator>=(const const_iterator& rhs) const;
-	bool operator==(const const_iterator& rhs) const;
-	bool operator!=(const const_iterator& rhs) const;
-private:
-	pointer m_cp;
-};
-
-
-/* String's reverse iterator, based of normal String's Iterator */
-template <bool constness> class String::Reverse_Iterator
-{
-public:
-	using iterator_category = std::random_access_iterator_tag;
-	using value_type = typename std::conditional_t<constness, const char, char>;
-	using difference_type = std::ptrdiff_t;
-	using reference = typename std::conditional_t<constness, const char&, char&>;
-	using pointer = typename std::conditional_t<constness, const char*, char*>;
-public:
-	Reverse_Iterator(char* cp) : m_cp(cp) {}
-
-	/* Conversion */
-	operator const_reverse_iterator() { return const_reverse_iterator(m_cp); }
-	friend reverse_iterator;
-
-	/* Iterate operations */
-	Reverse_Iterator& operator++();
-	Reverse_Iterator operator++(int);
-	Reverse_Iterator& operator--();
-	Reverse_Iterator operator--(int);
-
-	Reverse_Iterator operator+(size_t n) const;
-	Reverse_Iterator& operator+=(size_t n);
-	Reverse_Iterator operator-(size_t n) const;
-	Reverse_Iterator& operator-=(size_t n);
-
-	/* Access operations */
-	template<bool _constness = constness> std::enable_if_t<_constness, reference>
-	operator*() const;
-	template<bool _constness = constness> std::enable_if_t<!_constness, reference>
-	operator*();
-
-	template<bool _constness = constness> std::enable_if_t<_constness, reference>
-	operator[](size_t index) const;
-	template<bool _constness = constness> std::enable_if_t<!_constness, reference>
-	operator[](size_t index);
-
-	/* Rational operations */
-	bool operator<(const const_reverse_iterator& rhs) const;
-	bool operator<=(const const_reverse_iterator& rhs) const;
-	bool operator>(const const_reverse_iterator& rhs) const;
-	bool operator>=(const const_reverse_iterator& rhs) const;
-	bool operator==(const const_reverse_iterator& rhs) const;
-	bool operator!=(const const_reverse_iterator& rhs) const;
-private:
-	pointer m_cp;
-};
-
-/****************************************** FUNCTIONS DECLARATIONS *********************************************/
-
-String operator+(const String& lhs, const String& rhs);
-String operator+(const String& lhs, String&& rhs);
-String operator+(String&& lhs, const String& rhs);
-String operator+(String&& lhs, String&& rhs);
-String operator+(const String& lhs, const char* rhs);
-String operator+(String&& lhs, const char* rhs);
-String operator+(const char* lhs, const String& rhs);
-String operator+(const char* lhs, String&& rhs);
-String operator+(const String& lhs, char rhs);
-String operator+(String&& lhs, char rhs);
-String operator+(char lhs, const String& rhs);
-String operator+(char lhs, String&& rhs);
-
-bool operator==(const String& lhs, const String& rhs) noexcept;
-bool operator==(const char* lhs, const String& rhs);
-bool operator==(const String& lhs, const char* rhs);
-bool operator!=(const String& lhs, const String& rhs) noexcept;
-bool operator!=(const char* lhs, const String& rhs);
-bool operator!=(const String& lhs, const char* rhs);
-bool operator<(const String& lhs, const String& rhs) noexcept;
-bool operator<(const char* lhs, const String& rhs);
-bool operator<(const String& lhs, const char* rhs);
-bool operator<=(const String& lhs, const String& rhs) noexcept;
-bool operator<=(const char* lhs, const String& rhs);
-bool operator<=(const String& lhs, const char* rhs);
-bool operator>(const String& lhs, const String& rhs) noexcept;
-bool operator>(const char* lhs, const String& rhs);
-bool operator>(const String& lhs, const char* rhs);
-bool operator>=(const String& lhs, const String& rhs) noexcept;
-bool operator>=(const char* lhs, const String& rhs);
-bool operator>=(const String& lhs, const char* rhs);
-
-void swap(String& lhs, String& rhs);
-
-std::istream& operator>>(std::istream& is, String& str);
-std::ostream& operator<<(std::ostream& os, const String& str);
-std::istream& getline(std::istream& is, String& str, char delim);
-std::istream& getline(std::istream&& is, String& str, char delim);
-std::istream& getline(std::istream& is, String& str);
-std::istream& getline(std::istream&& is, String& str);
-
-/******************************************** ITERATOR FUNCTIONS ********************************************/
-
-/* Dereference the pointer */
-template<bool constness>
-template<bool _constness> std::enable_if_t<_constness, typename String::Iterator<constness>::reference>
-String::Iterator<constness>::operator*() const
-{
-	return *m_cp;
-}
-
-/* Dereference the pointer */
-template<bool constness>
-template<bool _constness> std::enable_if_t<!_constness, typename String::Iterator<constness>::reference>
-String::Iterator<constness>::operator*()
-{
-	return *m_cp;
-}
-
-/* Iterate one place forward */
-template<typename bool constness>
-String::Iterator<constness>& String::Iterator<constness>::operator++()
-{
-	++m_cp;
-	return *this;
-}
-
-/* Iterate one place forward, return the old pointer */
-template<typename bool constness>
-String::Iterator<constness> String::Iterator<constness>::operator++(int)
-{
-	Iterator result(m_cp);
-	++m_cp;
-	return result;
-}
-
-/* Iterate one place backward */
-template<typename bool constness>
-String::Iterator<constness>& String::Iterator<constness>::operator--()
-{
-	--m_cp;
-	return *this;
-}
-
-/* Iterate one place backward, return the old pointer */
-template<typename bool constness>
-String::Iterator<constness> String::Iterator<constness>::operator--(int)
-{
-	Iterator result(m_cp);
-	--m_cp;
-	return result;
-}
-
-/* Return the dereferenced character at the given index */
-template<bool constness> template<bool _constness>
-std::enable_if_t<_constness, typename String::Iterator<constness>::reference>
-String::Iterator<constness>::operator[](size_t index) const
-{
-	return *(m_cp + index);
-}
-
-/* Return the dereferenced character at the given index */
-template<bool constness> template<bool _constness>
-std::enable_if_t<!_constness, typename String::Iterator<constness>::reference>
-String::Iterator<constness>::operator[](size_t index)
-{
-	return *(m_cp + index);
-}
-
-/* Return the iterator, that's incremented (n) times */
-template<bool constness>
-String::Iterator<constness> String::Iterator<constness>::operator+(size_t n) const
-{
-	return Iterator(m_cp + n);
-}
-
-/* Return the iterator, that's decremented (n) times */
-template<bool constness>
-String::Iterator<constness> String::Iterator<constness>::operator-(size_t n) const
-{
-	return Iterator(m_cp + n);
-}
-
-/* Move this iterator forward (n) times */
-template<bool constness>
-String::Iterator<constness>& String::Iterator<constness>::operator+=(size_t n)
-{
-	m_cp += n;
-	return *this;
-}
-
-/* Move this iterator backward (n) times */
-template<bool constness>
-String::Iterator<constness>& String::Iterator<constness>::operator-=(size_t n)
-{
-	m_cp -= n;
-	return *this;
-}
-
-/* Check if the iterators are equal to each other */
-template<bool constness>
-bool String::Iterator<constness>::operator==(const const_iterator& rhs) const
-{
-	return m_cp == rhs.m_cp;
-}
-
-/* Check if the iterators aren't equal to each other */
-template<bool constness>
-bool String::Iterator<constness>::operator!=(const const_iterator& rhs) const
-{
-	return !(*this == rhs);
-}
-
-/* Check if the first iterator is lesser than the second */
-template<bool constness>
-bool String::Iterator<constness>::operator<(const const_iterator& rhs) const
-{
-	return m_cp < rhs.m_cp;
-}
-
-/* Check if the first iterator is lesser than or equal to the second */
-template<bool constness>
-bool String::Iterator<constness>::operator<=(const const_iterator& rhs) const
-{
-	return (*this < rhs) || (*this == rhs);
-}
-
-/* Check if the first iterator is higher than the second */
-template<bool constness>
-bool String::Iterator<constness>::operator>(const const_iterator& rhs) const
-{
-	return !(*this < rhs) && (*this != rhs);
-}
-
-/* Check if the first iterator is higher than or equal to the second */
-template<bool constness>
-bool String::Iterator<constness>::operator>=(const const_iterator& rhs) const
-{
-	return (*this > rhs) || (*this == rhs);
-}
-
-
-/* Iterate this reverse iterator "forwards"*/
-template <bool constness>
-String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator++()
-{
-	--m_cp;
-	return *this;
-}
-
-/* Iterate this reverse iterator "forwards", return the old reverse iterator */
-template <bool constness>
-String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator++(int)
-{
-	Reverse_Iterator result(m_cp);
-	--m_cp;
-	return result;
-}
-
-/* Iterate this reverse iterator "backwards" */
-template <bool constness>
-String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator--()
-{
-	++m_cp;
-	return *this;
-}
-
-/* Iterate this reverse iterator "backwards", return the old reverse iterator */
-template <bool constness>
-String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator--(int)
-{
-	Reverse_Iterator result(m_cp);
-	++m_cp;
-	return result;
-}
-
-/* Move the reverse iterator "fowards" (n) times, return it */
-template<bool constness>
-String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator+(size_t n) const
-{
-	return Reverse_Iterator(m_cp - n);
-}
-
-/* Move the reverse iterator "backwards" (n) times, return it */
-template<bool constness>
-String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator-(size_t n) const
-{
-	return Reverse_Iterator(m_cp + n);
-}
-
-/* Move this reverse iterator "fowards" (n) times, return it*/
-template<bool constness>
-String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator+=(size_t n)
-{
-	m_cp -= n;
-	return *this;
-}
-
-/* Move this reverse iterator "backwards" (n) times, return it */
-template <bool constness>
-String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator-=(size_t n)
-{
-	m_cp += n;
-	return *this;
-}
-
-/* Dereference this reverse iterator */
-template<bool constness> template<bool _constness> 
-std::enable_if_t<_constness, typename String::Reverse_Iterator<constness>::reference>
-String::Reverse_Iterator<constness>::operator*() const
-{
-	return *m_cp;
-}
-
-/* Dereference this reverse iterator */
-template<bool constness> template<bool _constness>
-std::enable_if_t<!_constness, typename String::Reverse_Iterator<constness>::reference>
-String::Reverse_Iterator<constness>::operator*()
-{
-	return *m_cp;
-}
-
-/* Return the dereferenced character at the given index */
-template<bool constness> template<bool _constness>
-std::enable_if_t<_constness, typename String::Reverse_Iterator<constness>::reference>
-String::Reverse_Iterator<constness>::operator[](size_t index) const
-{
-	return *(m_cp + index);
-}
-
-/* Return the dereferenced character at the given index */
-template<bool constness> template<bool _constness>
-std::enable_if_t<!_constness, typename String::Reverse_Iterator<constness>::reference>
-String::Reverse_Iterator<constness>::operator[](size_t index)
-{
-	return *(m_cp + index);
-}
-
-/* Check if both reverse iterators are equal to each other */
-template <bool constness>
-bool String::Reverse_Iterator<constness>::operator==(const const_reverse_iterator& rhs) const
-{
-	return (m_cp == rhs.m_cp);
-}
-
-/* Check if both reverse iterators aren't equal to each other */
-template <bool constness>
-bool String::Reverse_Iterator<constness>::operator!=(const const_reverse_iterator& rhs) const
-{
-	return !(*this == rhs);
-}
-
-/* Check if this reverse iterator is lesser than the second */
-template <bool constness>
-bool String::Reverse_Iterator<constness>::operator<(const const_reverse_iterator& rhs) const
-{
-	return m_cp < rhs.m_cp;
-}
-
-/* Check if this reverse iterator is lesser than or equal to the second */
-template <bool constness>
-bool String::Reverse_Iterator<constness>::operator<=(const const_reverse_iterator& rhs) const
-{
-	return (*this < rhs) || (*this == rhs);
-}
-
-/* Check if this reverse iterator is higher than the second */
-template <bool constness>
-bool String::Reverse_Iterator<constness>::operator>(const const_reverse_iterator& rhs) const
-{
-	return (*this != rhs) && !(*this < rhs);
-}
-
-/* Check if this reverse iterator is higher than or equal to the second */
-template <bool constness>
-bool String::Reverse_Iterator<constness>::operator>=(const const_reverse_iterator& rhs) const
-{
-	return (*this > rhs) || (*this == rhs);
-}
-
-/************************************* STRING ITERATOR FUNCTIONS ****************************************/
-
-/* Create String from two the range in between two input iterators */
-template<typename InputIterator> String::String(InputIterator first, InputIterator last)
-{
-	size_t size = 0;
-	for (InputIterator beg = first; beg != last; beg++, size++)
-		;
-	cap = sz = size;
-	cp = alloc.allocate(cap);
-
-	size_t i = 0;
-	for (InputIterator beg = first; beg != last; beg++, i++)
-		alloc.construct(cp + i, *beg);
-}
-
-/* Append the String created from the given range, to this String */
-template<typename InputIterator> String& String::append(InputIterator first, InputIterator last)
-{
-	size_t itSize = 0;
-	for (InputIterator beg = first; beg != last; beg++, itSize++)
-		;
-	size_t newSize = sz + itSize;
-
-	InputIterator beg = first;
-	if (cap >= newSize) {
-		for (size_t i = 0; i < itSize; i++)
-			alloc.construct(cp + sz++, *(beg + i));
-	}
-	else {
-		auto newCp = alloc.allocate(newSize);
-		size_t i = 0;
-		for (; i < sz; i++)
-			alloc.construct(newCp + i, std::move(*(cp + i)));
-		free();
-		for (size_t j = 0; j < itSize; j++)
-			alloc.construct(newCp + i++, *(beg + j));
-		cp = newCp;
-		sz = cap = newSize;
-	}
-	return *this;
-}
-
-/* Assign this String to the String created from the given range */
-template<typename InputIterator> String& String::assign(InputIterator first, InputIterator last)
-{
-	size_t itSize = 0;
-	for (InputIterator beg = first; beg != last; beg++, itSize++)
-		;
-
-	InputIterator beg = first;
-	if (cap >= itSize) {
-		for (int i = sz; i >= 0; i--)
-			alloc.destroy(cp + i);
-		for (size_t j = 0; j < itSize; j++)
-			alloc.construct(cp + j, *beg++);
-		sz = itSize;
-	}
-	else {
-		free();
-		sz = cap = itSize;
-		cp = alloc.allocate(cap);
-		for (size_t i = 0; i < sz; i++)
-			alloc.construct(cp + i, *beg++);
-	}
-	return *this;
-}
-
-/* Insert the characters from the given range into the place where iterator points to */
-template<typename InputIterator> 
-String::iterator String::insert(iterator p, InputIterator first, InputIterator last)
-{
-	bool match = false;
-	size_t index = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (beg == p) {
-			match = true;
-			break;
-		}
-	}
-	if (match == false) {
-		match = (end() == p);
-		if (match == false)
-			return last;
-	}
-	
-	size_t rangeSize = 0;
-	for (InputIterator beg = first; beg != last; beg++)
-		rangeSize++;
-	const size_t newSize = sz + rangeSize;
-	String old(*this);
-	if (cap >= newSize) {
-		if (cp) {
-			for (int i = sz - 1; i >= 0; i--)
-				alloc.destroy(cp + i);
-		}
-		sz = newSize;
-	}
-	else {
-		free();
-		cp = alloc.allocate(newSize);
-		sz = cap = newSize;
-	}
-
-	InputIterator beg = first;
-	size_t i = 0;
-	for (; i < index; i++)
-		alloc.construct(cp + i, *(old.cp + i));
-	size_t stopPlace = i;
-	for (size_t j = 0; j < rangeSize; j++)
-		alloc.construct(cp + i++, *beg++);
-	for (; stopPlace < old.sz; stopPlace++)
-		alloc.construct(cp + i++, *(old.cp + stopPlace));
-	return (begin() + index + rangeSize);
-}
-
-/* Replace the given range with characters from the second range */
-template<typename InputIterator>
-String& String::replace(const_iterator i1, const_iterator i2, InputIterator first, InputIterator last)
-{
-	bool match1 = false;
-	bool match2 = false;
-	size_t index_last = 0, index = 0;
-	size_t index_first = 0;
-	for (iterator beg = begin(); beg != end(); beg++, index++) {
-		if (i1 == beg) {
-			match1 = true;
-			index_first = index;
-		}
-		if (i2 == beg) {
-			match2 = true;
-			index_last = index;
-		}
-	}
-	if (match2 == false) {
-		match2 = (i2 == end());
-		index_last = index;
-	}
-	if (match1 == false || match2 == false)
-		return *this;
-	
-	size_t rangeSize = 0;
-	for (InputIterator beg = first; beg != last; beg++)
-		rangeSize++;
-	size_t newSize = sz - (index_last - index_first) + rangeSize;
-	auto newCp = alloc.allocate((newSize > cap) ? newSize : cap);
-
-	size_t i = 0;
-	for (; i < index_first; i++)
-		alloc.construct(newCp + i, std::move(*(cp + i)));
-	size_t left = i + (index_last - index_first);
-
-	InputIterator iter = first;
-	for (size_t j = 0; j < rangeSize; j++)
-		alloc.construct(newCp + i++, *iter++);
-	for (size_t j = left; j < sz; j++)
-		alloc.construct(newCp + i++, std::move(*(cp + j)));
-
-	free();
-	sz = cap = newSize;
-	cp = newCp;
-	return *this;
-}
\ No newline at end of file
+#pragma once
+
+#include <memory>
+#include <initializer_list>
+#include <iostream>
+#include <type_traits>
+#include <stdexcept>
+#include <string_view>
+#include <iterator>
+#include <functional>
+#include <vector>
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#include "StringStats.h"
+#include "StringTrace.h"
+
+/* Format strings are checked while compiling if the compiler supports consteval, otherwise when they're created */
+#if defined(__cpp_consteval)
+#define STRING_CONSTEVAL consteval
+#else
+#define STRING_CONSTEVAL constexpr
+#endif
+
+/* The core of String can be used in constant expressions when the compiler can allocate in them (C++20),
+older standards get the same functions inline */
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) \
+	&& defined(__cpp_lib_constexpr_string) && defined(__cpp_lib_is_constant_evaluated)
+#define STRING_CONSTEXPR constexpr
+#define STRING_HAS_CONSTEXPR 1
+#else
+#define STRING_CONSTEXPR inline
+#define STRING_HAS_CONSTEXPR 0
+#endif
+
+/*********************************************** CLASSES ***************************************************/
+
+/*/////////////////////////////////////////// String class ////////////////////////////////////////////////*/
+
+class String
+{
+private:
+	/* Capacity of the buffer, its top bit marks a buffer taken over by adopt(), whose deleter is kept outside of
+	the String. Reading, copying and assigning it only touch the capacity, the mark changes with set_adopted() */
+	class Capacity
+	{
+	public:
+		static constexpr size_t adopted_bit = ~(~size_t(0) >> 1);
+
+		explicit constexpr Capacity(size_t n = 0) noexcept : m_bits(n) {}
+		constexpr Capacity(const Capacity& other) noexcept : m_bits(other) {}
+		constexpr Capacity& operator=(const Capacity& other) noexcept { return *this = size_t(other); }
+		constexpr Capacity& operator=(size_t n) noexcept { m_bits = (m_bits & adopted_bit) | n; return *this; }
+		constexpr operator size_t() const noexcept { return m_bits & ~adopted_bit; }
+
+		constexpr bool adopted() const noexcept { return m_bits & adopted_bit; }
+		constexpr void set_adopted(bool adopted) noexcept { m_bits = adopted ? (m_bits | adopted_bit) : (m_bits & ~adopted_bit); }
+	private:
+		size_t m_bits;
+	};
+
+	//Helping functions
+	void reallocate();
+	STRING_CONSTEXPR void free();
+	void grow(size_t n);
+	STRING_CONSTEXPR char* allocate(size_t n, size_t moved = 0);
+	static STRING_CONSTEXPR void deallocate(char* p, size_t n);
+	static STRING_CONSTEXPR void construct(char* p, char ch) { std::allocator_traits<std::allocator<char>>::construct(alloc, p, ch); }
+	static STRING_CONSTEXPR void destroy(char* p) { std::allocator_traits<std::allocator<char>>::destroy(alloc, p); }
+	STRING_CONSTEXPR void terminate() noexcept { if (cp) construct(cp + sz, '\0'); }
+	STRING_CONSTEXPR bool aliases(const char* ptr) const noexcept;
+	static constexpr bool constant_evaluated() noexcept;
+	static void deallocate_released(char* p, size_t n);
+	STRING_CONSTEXPR String& append_text(const char* ptr, size_t n);
+	bool oversized(size_t used) const noexcept;
+	String& append_signed(long long value);
+	String& append_unsigned(unsigned long long value);
+	static size_t count_matches(const char* text, size_t textLen, const char* pat, size_t patLen,
+		size_t pos, size_t end, std::vector<size_t>* found);
+	size_t parallel_matches(const char* pat, size_t patLen, size_t pos, std::vector<size_t>* found) const;
+	size_t parallel_search(const char* pat, size_t patLen, size_t pos) const;
+
+	//Range helpers, reading contiguous ranges with one copy and single-pass ranges in one pass
+	template<typename It> static constexpr bool contiguous_range() noexcept;
+	template<typename It> static const char* range_data(It it) noexcept;
+	template<typename It> static auto range_length(It first, It last, int) -> decltype(size_t(last - first));
+	template<typename It> static size_t range_length(It first, It last, long);
+	template<typename It> void append_range(It first, It last);
+	size_t index_of(const char* ptr) const noexcept;
+	void append_chars(const char* ptr, size_t n);
+	void assign_chars(const char* ptr, size_t n);
+	void insert_chars(size_t pos, const char* ptr, size_t n);
+	void replace_chars(size_t pos, size_t len, const char* ptr, size_t n);
+	template<bool constness = false> class Iterator;
+	template<bool constness = false> class Reverse_Iterator;
+
+	//Text helpers, usable in constant expressions
+	static STRING_CONSTEXPR int compare_texts(const char* lhs, size_t lhsLen, const char* rhs, size_t rhsLen);
+	static STRING_CONSTEXPR size_t first_match(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos);
+	static STRING_CONSTEXPR size_t last_match(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos);
+	static STRING_CONSTEXPR size_t first_of(const char* text, size_t textLen, const char* set, size_t setLen, size_t pos, bool member);
+	static STRING_CONSTEXPR size_t last_of(const char* text, size_t textLen, const char* set, size_t setLen, size_t pos, bool member);
+
+	//Formatting helpers
+	enum class Format_Kind { Signed, Unsigned, Double, Float, Text, Character, None };
+	struct Format_Spec;
+	struct Format_Arg;
+	template<typename T> static constexpr Format_Kind format_kind();
+	template<typename T> static Format_Arg make_format_arg(const T& value);
+	static constexpr bool parse_format_spec(const char* str, size_t len, size_t& i, Format_Spec& spec);
+	static void vformat_to(String& out, const char* fmt, size_t len, const Format_Arg* args);
+public:
+	//Types
+	typedef char value_type;
+	typedef std::char_traits<char> char_traits;
+	typedef std::allocator<char> allocator_type;
+	typedef char& reference;
+	typedef const char& const_reference;
+	typedef char* pointer;
+	typedef const char* const_pointer;
+	typedef std::ptrdiff_t difference_type;
+	typedef size_t size_type;
+	typedef Iterator<> iterator;
+	typedef Iterator<true> const_iterator;
+	typedef Reverse_Iterator<> reverse_iterator;
+	typedef Reverse_Iterator<true> const_reverse_iterator;
+	template<typename... Args> class Format_String;
+	class Char_Set;
+	class Code_Point_Iterator;
+	class Code_Point_Range;
+	typedef void (*Deleter)(char* buffer, size_t capacity);
+	struct Buffer;
+
+	//Public const member
+	static const size_t npos = -1;
+
+public:
+	//Constructors, Destructor
+	String() = default;
+	STRING_CONSTEXPR String(const char* cptr);
+	STRING_CONSTEXPR String(const char* cptr, size_t n);
+	STRING_CONSTEXPR String(size_t n, char ch);
+	STRING_CONSTEXPR String(std::initializer_list<char> lst);
+	template<typename InputIterator> String(InputIterator first, InputIterator last);
+	STRING_CONSTEXPR String(const String& str);
+	STRING_CONSTEXPR String(const String& str, size_t subpos, size_t sublen = npos);
+	STRING_CONSTEXPR String(String&& str) noexcept;
+	STRING_CONSTEXPR ~String() { free(); }
+
+	//Assignment overloads
+	STRING_CONSTEXPR String& operator=(const String& str);
+	STRING_CONSTEXPR String& operator=(const char* cptr);
+	String& operator=(char ch);
+	String& operator=(std::initializer_list<char> lst);
+	STRING_CONSTEXPR String& operator=(String&& str) noexcept;
+
+	//Iterators
+	iterator begin() noexcept;
+	const_iterator begin() const noexcept;
+	iterator end() noexcept;
+	const_iterator end() const noexcept;
+
+	reverse_iterator rbegin() noexcept;
+	const_reverse_iterator rbegin() const noexcept;
+	reverse_iterator rend() noexcept;
+	const_reverse_iterator rend() const noexcept;
+
+	const_iterator cbegin() const noexcept;
+	const_iterator cend() const noexcept;
+
+	const_reverse_iterator crbegin() const noexcept;
+	const_reverse_iterator crend() const noexcept;
+	//Capacity
+	STRING_CONSTEXPR size_t size() const noexcept { return sz; }
+	STRING_CONSTEXPR size_t length() const noexcept { return sz; }
+	STRING_CONSTEXPR size_t max_size() const noexcept { return -1; }
+	STRING_CONSTEXPR size_t capacity() const noexcept { return cap; }
+	STRING_CONSTEXPR bool empty() const noexcept { return sz == 0; }
+
+	STRING_CONSTEXPR void clear();
+	STRING_CONSTEXPR void release_memory() { free(); }
+	void resize(size_t n);
+	void resize(size_t n, char ch);
+	STRING_CONSTEXPR void reserve(size_t n = 0);
+	void shrink_to_fit();
+
+	//Writing straight into the buffer
+	template<typename Operation> void resize_and_overwrite(size_t n, Operation op);
+	char* prepare(size_t n);
+	void commit(size_t n);
+
+	//Ownership of the buffer
+	Buffer release() noexcept;
+	void adopt(char* ptr, size_t size, size_t capacity, Deleter deleter);
+
+	//Memory policy of clear()
+	static void set_memory_policy(size_t highWaterMark, size_t shrinkRatio) noexcept;
+
+	//Element access
+	STRING_CONSTEXPR char& operator[](size_t n);
+	STRING_CONSTEXPR const char& operator[](size_t n) const;
+
+	STRING_CONSTEXPR char& at(size_t n);
+	STRING_CONSTEXPR const char& at(size_t n) const;
+
+	STRING_CONSTEXPR char& back();
+	STRING_CONSTEXPR const char& back() const;
+
+	STRING_CONSTEXPR char& front();
+	STRING_CONSTEXPR const char& front() const;
+
+	//Modifiers
+	STRING_CONSTEXPR String& operator+=(const String& str);
+	STRING_CONSTEXPR String& operator+=(const char* cptr);
+	STRING_CONSTEXPR String& operator+=(char ch);
+	STRING_CONSTEXPR String& operator+=(std::initializer_list<char> lst);
+
+	STRING_CONSTEXPR String& append(const String& str);
+	STRING_CONSTEXPR String& append(const String&, size_t str, size_t n = npos);
+	STRING_CONSTEXPR String& append(const char* cptr);
+	STRING_CONSTEXPR String& append(const char* cptr, size_t n);
+	STRING_CONSTEXPR String& append(size_t n, char ch);
+	template<typename InputIterator> String& append(InputIterator first, InputIterator last);
+	STRING_CONSTEXPR String& append(std::initializer_list<char> lst);
+
+	STRING_CONSTEXPR void push_back(char ch);
+
+	String& assign(const String& str);
+	String& assign(const String& str, size_t subpos, size_t sublen = npos);
+	String& assign(const char* cptr);
+	String& assign(const char* cptr, size_t n);
+	String& assign(size_t n, char ch);
+	template<typename InputIterator> String& assign(InputIterator first, InputIterator last);
+	String& assign(std::initializer_list<char> lst);
+	String& assign(String&& str) noexcept;
+
+	String& insert(size_t pos, const String& str);
+	String& insert(size_t pos, const String& str, size_t subpos, size_t sublen = npos);
+	String& insert(size_t pos, const char* cptr);
+	String& insert(size_t pos, const char* cptr, size_t n);
+	String& insert(size_t pos, size_t n, char ch);
+	iterator insert(const_iterator p, size_t n, char ch);
+	iterator insert(const_iterator p, char ch);
+	template<typename InputIterator> iterator insert(iterator p, InputIterator first, InputIterator last);
+	String& insert(const_iterator p, std::initializer_list<char> lst);
+
+	String& erase(size_t pos, size_t len = npos);
+	iterator erase(const_iterator p);
+	iterator erase(const_iterator first, const_iterator last);
+
+	String& replace(size_t pos, size_t len, const String& str);
+	String& replace(const_iterator first, const_iterator last, const String& str);
+	String& replace(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen = npos);
+	String& replace(size_t pos, size_t len, const char* cptr);
+	String& replace(const_iterator first, const_iterator last, const char* cptr);
+	String& replace(size_t pos, size_t len, const char* cptr, size_t n);
+	String& replace(const_iterator first, const_iterator last, const char* cptr, size_t n);
+	String& replace(size_t pos, size_t len, size_t n, char ch);
+	String& replace(const_iterator first, const_iterator last, size_t n, char ch);
+	template<typename InputIterator> 
+		String& replace(const_iterator i1, const_iterator i2, InputIterator first, InputIterator last);
+	String& replace(const_iterator first, const_iterator last, std::initializer_list<char> lst);
+
+	void swap(String& str);
+
+	void pop_back();
+
+	//String operations
+	STRING_CONSTEXPR const char* c_str() const noexcept { return cp ? cp : ""; }
+	STRING_CONSTEXPR const char* data() const noexcept { return c_str(); }
+	allocator_type get_allocator() const noexcept;
+	size_t copy(char* cptr, size_t len, size_t pos = 0) const;
+
+	STRING_CONSTEXPR size_t find(const String& str, size_t pos = 0) const noexcept;
+	STRING_CONSTEXPR size_t find(const char* cptr, size_t pos = 0) const;
+	STRING_CONSTEXPR size_t find(const char* cptr, size_t pos, size_t n) const;
+	STRING_CONSTEXPR size_t find(char c, size_t pos = 0) const noexcept;
+	STRING_CONSTEXPR size_t rfind(const String& str, size_t pos = npos) const noexcept;
+	STRING_CONSTEXPR size_t rfind(const char* cptr, size_t pos = npos) const;
+	STRING_CONSTEXPR size_t rfind(const char* cptr, size_t pos, size_t n) const;
+	STRING_CONSTEXPR size_t rfind(char c, size_t pos = npos) const noexcept;
+
+	STRING_CONSTEXPR size_t find_first_of(const String& str, size_t pos = 0) const noexcept;
+	STRING_CONSTEXPR size_t find_first_of(const char* cptr, size_t pos = 0) const;
+	STRING_CONSTEXPR size_t find_first_of(const char* cptr, size_t pos, size_t n) const;
+	STRING_CONSTEXPR size_t find_first_of(char ch, size_t pos = 0) const noexcept;
+	STRING_CONSTEXPR size_t find_last_of(const String& str, size_t pos = npos) const noexcept;
+	STRING_CONSTEXPR size_t find_last_of(const char* cptr, size_t pos = npos) const;
+	STRING_CONSTEXPR size_t find_last_of(const char* cptr, size_t pos, size_t n) const;
+	STRING_CONSTEXPR size_t find_last_of(char ch, size_t pos = npos) const noexcept;
+
+	STRING_CONSTEXPR size_t find_first_not_of(const String& str, size_t pos = 0) const noexcept;
+	STRING_CONSTEXPR size_t find_first_not_of(const char* cptr, size_t pos = 0) const;
+	STRING_CONSTEXPR size_t find_first_not_of(const char* cptr, size_t pos, size_t n) const;
+	STRING_CONSTEXPR size_t find_first_not_of(char ch, size_t pos = 0) const noexcept;
+	STRING_CONSTEXPR size_t find_last_not_of(const String& str, size_t pos = npos) const noexcept;
+	STRING_CONSTEXPR size_t find_last_not_of(const char* cptr, size_t pos = npos) const;
+	STRING_CONSTEXPR size_t find_last_not_of(const char* cptr, size_t pos, size_t n) const;
+	STRING_CONSTEXPR size_t find_last_not_of(char ch, size_t pos = npos) const noexcept;
+
+	STRING_CONSTEXPR String substr(size_t pos = 0, size_t len = npos) const;
+	STRING_CONSTEXPR int compare(const String& str) const noexcept;
+	STRING_CONSTEXPR int compare(size_t pos, size_t len, const String& str) const;
+	STRING_CONSTEXPR int compare(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen = npos) const;
+	STRING_CONSTEXPR int compare(const char* cptr) const;
+	STRING_CONSTEXPR int compare(size_t pos, size_t len, const char* cptr) const;
+	STRING_CONSTEXPR int compare(size_t pos, size_t len, const char* cptr, size_t n) const;
+
+	static size_t search(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos = 0) noexcept;
+	static size_t isearch(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos = 0) noexcept;
+
+	size_t count(const String& str, size_t pos = 0) const;
+	size_t count(const char* cptr, size_t pos = 0) const;
+	std::vector<size_t> find_all(const String& str, size_t pos = 0) const;
+	std::vector<size_t> find_all(const char* cptr, size_t pos = 0) const;
+
+	//Parallel search, splitting the text between the threads of String_Pool (StringParallel.h)
+	size_t parallel_find(const String& str, size_t pos = 0) const;
+	size_t parallel_find(const char* cptr, size_t pos = 0) const;
+	std::vector<size_t> parallel_find_all(const String& str, size_t pos = 0) const;
+	std::vector<size_t> parallel_find_all(const char* cptr, size_t pos = 0) const;
+	size_t parallel_count(const String& str, size_t pos = 0) const;
+	size_t parallel_count(const char* cptr, size_t pos = 0) const;
+
+	//ASCII case conversion
+	String& to_lower() noexcept;
+	String& to_upper() noexcept;
+	String lower() const;
+	String upper() const;
+
+	bool iequals(const String& str) const noexcept;
+	bool iequals(const char* cptr) const;
+	int icompare(const String& str) const noexcept;
+	int icompare(const char* cptr) const;
+	size_t ifind(const String& str, size_t pos = 0) const noexcept;
+	size_t ifind(const char* cptr, size_t pos = 0) const;
+
+	//Trimming
+	String& trim() noexcept;
+	String& trim(const Char_Set& set) noexcept;
+	String& ltrim() noexcept;
+	String& ltrim(const Char_Set& set) noexcept;
+	String& rtrim() noexcept;
+	String& rtrim(const Char_Set& set) noexcept;
+
+	std::string_view trimmed() const noexcept;
+	std::string_view trimmed(const Char_Set& set) const noexcept;
+	std::string_view ltrimmed() const noexcept;
+	std::string_view ltrimmed(const Char_Set& set) const noexcept;
+	std::string_view rtrimmed() const noexcept;
+	std::string_view rtrimmed(const Char_Set& set) const noexcept;
+
+	//UTF-8
+	bool utf8_valid() const noexcept;
+	size_t utf8_length() const noexcept;
+	Code_Point_Range code_points() const noexcept;
+	String utf8_substr(size_t pos = 0, size_t len = npos) const;
+	String& utf8_truncate(size_t n) noexcept;
+	static char32_t decode_utf8(const char* first, const char* last, size_t& len) noexcept;
+
+	//Numeric conversions
+	static String from_int(long long value);
+	static String from_uint(unsigned long long value);
+	static String from_double(double value);
+
+	template<typename Integer> std::enable_if_t<std::is_integral_v<Integer>, String&> append_number(Integer value);
+	String& append_number(double value);
+	String& append_number(float value);
+
+	long long to_int(size_t* idx = nullptr, int base = 10) const;
+	unsigned long long to_uint(size_t* idx = nullptr, int base = 10) const;
+	double to_double(size_t* idx = nullptr) const;
+
+	//Formatting
+	template<typename... Args> static String format(Format_String<std::decay_t<Args>...> fmt, Args&&... args);
+
+	//Non-member function overloads
+	friend STRING_CONSTEXPR String operator+(const String&, const String&);
+	friend STRING_CONSTEXPR String operator+(const String&, String&&);
+	friend STRING_CONSTEXPR String operator+(String&&, const String&);
+	friend STRING_CONSTEXPR String operator+(String&&, String&&);
+	friend STRING_CONSTEXPR String operator+(const String&, const char*);
+	friend STRING_CONSTEXPR String operator+(String&&, const char*);
+	friend STRING_CONSTEXPR String operator+(const char*, const String&);
+	friend STRING_CONSTEXPR String operator+(const char*, String&&);
+	friend STRING_CONSTEXPR String operator+(const String&, char);
+	friend STRING_CONSTEXPR String operator+(String&&, char);
+	friend STRING_CONSTEXPR String operator+(char, const String&);
+	friend STRING_CONSTEXPR String operator+(char, String&&);
+
+	friend STRING_CONSTEXPR bool operator==(const String&, const String&) noexcept;
+	friend STRING_CONSTEXPR bool operator==(const char*, const String&);
+	friend STRING_CONSTEXPR bool operator==(const String&, const char*);
+	friend STRING_CONSTEXPR bool operator!=(const String&, const String&) noexcept;
+	friend STRING_CONSTEXPR bool operator!=(const char*, const String&);
+	friend STRING_CONSTEXPR bool operator!=(const String&, const char*);
+	friend STRING_CONSTEXPR bool operator<(const String&, const String&) noexcept;
+	friend STRING_CONSTEXPR bool operator<(const char*, const String&);
+	friend STRING_CONSTEXPR bool operator<(const String&, const char*);
+	friend STRING_CONSTEXPR bool operator<=(const String&, const String&) noexcept;
+	friend STRING_CONSTEXPR bool operator<=(const char*, const String&);
+	friend STRING_CONSTEXPR bool operator<=(const String&, const char*);
+	friend STRING_CONSTEXPR bool operator>(const String&, const String&) noexcept;
+	friend STRING_CONSTEXPR bool operator>(const char*, const String&);
+	friend STRING_CONSTEXPR bool operator>(const String&, const char*);
+	friend STRING_CONSTEXPR bool operator>=(const String&, const String&) noexcept;
+	friend STRING_CONSTEXPR bool operator>=(const char*, const String&);
+	friend STRING_CONSTEXPR bool operator>=(const String&, const char*);
+
+	friend void swap(String&, String&);
+
+	friend std::istream& operator>>(std::istream&, const String&);
+	friend std::ostream& operator<<(std::ostream&, const String&);
+
+	friend std::istream& getline(std::istream&, String&, char);
+	friend std::istream& getline(std::istream&&, String&, char);
+	friend std::istream& getline(std::istream&, String&);
+	friend std::istream& getline(std::istream&&, String&);
+
+	template<typename... Args>
+	friend String& format_to(String& out, Format_String<std::decay_t<Args>...> fmt, Args&&... args);
+private:
+	//Deleters of the adopted buffers, kept outside of the String
+	static Deleter take_deleter(const char* p) noexcept;
+
+	static std::allocator<char> alloc;
+	size_t sz = 0;
+	char* cp = nullptr;
+	Capacity cap{ 0 };
+};
+
+
+/*//////////////////////////////////////////// Iterator class ////////////////////////////////////////////////*/
+
+/* String's iterator. It's contiguous, so algorithms and ranges can work on the characters through std::to_address() */
+template<bool constness> class String::Iterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+#ifdef __cpp_lib_concepts
+	using iterator_concept = std::contiguous_iterator_tag;
+#endif
+	using value_type = char;
+	using difference_type = std::ptrdiff_t;
+	using reference = typename std::conditional_t<constness, const char&, char&>;
+	using pointer = typename std::conditional_t<constness, const char*, char*>;
+public:
+	Iterator() = default;
+	explicit Iterator(char* cp) : m_cp(cp) {}
+
+	/* Conversion */
+	operator const_iterator() const { return const_iterator(m_cp); }
+	template<bool> friend class Iterator;
+	friend String;
+
+	/* Iterate operations */
+	Iterator& operator++();
+	Iterator operator++(int);
+	Iterator& operator--();
+	Iterator operator--(int);
+
+	Iterator operator+(difference_type n) const;
+	Iterator& operator+=(difference_type n);
+	Iterator operator-(difference_type n) const;
+	Iterator& operator-=(difference_type n);
+	template<bool other> difference_type operator-(const Iterator<other>& rhs) const;
+	friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+
+	/* Access operations */
+	reference operator*() const;
+	pointer operator->() const;
+	reference operator[](difference_type index) const;
+
+	/* Rational operations */
+	template<bool other> bool operator<(const Iterator<other>& rhs) const;
+	template<bool other> bool operator<=(const Iterator<other>& rhs) const;
+	template<bool other> bool operator>(const Iterator<other>& rhs) const;
+	template<bool other> bool operator>=(const Iterator<other>& rhs) const;
+	template<bool other> bool operator==(const Iterator<other>& rhs) const;
+	template<bool other> bool operator!=(const Iterator<other>& rhs) const;
+private:
+	pointer m_cp = nullptr;
+};
+
+
+/* String's reverse iterator, based of normal String's Iterator. It walks the characters backwards,
+so it's random-access, but not contiguous */
+template <bool constness> class String::Reverse_Iterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = char;
+	using difference_type = std::ptrdiff_t;
+	using reference = typename std::conditional_t<constness, const char&, char&>;
+	using pointer = typename std::conditional_t<constness, const char*, char*>;
+public:
+	Reverse_Iterator() = default;
+	Reverse_Iterator(char* cp) : m_cp(cp) {}
+
+	/* Conversion */
+	operator const_reverse_iterator() const { return const_reverse_iterator(m_cp); }
+	template<bool> friend class Reverse_Iterator;
+
+	/* Iterate operations */
+	Reverse_Iterator& operator++();
+	Reverse_Iterator operator++(int);
+	Reverse_Iterator& operator--();
+	Reverse_Iterator operator--(int);
+
+	Reverse_Iterator operator+(difference_type n) const;
+	Reverse_Iterator& operator+=(difference_type n);
+	Reverse_Iterator operator-(difference_type n) const;
+	Reverse_Iterator& operator-=(difference_type n);
+	template<bool other> difference_type operator-(const Reverse_Iterator<other>& rhs) const;
+	friend Reverse_Iterator operator+(difference_type n, const Reverse_Iterator& it) { return it + n; }
+
+	/* Access operations */
+	reference operator*() const;
+	pointer operator->() const;
+	reference operator[](difference_type index) const;
+
+	/* Rational operations */
+	template<bool other> bool operator<(const Reverse_Iterator<other>& rhs) const;
+	template<bool other> bool operator<=(const Reverse_Iterator<other>& rhs) const;
+	template<bool other> bool operator>(const Reverse_Iterator<other>& rhs) const;
+	template<bool other> bool operator>=(const Reverse_Iterator<other>& rhs) const;
+	template<bool other> bool operator==(const Reverse_Iterator<other>& rhs) const;
+	template<bool other> bool operator!=(const Reverse_Iterator<other>& rhs) const;
+private:
+	pointer m_cp = nullptr; // One past the character, so rend() doesn't point before the text
+};
+
+/*//////////////////////////////////////////// Char_Set class ////////////////////////////////////////////////*/
+
+/* Set of characters stored as a 256-bit bitmap, small sets also keep the list of their members,
+so they can be scanned for with vector comparisons */
+class String::Char_Set
+{
+public:
+	static constexpr size_t max_members = 16;
+
+	constexpr Char_Set(const char* cptr) : Char_Set(cptr, std::char_traits<char>::length(cptr)) {}
+	constexpr Char_Set(const char* cptr, size_t n)
+	{
+		for (size_t i = 0; i < n; i++) {
+			unsigned char ch = static_cast<unsigned char>(cptr[i]);
+			if (contains(ch))
+				continue;
+			m_bits[ch >> 6] |= 1ULL << (ch & 63);
+			if (m_count < max_members)
+				m_members[m_count] = cptr[i];
+			m_count++;
+		}
+	}
+
+	/* Check if the character is in the set */
+	constexpr bool contains(char ch) const noexcept
+	{
+		unsigned char index = static_cast<unsigned char>(ch);
+		return (m_bits[index >> 6] >> (index & 63)) & 1;
+	}
+
+	size_t count() const noexcept { return m_count; }
+	const char* members() const noexcept { return m_members; }
+	bool small() const noexcept { return m_count <= max_members; }
+private:
+	unsigned long long m_bits[4] = {};
+	char m_members[max_members] = {};
+	size_t m_count = 0;
+};
+
+/*//////////////////////////////////////// Code point iterator class ////////////////////////////////////////////*/
+
+/* Forward iterator over code points of UTF-8 text, every malformed byte is read as U+FFFD */
+class String::Code_Point_Iterator
+{
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = char32_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = char32_t;
+	using pointer = const char32_t*;
+public:
+	Code_Point_Iterator(const char* cp, const char* end) : m_cp(cp), m_end(end) { decode(); }
+
+	/* Iterate operations */
+	Code_Point_Iterator& operator++() { m_cp += m_len; decode(); return *this; }
+	Code_Point_Iterator operator++(int) { Code_Point_Iterator result(*this); ++*this; return result; }
+
+	/* Access operations */
+	char32_t operator*() const { return m_value; }
+	const char* position() const { return m_cp; }
+	size_t length() const { return m_len; }
+
+	/* Rational operations */
+	bool operator==(const Code_Point_Iterator& rhs) const { return m_cp == rhs.m_cp; }
+	bool operator!=(const Code_Point_Iterator& rhs) const { return m_cp != rhs.m_cp; }
+private:
+	void decode() { m_value = (m_cp < m_end) ? decode_utf8(m_cp, m_end, m_len) : (m_len = 0, U'\0'); }
+
+	const char* m_cp;
+	const char* m_end;
+	char32_t m_value = 0;
+	size_t m_len = 0;
+};
+
+/* Range of the code points of a String, returned by String::code_points() */
+class String::Code_Point_Range
+{
+public:
+	Code_Point_Range(const char* cp, size_t sz) : m_cp(cp), m_sz(sz) {}
+
+	Code_Point_Iterator begin() const { return Code_Point_Iterator(m_cp, m_cp + m_sz); }
+	Code_Point_Iterator end() const { return Code_Point_Iterator(m_cp + m_sz, m_cp + m_sz); }
+private:
+	const char* m_cp;
+	size_t m_sz;
+};
+
+/*//////////////////////////////////////////// Buffer struct ////////////////////////////////////////////////*/
+
+/* Buffer given up by release(), it holds (capacity + 1) characters and the terminated text of (size) characters.
+Its owner frees it with deleter(data, capacity) */
+struct String::Buffer
+{
+	char* data;
+	size_t size;
+	size_t capacity;
+	Deleter deleter;
+};
+
+/*//////////////////////////////////////////// Format classes ////////////////////////////////////////////////*/
+
+/* Parsed replacement field of the format string: {}, {:x}, {:X}, {:.Nf} */
+struct String::Format_Spec
+{
+	char type = '\0';
+	int precision = -1;
+};
+
+/* Type-erased argument of the format functions */
+struct String::Format_Arg
+{
+	Format_Kind kind = Format_Kind::None;
+	union {
+		long long i;
+		unsigned long long u;
+		double d;
+		float f;
+		char ch;
+		struct {
+			const char* ptr;
+			size_t len;
+		} text;
+	};
+	Format_Arg() : u(0) {}
+};
+
+/* Format string, that is checked against the types of the arguments, every {} has to match one argument */
+template<typename... Args> class String::Format_String
+{
+public:
+	template<size_t N> STRING_CONSTEVAL Format_String(const char (&str)[N]) : m_str(str), m_len(N - 1) { check(); }
+
+	const char* str() const noexcept { return m_str; }
+	size_t length() const noexcept { return m_len; }
+private:
+	constexpr void check() const;
+
+	const char* m_str;
+	size_t m_len;
+};
+
+/*////////////////////////////////////////// Relocation trait ///////////////////////////////////////////////*/
+
+/* Types, whose objects can be moved to other memory by copying their bytes, skipping the move constructor and destructor.
+StringVector relocates them with memcpy() when it grows. String is a pointer and two sizes, nothing points back at it */
+template<typename T> struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+template<> struct is_trivially_relocatable<String> : std::true_type {};
+
+/****************************************** FUNCTIONS DECLARATIONS *********************************************/
+
+STRING_CONSTEXPR String operator+(const String& lhs, const String& rhs);
+STRING_CONSTEXPR String operator+(const String& lhs, String&& rhs);
+STRING_CONSTEXPR String operator+(String&& lhs, const String& rhs);
+STRING_CONSTEXPR String operator+(String&& lhs, String&& rhs);
+STRING_CONSTEXPR String operator+(const String& lhs, const char* rhs);
+STRING_CONSTEXPR String operator+(String&& lhs, const char* rhs);
+STRING_CONSTEXPR String operator+(const char* lhs, const String& rhs);
+STRING_CONSTEXPR String operator+(const char* lhs, String&& rhs);
+STRING_CONSTEXPR String operator+(const String& lhs, char rhs);
+STRING_CONSTEXPR String operator+(String&& lhs, char rhs);
+STRING_CONSTEXPR String operator+(char lhs, const String& rhs);
+STRING_CONSTEXPR String operator+(char lhs, String&& rhs);
+
+STRING_CONSTEXPR bool operator==(const String& lhs, const String& rhs) noexcept;
+STRING_CONSTEXPR bool operator==(const char* lhs, const String& rhs);
+STRING_CONSTEXPR bool operator==(const String& lhs, const char* rhs);
+STRING_CONSTEXPR bool operator!=(const String& lhs, const String& rhs) noexcept;
+STRING_CONSTEXPR bool operator!=(const char* lhs, const String& rhs);
+STRING_CONSTEXPR bool operator!=(const String& lhs, const char* rhs);
+STRING_CONSTEXPR bool operator<(const String& lhs, const String& rhs) noexcept;
+STRING_CONSTEXPR bool operator<(const char* lhs, const String& rhs);
+STRING_CONSTEXPR bool operator<(const String& lhs, const char* rhs);
+STRING_CONSTEXPR bool operator<=(const String& lhs, const String& rhs) noexcept;
+STRING_CONSTEXPR bool operator<=(const char* lhs, const String& rhs);
+STRING_CONSTEXPR bool operator<=(const String& lhs, const char* rhs);
+STRING_CONSTEXPR bool operator>(const String& lhs, const String& rhs) noexcept;
+STRING_CONSTEXPR bool operator>(const char* lhs, const String& rhs);
+STRING_CONSTEXPR bool operator>(const String& lhs, const char* rhs);
+STRING_CONSTEXPR bool operator>=(const String& lhs, const String& rhs) noexcept;
+STRING_CONSTEXPR bool operator>=(const char* lhs, const String& rhs);
+STRING_CONSTEXPR bool operator>=(const String& lhs, const char* rhs);
+
+void swap(String& lhs, String& rhs);
+
+std::istream& operator>>(std::istream& is, String& str);
+std::ostream& operator<<(std::ostream& os, const String& str);
+std::istream& getline(std::istream& is, String& str, char delim);
+std::istream& getline(std::istream&& is, String& str, char delim);
+std::istream& getline(std::istream& is, String& str);
+std::istream& getline(std::istream&& is, String& str);
+
+template<typename... Args>
+String& format_to(String& out, String::Format_String<std::decay_t<Args>...> fmt, Args&&... args);
+
+/******************************************** CONSTEXPR FUNCTIONS ********************************************/
+
+/* Check if the compiler is evaluating a constant expression, where the run time only paths (SIMD, counters) can't run */
+constexpr bool String::constant_evaluated() noexcept
+{
+#if STRING_HAS_CONSTEXPR
+	return std::is_constant_evaluated();
+#else
+	return false;
+#endif
+}
+
+/* Allocate room for (n) characters and the terminator. In constant expressions every character gets constructed,
+so it can be assigned to later. (moved) is the number of characters of the old buffer, that the caller moves to the new one */
+STRING_CONSTEXPR char* String::allocate(size_t n, [[maybe_unused]] size_t moved)
+{
+	if (constant_evaluated()) {
+		char* p = alloc.allocate(n + 1);
+		for (size_t i = 0; i <= n; i++)
+			construct(p + i, '\0');
+		return p;
+	}
+	STRING_RECORD(record_allocation(n + 1, moved));
+	STRING_TRACE(record_allocation(n + 1));
+	return alloc.allocate(n + 1);
+}
+
+/* Free the memory of (n) characters and the terminator */
+STRING_CONSTEXPR void String::deallocate(char* p, size_t n)
+{
+	if (!constant_evaluated())
+		STRING_RECORD(record_deallocation(n + 1));
+	alloc.deallocate(p, n + 1);
+}
+
+/* Check if the pointer points into this String's memory. Unrelated pointers can't be ordered in constant expressions,
+so there they are compared one by one */
+STRING_CONSTEXPR bool String::aliases(const char* ptr) const noexcept
+{
+	if (!cp)
+		return false;
+	if (constant_evaluated()) {
+		for (size_t i = 0; i <= cap; i++) {
+			if (cp + i == ptr)
+				return true;
+		}
+		return false;
+	}
+	return std::less_equal<const char*>()(cp, ptr) && std::less_equal<const char*>()(ptr, cp + cap);
+}
+
+/* Return index of the first copy of the pattern that starts at (pos) or later, or npos if there isn't any.
+It's search() at run time, and a simple scan in constant expressions */
+STRING_CONSTEXPR size_t String::first_match(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos)
+{
+	if (!constant_evaluated())
+		return search(text, textLen, pat, patLen, pos);
+	if (pos > textLen || patLen > textLen - pos)
+		return npos;
+	for (size_t i = pos; i + patLen <= textLen; i++) {
+		if (char_traits::compare(text + i, pat, patLen) == 0)
+			return i;
+	}
+	return npos;
+}
+
+/* Compare two texts byte by byte as unsigned characters, return 1, -1 or 0 */
+STRING_CONSTEXPR int String::compare_texts(const char* lhs, size_t lhsLen, const char* rhs, size_t rhsLen)
+{
+	size_t common = (lhsLen < rhsLen) ? lhsLen : rhsLen;
+	int result = common ? char_traits::compare(lhs, rhs, common) : 0;
+	if (result != 0)
+		return (result > 0) ? 1 : -1;
+	if (lhsLen > rhsLen)
+		return 1;
+	if (lhsLen < rhsLen)
+		return -1;
+	return 0;
+}
+
+/* Return index of the last copy of the pattern that starts at (pos) or before, or npos if there isn't any */
+STRING_CONSTEXPR size_t String::last_match(const char* text, size_t textLen, const char* pat, size_t patLen, size_t pos)
+{
+	if (patLen > textLen)
+		return String::npos;
+	size_t i = textLen - patLen;
+	if (pos < i)
+		i = pos;
+	if (patLen == 0)
+		return i;
+	for (;; i--) {
+		if (*(text + i) == *pat && char_traits::compare(text + i, pat, patLen) == 0)
+			return i;
+		if (i == 0)
+			return String::npos;
+	}
+}
+
+/* Return index of the first character at (pos) or later, that is (or isn't, if member is false) in the set */
+STRING_CONSTEXPR size_t String::first_of(const char* text, size_t textLen, const char* set, size_t setLen, size_t pos, bool member)
+{
+	for (size_t i = pos; i < textLen; i++) {
+		if ((setLen != 0 && char_traits::find(set, setLen, *(text + i))) == member)
+			return i;
+	}
+	return String::npos;
+}
+
+/* Return index of the last character at (pos) or before, that is (or isn't, if member is false) in the set */
+STRING_CONSTEXPR size_t String::last_of(const char* text, size_t textLen, const char* set, size_t setLen, size_t pos, bool member)
+{
+	if (textLen == 0)
+		return String::npos;
+	for (size_t i = (pos < textLen) ? pos + 1 : textLen; i-- > 0;) {
+		if ((setLen != 0 && char_traits::find(set, setLen, *(text + i))) == member)
+			return i;
+	}
+	return String::npos;
+}
+
+/* Destruct elements, free memory */
+STRING_CONSTEXPR void String::free()
+{
+	if (cp && cap.adopted()) {
+		cap.set_adopted(false);
+		take_deleter(cp)(cp, cap);
+	}
+	else if (cp) {
+		for (int i = sz - 1; i >= 0; i--)
+			destroy(cp + i);
+		deallocate(cp, cap);
+	}
+	cp = nullptr;
+	sz = cap = 0;
+}
+
+/* Remove the text, keeping the buffer for the next one. A buffer above the high-water mark, that's more than
+shrinkRatio times the cleared text, is freed instead (see set_memory_policy()) */
+STRING_CONSTEXPR void String::clear()
+{
+	const size_t used = sz;
+	sz = 0;
+	terminate();
+	if (!constant_evaluated() && oversized(used))
+		free();
+}
+
+/* Copy text from const char* */
+STRING_CONSTEXPR String::String(const char* ptr) : sz(char_traits::length(ptr)), cap(sz)
+{
+	cp = allocate(sz);
+	char_traits::copy(cp, ptr, sz);
+	terminate();
+}
+
+/* Copy (len) characters from const char* */
+STRING_CONSTEXPR String::String(const char* ptr, size_t len) : sz((len < char_traits::length(ptr)) ? len : char_traits::length(ptr)), cap(sz)
+{
+	cp = allocate(sz);
+	char_traits::copy(cp, ptr, sz);
+	terminate();
+}
+
+/* Copy character (len) times */
+STRING_CONSTEXPR String::String(size_t len, char ch) : sz(len), cap(sz)
+{
+	cp = allocate(sz);
+	for (size_t i = 0; i < len; i++)
+		construct(cp + i, ch);
+	terminate();
+}
+
+/* Copy text from initializer_list */
+STRING_CONSTEXPR String::String(std::initializer_list<char> ls) : sz(ls.size()), cap(sz)
+{
+	cp = allocate(sz);
+	auto beg = ls.begin();
+	for (size_t i = 0; i < sz; i++)
+		construct(cp + i, *beg++);
+	terminate();
+}
+
+/* Copy the other String */
+STRING_CONSTEXPR String::String(const String& str) : sz(str.sz), cap(sz)
+{
+	cp = allocate(sz);
+	if (!constant_evaluated())
+		STRING_RECORD(record_copy(sz));
+	char_traits::copy(cp, str.cp, sz);
+	terminate();
+}
+
+/* Copy (len) characters from String, starting from (pos) character */
+STRING_CONSTEXPR String::String(const String& str, size_t pos, size_t len)
+{
+	if (pos > str.sz)
+		throw std::out_of_range("Position out of range!");
+	sz = (len > str.sz - pos) ? str.sz - pos : len;
+	cp = allocate(sz);
+	if (!constant_evaluated())
+		STRING_RECORD(record_copy(sz));
+	cap = sz;
+	for (size_t i = 0; i < sz; i++)
+		construct(cp + i, *(str.cp + pos + i)); // Copie (sz) characters, starting from pos
+	terminate();
+}
+
+/* Move the text from one String to the other */
+STRING_CONSTEXPR String::String(String&& str) noexcept : sz(str.sz), cp(str.cp), cap(str.cap)
+{
+	cap.set_adopted(str.cap.adopted());
+	str.cp = nullptr;
+	str.sz = str.cap = 0;
+	str.cap.set_adopted(false);
+}
+
+/* Assign one String, to the other */
+STRING_CONSTEXPR String& String::operator=(const String& str)
+{
+	if (&str == this)
+		return *this;
+	if (cap >= str.cap) {
+		if (cp) {
+			for (int i = sz; i >= 0; i--)
+				destroy(cp + i);
+		}
+	}
+	else {
+		free();
+		cp = allocate(str.cap);
+		cap = str.cap;
+	}
+	if (!constant_evaluated())
+		STRING_RECORD(record_copy(str.sz));
+	char_traits::copy(cp, str.cp, str.sz);
+	sz = str.sz;
+	terminate();
+	return *this;
+}
+
+/* Assign text from const char* to this String */
+STRING_CONSTEXPR String& String::operator=(const char* ptr)
+{
+	if (aliases(ptr))
+		return *this = String(ptr);
+	if (cap >= char_traits::length(ptr)) {
+		if (cp) {
+			for (int i = sz - 1; i >= 0; i--)
+				destroy(cp + i);
+		}
+		sz = char_traits::length(ptr);
+	}
+	else {
+		free();
+		sz = cap = char_traits::length(ptr);
+		cp = allocate(cap);
+	}
+	char_traits::copy(cp, ptr, sz);
+	terminate();
+	return *this;
+}
+
+/* Assign and move one String to the other */
+STRING_CONSTEXPR String& String::operator=(String&& str) noexcept
+{
+	if (this != &str) {
+		free();
+		sz = str.sz;
+		cp = str.cp;
+		cap = str.cap;
+		cap.set_adopted(str.cap.adopted());
+		str.cp = nullptr;
+		str.sz = str.cap = 0;
+		str.cap.set_adopted(false);
+	}
+	return *this;
+}
+
+/* Increase String's capacity to the given size, can't change the size and contents of the String */
+STRING_CONSTEXPR void String::reserve(size_t n)
+{
+	if (n > sz) {
+		if (n > cap) {
+			auto newCp = allocate(n, sz);
+			size_t tempSz = sz;
+			if (sz)
+				std::char_traits<char>::copy(newCp, cp, sz);
+			free();
+			cap = n;
+			sz = tempSz;
+			cp = newCp;
+		}
+	}
+	terminate();
+}
+
+/* Return reference to the character at the given position */
+STRING_CONSTEXPR char& String::operator[](size_t pos)
+{
+	if (pos >= sz)
+		throw std::out_of_range("Index is out of the range!");
+	return *(cp + pos);
+}
+
+/* Return reference to const character at the given position */
+STRING_CONSTEXPR const char& String::operator[](size_t pos) const
+{
+	if (pos >= sz)
+		throw std::out_of_range("Index is out of the range!");
+	return *(cp + pos);
+}
+
+/* Return reference to the character at the given position */
+STRING_CONSTEXPR char& String::at(size_t pos)
+{
+	if (pos >= sz)
+		throw std::out_of_range("Index is out of the range!");
+	return *(cp + pos);
+}
+
+/* Return reference to the const character at the given position */
+STRING_CONSTEXPR const char& String::at(size_t pos) const
+{
+	if (pos >= sz)
+		throw std::out_of_range("Index is out of the range!");
+	return *(cp + pos);
+}
+
+/* Return reference to the last character of String, if String is empty, throw runtime_error */
+STRING_CONSTEXPR char& String::back()
+{
+	if (empty())
+		throw std::runtime_error("back() used on empty String!");
+	return *(cp + sz - 1);   //last character is at the index sz - 1
+}
+
+/* Return reference to the last, const character of String, if String is empty, throw runtime_error */
+STRING_CONSTEXPR const char& String::back() const
+{
+	if (empty())
+		throw std::runtime_error("back() used on empty String!");
+	return *(cp + sz - 1);
+}
+
+/* Return reference to the first character of String, if String is empty, throw runtime_error */
+STRING_CONSTEXPR char& String::front()
+{
+	if (empty())
+		throw std::runtime_error("back() used on empty String!");
+	return *cp;
+}
+
+/* Return reference to the first, const character of String, if String is empty, throw runtime_error */
+STRING_CONSTEXPR const char& String::front() const
+{
+	if (empty())
+		throw std::runtime_error("back() used on empty String!");
+	return *cp;
+}
+
+/* Append copy of the second String to the first */
+STRING_CONSTEXPR String& String::append(const String& str)
+{
+	if (&str == this)
+		return append(String(str));
+	return append_text(str.cp, str.sz);
+}
+
+/* Append copy of some characters of the second String, starting at the given postion,
+if length isn't given, copies the entire String starting at the given position */
+STRING_CONSTEXPR String& String::append(const String& str, size_t subpos, size_t sublen)
+{
+	if (&str == this)
+		return append(String(str), subpos, sublen);
+	if (subpos > str.sz)
+		throw std::out_of_range("Position out of the range!");
+
+	//Calculate sublen, if it is higher than size (str.sz) at position (subpos)
+	if ((str.sz - subpos) < sublen)
+		sublen = str.sz - subpos;
+	return append_text(str.cp + subpos, sublen);
+}
+
+/* Append const char* to String */
+STRING_CONSTEXPR String& String::append(const char* ptr)
+{
+	if (aliases(ptr))
+		return append(String(ptr));
+	return append_text(ptr, char_traits::length(ptr));
+}
+
+/* Append given number of characters from const char* to String, stopping at its terminator */
+STRING_CONSTEXPR String& String::append(const char* ptr, size_t n)
+{
+	if (aliases(ptr))
+		return append(String(ptr, n));
+	if (const char* end = char_traits::find(ptr, n, '\0'))
+		n = end - ptr;
+	return append_text(ptr, n);
+}
+
+/* Append given number of copies of the character to String */
+STRING_CONSTEXPR String& String::append(size_t n, char ch)
+{
+	size_t newSize = sz + n;
+	if (cap >= newSize) {
+		char_traits::assign(cp + sz, n, ch);
+	}
+	else {
+		auto newCp = allocate(newSize, sz);
+		char_traits::copy(newCp, cp, sz);
+		char_traits::assign(newCp + sz, n, ch);
+		free();
+		cp = newCp;
+		cap = newSize;
+	}
+	sz = newSize;
+	terminate();
+	return *this;
+}
+
+/* Append copy of initializer_list to String */
+STRING_CONSTEXPR String& String::append(std::initializer_list<char> ls)
+{
+	return append_text(ls.begin(), ls.size());
+}
+
+/* Append (n) characters, that aren't a part of this String, copying them at once. A new buffer has exactly the needed size */
+STRING_CONSTEXPR String& String::append_text(const char* ptr, size_t n)
+{
+	size_t newSize = sz + n;
+	if (cap >= newSize) {
+		char_traits::copy(cp + sz, ptr, n);
+	}
+	else {
+		auto newCp = allocate(newSize, sz);
+		char_traits::copy(newCp, cp, sz);
+		char_traits::copy(newCp + sz, ptr, n);
+		free();
+		cp = newCp;
+		cap = newSize;
+	}
+	sz = newSize;
+	terminate();
+	return *this;
+}
+
+/* Append given String to this one */
+STRING_CONSTEXPR String& String::operator+=(const String& str)
+{
+	return append(str);
+}
+
+/* Append given const char* to this String */
+STRING_CONSTEXPR String& String::operator+=(const char* ptr)
+{
+	return append(ptr);
+}
+
+/* Append given character to this String */
+STRING_CONSTEXPR String& String::operator+=(char c)
+{
+	return append(1, c);
+}
+
+/* Append given list of characters to this String */
+STRING_CONSTEXPR String& String::operator+=(std::initializer_list<char> ls)
+{
+	return append(ls);
+}
+
+/* Push back character, can reallocate memory if needed */
+STRING_CONSTEXPR void String::push_back(char ch)
+{
+	if (sz < cap) {
+		construct(cp + sz, ch);
+		sz++;
+	}
+	else {
+		size_t newSize = sz + 1;
+		auto newCp = allocate(newSize, sz);
+		for (size_t i = 0; i < sz; i++)
+			construct(newCp + i, std::move(*(cp + i)));
+		free();
+		construct(newCp + newSize - 1, ch);
+		cp = newCp;
+		sz = cap = newSize;
+	}
+	terminate();
+}
+
+/* Find given text in this String, starting at the given position */
+STRING_CONSTEXPR size_t String::find(const String& str, size_t pos) const noexcept
+{
+	return first_match(cp, sz, str.cp, str.sz, pos);
+}
+
+/* Find given text, in this String, starting at the given position */
+STRING_CONSTEXPR size_t String::find(const char* cptr, size_t pos) const
+{
+	if (!cptr)
+		return npos;
+	return first_match(cp, sz, cptr, char_traits::length(cptr), pos);
+}
+
+/* Find certain amount of characters of the given text, in this String, starting at the given position */
+STRING_CONSTEXPR size_t String::find(const char* cptr, size_t pos, size_t n) const
+{
+	if (!cptr)
+		return npos;
+	if (n > char_traits::length(cptr))
+		n = char_traits::length(cptr);
+	return first_match(cp, sz, cptr, n, pos);
+}
+
+/* Find given character, in this String, starting at the given position */
+STRING_CONSTEXPR size_t String::find(char c, size_t pos) const noexcept
+{
+	if (pos >= sz)
+		return npos;
+	const char* found = char_traits::find(cp + pos, sz - pos, c);
+	return found ? found - cp : npos;
+}
+
+/* Find the last copy of the given String, in this String, starting at the given position and going back */
+STRING_CONSTEXPR size_t String::rfind(const String& str, size_t pos) const noexcept
+{
+	return last_match(cp, sz, str.cp, str.sz, pos);
+}
+
+/* Find the last copy of the given text, in this String, starting at the given position and going back */
+STRING_CONSTEXPR size_t String::rfind(const char* cptr, size_t pos) const
+{
+	if (!cptr)
+		return npos;
+	return last_match(cp, sz, cptr, char_traits::length(cptr), pos);
+}
+
+/* Find the last copy of the given text, in this String, starting at the given position and going back */
+STRING_CONSTEXPR size_t String::rfind(const char* cptr, size_t pos, size_t n) const
+{
+	if (!cptr)
+		return npos;
+	if (n > char_traits::length(cptr))
+		n = char_traits::length(cptr);
+	return last_match(cp, sz, cptr, n, pos);
+}
+
+/* Find the copy of the character, in this String, starting at the given position and going back */
+STRING_CONSTEXPR size_t String::rfind(char c, size_t pos) const noexcept
+{
+	return last_of(cp, sz, &c, 1, pos, true);
+}
+
+/* Find the first character that matches one of the characters in the String, 
+starting at the given position, return its index */
+STRING_CONSTEXPR size_t String::find_first_of(const String& str, size_t pos) const noexcept
+{
+	return first_of(cp, sz, str.cp, str.sz, pos, true);
+}
+
+/* Find the first character that matches one of the characters of the text, 
+starting at the given position, return its index */
+STRING_CONSTEXPR size_t String::find_first_of(const char* cptr, size_t pos) const
+{
+	return first_of(cp, sz, cptr, char_traits::length(cptr), pos, true);
+}
+
+/* Find the first character that matches one of the given amount of characters from the text,
+starting at the given position, returns its index */
+STRING_CONSTEXPR size_t String::find_first_of(const char* cptr, size_t pos, size_t n) const
+{
+	if (n > char_traits::length(cptr))
+		n = char_traits::length(cptr);
+	return first_of(cp, sz, cptr, n, pos, true);
+}
+
+/* Find the first character that matches the given character
+starting at the given position, return its index */
+STRING_CONSTEXPR size_t String::find_first_of(char ch, size_t pos) const noexcept
+{
+	return find(ch, pos);
+}
+
+/* Find the last character that matches one of the characters in the String, 
+starting at the given position and going back, return its index */
+STRING_CONSTEXPR size_t String::find_last_of(const String& str, size_t pos) const noexcept
+{
+	return last_of(cp, sz, str.cp, str.sz, pos, true);
+}
+
+/* Find the last character that matches one of the characters of the text,
+starting at the given position and going back, return its index */
+STRING_CONSTEXPR size_t String::find_last_of(const char* cptr, size_t pos) const
+{
+	return last_of(cp, sz, cptr, char_traits::length(cptr), pos, true);
+}
+
+/* Find the last character that matches one of the given amount of characters from the text,
+starting at the given position and going back, return its index */
+STRING_CONSTEXPR size_t String::find_last_of(const char* cptr, size_t pos, size_t n) const
+{
+	if (n > char_traits::length(cptr))
+		n = char_traits::length(cptr);
+	return last_of(cp, sz, cptr, n, pos, true);
+}
+
+/* Find the last character that matches the given character
+starting at the given position and going back, return its index */
+STRING_CONSTEXPR size_t String::find_last_of(char ch, size_t pos) const noexcept
+{
+	return rfind(ch, pos);
+}
+
+/* Find the first character that isn't in the given String, starting at the given position, return its index */
+STRING_CONSTEXPR size_t String::find_first_not_of(const String& str, size_t pos) const noexcept
+{
+	return first_of(cp, sz, str.cp, str.sz, pos, false);
+}
+
+/* Find the first character that isn't in the given text, starting at the given position, return its index */
+STRING_CONSTEXPR size_t String::find_first_not_of(const char* cptr, size_t pos) const
+{
+	return first_of(cp, sz, cptr, char_traits::length(cptr), pos, false);
+}
+
+/* Find the first character that isn't in the given amount of characters from the given text,
+starting at the given position, returns it index */
+STRING_CONSTEXPR size_t String::find_first_not_of(const char* cptr, size_t pos, size_t n) const
+{
+	if (n > char_traits::length(cptr))
+		n = char_traits::length(cptr);
+	return first_of(cp, sz, cptr, n, pos, false);
+}
+
+/* Find the first character that isn't the given character, return its index */
+STRING_CONSTEXPR size_t String::find_first_not_of(char ch, size_t pos) const noexcept
+{
+	return first_of(cp, sz, &ch, 1, pos, false);
+}
+
+/* Find the last character that isn't in the given String, starting at the given position and going back,
+return its index */
+STRING_CONSTEXPR size_t String::find_last_not_of(const String& str, size_t pos) const noexcept
+{
+	return last_of(cp, sz, str.cp, str.sz, pos, false);
+}
+
+/* Find the last character that isn't in the given text, starting at the given position and going back,
+return its index */
+STRING_CONSTEXPR size_t String::find_last_not_of(const char* cptr, size_t pos) const
+{
+	return last_of(cp, sz, cptr, char_traits::length(cptr), pos, false);
+}
+
+/* Find the last character that isn't in the given amount of characters from the given text,
+starting at the given position and going back, return its index */
+STRING_CONSTEXPR size_t String::find_last_not_of(const char* cptr, size_t pos, size_t n) const
+{
+	if (n > char_traits::length(cptr))
+		n = char_traits::length(cptr);
+	return last_of(cp, sz, cptr, n, pos, false);
+}
+
+/* Find the last character that isn't the same as the given character, return its index */
+STRING_CONSTEXPR size_t String::find_last_not_of(char ch, size_t pos) const noexcept
+{
+	return last_of(cp, sz, &ch, 1, pos, false);
+}
+
+/* Return a copy of the given amount of characters of this String, starting at the given position */
+STRING_CONSTEXPR String String::substr(size_t pos, size_t len) const
+{
+	if (pos == sz)
+		return String();
+	else if (pos > sz)
+		throw std::out_of_range("Position out of range!");
+	if (len > sz - pos)
+		len = sz - pos;
+	String result;
+	result.reserve(len);
+	for (size_t i = 0; i < len; i++)
+		result += *(cp + i + pos);
+	return result;
+}
+
+/* Compare one String to the other, 
+ return:
+	1 if this String is greater than the given one
+	-1 if this String is lower than the given one
+	0 if two Strings are equal */
+STRING_CONSTEXPR int String::compare(const String& str) const noexcept
+{
+	return compare_texts(cp, sz, str.cp, str.sz);
+}
+
+/* Compares one given amount of characters of this String 
+ starting at the specified position, to the other one, 
+ return:
+	1 if this String is greater than the second one
+	-1 if this String is lower than the second one
+	0 if two Strings are equal */
+STRING_CONSTEXPR int String::compare(size_t pos, size_t len, const String & str) const
+{
+	if (pos > sz)
+		throw std::out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+
+	return compare_texts(cp + pos, len, str.cp, str.sz);
+}
+
+/* Compares one given amount of characters of this String 
+ starting at the specified position to the given amount characters of the other String, 
+ starting at the specified position, if second length isn't given, it is as long as the string, 
+ return:
+	1 if this String is greater than the second one
+	-1 if this String is lower than the second one
+	0 if two Strings are equal */
+STRING_CONSTEXPR int String::compare(size_t pos, size_t len, const String& str, size_t subpos, size_t sublen) const
+{
+	if (pos > sz || subpos > str.sz)
+		throw std::out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+	if (sublen > (str.sz - subpos))
+		sublen = str.sz - subpos;
+
+	return compare_texts(cp + pos, len, str.cp + subpos, sublen);
+}
+
+/* Compare this String to the const char*, 
+ return:
+	1 if this String is greater than const char*
+	-1 if this String is lower than const char*
+	0 if this String and const char* are equal */
+STRING_CONSTEXPR int String::compare(const char* cptr) const
+{
+	size_t sizeCptr = char_traits::length(cptr);
+	return compare_texts(cp, sz, cptr, sizeCptr);
+}
+
+/* Compare this given amount of characters of the String, 
+ starting at the position specified position, to the const char*, 
+ return:
+	1 if this String is greater than const char*
+	-1 if this String is lower than const char*
+	0 if this String and const char* are equal */
+STRING_CONSTEXPR int String::compare(size_t pos, size_t len, const char* cptr) const
+{
+	if (pos > sz)
+		throw std::out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+
+	size_t sizeCptr = char_traits::length(cptr);
+	return compare_texts(cp + pos, len, cptr, sizeCptr);
+}
+
+/* Compares this given amount of characters of the String, 
+ starting at the specified position, to the given amount of characters of const char*, 
+ return:
+	1 if this String is greater than const char*
+	-1 if this String is lower than const char*
+	0 if this String and const char* are equal */
+STRING_CONSTEXPR int String::compare(size_t pos, size_t len, const char* cptr, size_t n) const
+{
+	if (pos > sz)
+		throw std::out_of_range("Position out of range!");
+	if (len > (sz - pos))
+		len = sz - pos;
+	size_t sizeCptr = char_traits::length(cptr);
+	if (n > sizeCptr)
+		n = sizeCptr;
+
+	return compare_texts(cp + pos, len, cptr, n);
+}
+
+/* Return String local copy by appending one String to the other */
+STRING_CONSTEXPR String operator+(const String& lhs, const String& rhs)
+{
+	String result;
+	result.sz = result.cap = lhs.sz + rhs.sz;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, *(lhs.cp + i));
+	for (size_t j = 0; j < rhs.sz; j++)
+		String::construct(result.cp + i++, *(rhs.cp + j));
+	result.terminate();
+	return result;
+}
+
+/* Return local copy of the String built by appending one String to other the rvalue String */
+STRING_CONSTEXPR String operator+(const String& lhs, String&& rhs)
+{
+	String result;
+	result.sz = result.cap = lhs.sz + rhs.sz;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, *(lhs.cp + i));
+	for (size_t j = 0; j < rhs.sz; j++)
+		String::construct(result.cp + i++, std::move(*(rhs.cp + j)));
+	result.terminate();
+	return result;
+}
+
+/* Return a local copy of the rvalue String appended with lvalue String */
+STRING_CONSTEXPR String operator+(String&& lhs, const String& rhs)
+{
+	String result;
+	result.sz = result.cap = lhs.sz + rhs.sz;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, std::move(*(lhs.cp + i)));
+	for (size_t j = 0; j < rhs.sz; j++)
+		String::construct(result.cp + i++, *(rhs.cp + j));
+	result.terminate();
+	return result;
+}
+
+/* Return local copy of the rvalue String appended with another rvalue String */
+STRING_CONSTEXPR String operator+(String&& lhs, String&& rhs)
+{
+	String result;
+	result.sz = result.cap = lhs.sz + rhs.sz;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, std::move(*(lhs.cp + i)));
+	for (size_t j = 0; j < rhs.sz; j++)
+		String::construct(result.cp + i++, std::move(*(rhs.cp + j)));
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the String constructed by appending String and const char* */
+STRING_CONSTEXPR String operator+(const String& lhs, const char* rhs)
+{
+	String result;
+	size_t ptrSize = String::char_traits::length(rhs);
+	result.sz = result.cap = lhs.sz + ptrSize;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, *(lhs.cp + i));
+	for (size_t j = 0; j < ptrSize; j++)
+		String::construct(result.cp + i++, *(rhs + j));
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the rvalue String appended with const char* */
+STRING_CONSTEXPR String operator+(String&& lhs, const char* rhs)
+{
+	String result;
+	size_t ptrSize = String::char_traits::length(rhs);
+	result.sz = result.cap = lhs.sz + ptrSize;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, std::move(*(lhs.cp + i)));
+	for (size_t j = 0; j < ptrSize; j++)
+		String::construct(result.cp + i++, *(rhs + j));
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the String created by appending const char* to String */
+STRING_CONSTEXPR String operator+(const char* lhs, const String& rhs)
+{
+	String result;
+	size_t ptrSize = String::char_traits::length(lhs);
+	result.sz = result.cap = ptrSize + rhs.sz;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < ptrSize; i++)
+		String::construct(result.cp + i, *(lhs + i));
+	for (size_t j = 0; j < rhs.sz; j++)
+		String::construct(result.cp + i++, *(rhs.cp + j));
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the String created by appending const char* to rvalue String */
+STRING_CONSTEXPR String operator+(const char* lhs, String&& rhs)
+{
+	String result;
+	size_t ptrSize = String::char_traits::length(lhs);
+	result.sz = result.cap = ptrSize + rhs.sz;
+	result.cp = result.allocate(result.sz);
+	size_t i;
+	for (i = 0; i < ptrSize; i++)
+		String::construct(result.cp + i, *(lhs + i));
+	for (size_t j = 0; j < rhs.sz; j++)
+		String::construct(result.cp + i++, std::move(*(rhs.cp + j)));
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the String, that is created by appending String and char */
+STRING_CONSTEXPR String operator+(const String& lhs, char rhs)
+{
+	String result;
+	result.sz = result.cap = lhs.sz + 1;
+	result.cp = result.allocate(result.sz);
+	for (size_t i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, *(lhs.cp + i));
+	String::construct(result.cp + lhs.sz, rhs);
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the String, created by appending rvalue String with a char */
+STRING_CONSTEXPR String operator+(String&& lhs, char rhs)
+{
+	String result;
+	result.sz = result.cap = lhs.sz + 1;
+	result.cp = result.allocate(result.sz);
+	for (size_t i = 0; i < lhs.sz; i++)
+		String::construct(result.cp + i, std::move(*(lhs.cp + i)));
+	String::construct(result.cp + lhs.sz, rhs);
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the String, created by appending char with a String */
+STRING_CONSTEXPR String operator+(char lhs, const String& rhs) 
+{
+	String result;
+	result.sz = result.cap = rhs.sz + 1;
+	result.cp = result.allocate(result.sz);
+	String::construct(result.cp, lhs);
+	size_t size = 1;
+	for (size_t i = 0; i < rhs.sz; i++)
+		String::construct(result.cp + size++, *(rhs.cp + i));
+	result.terminate();
+	return result;
+}
+
+/* Return copy of the String, created by appending char with a rvalue String */
+STRING_CONSTEXPR String operator+(char lhs, String&& rhs)
+{
+	String result;
+	result.sz = result.cap = rhs.sz + 1;
+	result.cp = result.allocate(result.sz);
+	String::construct(result.cp, lhs);
+	size_t size = 1;
+	for (size_t i = 0; i < rhs.sz; i++)
+		String::construct(result.cp + size++, std::move(*(rhs.cp + i)));
+	result.terminate();
+	return result;
+}
+
+/* Check if one String is the same as the other one */
+STRING_CONSTEXPR bool operator==(const String& lhs, const String& rhs) noexcept
+{
+	return (lhs.compare(rhs) == 0);
+}
+
+/* Check if const char* is the same as the String */
+STRING_CONSTEXPR bool operator==(const char* lhs, const String& rhs)
+{
+	return (rhs.compare(lhs) == 0);
+}
+
+/* Check if String is the same as the const char* */
+STRING_CONSTEXPR bool operator==(const String& lhs, const char* rhs)
+{
+	return (lhs.compare(rhs) == 0);
+}
+
+/* Check if one String isn't the same as the other one */
+STRING_CONSTEXPR bool operator!=(const String& lhs, const String& rhs) noexcept
+{
+	return !(lhs == rhs);
+}
+
+/* Check if const char* isn't the same as the String */
+STRING_CONSTEXPR bool operator!=(const char* lhs, const String& rhs)
+{
+	return !(lhs == rhs);
+}
+
+/* Check if the String isn't the same as the const char* */
+STRING_CONSTEXPR bool operator!=(const String& lhs, const char* rhs)
+{
+	return !(lhs == rhs);
+}
+
+/* Check if the first String is lesser than the other one */
+STRING_CONSTEXPR bool operator<(const String& lhs, const String& rhs) noexcept
+{
+	return (lhs.compare(rhs) < 0);
+}
+
+/* Check if the const char* is lesser than the String */
+STRING_CONSTEXPR bool operator<(const char* lhs, const String& rhs)
+{
+	return (rhs.compare(lhs) > 0);
+}
+
+/* Check if the String is lesser than the const char* */
+STRING_CONSTEXPR bool operator<(const String& lhs, const char* rhs)
+{
+	return (lhs.compare(rhs) < 0);
+}
+
+/* Check if the first String is lesser than or equal to the second String */
+STRING_CONSTEXPR bool operator<=(const String& lhs, const String& rhs) noexcept
+{
+	return (lhs < rhs) || (lhs == rhs);
+}
+
+/* Check if the const char* is lesser than or equal to the String */
+STRING_CONSTEXPR bool operator<=(const char* lhs, const String& rhs)
+{
+	return (lhs < rhs) || (lhs == rhs);
+}
+
+/* Check if the String is lesser than or equal to the const char* */
+STRING_CONSTEXPR bool operator<=(const String& lhs, const char* rhs)
+{
+	return (lhs < rhs) || (lhs == rhs);
+}
+
+/* Check if the first String is greater than the other one */
+STRING_CONSTEXPR bool operator>(const String& lhs, const String& rhs) noexcept
+{
+	return !(lhs < rhs) && (lhs != rhs);
+}
+
+/* Check if the const char* is greater than the String */
+STRING_CONSTEXPR bool operator>(const char* lhs, const String& rhs)
+{
+	return !(lhs < rhs) && (lhs != rhs);
+}
+
+/* Check if the String is greater than the const char* */
+STRING_CONSTEXPR bool operator>(const String& lhs, const char* rhs)
+{
+	return !(lhs < rhs) && (lhs != rhs);
+}
+
+/* Check if the first String is greater than or equal to the second String */
+STRING_CONSTEXPR bool operator>=(const String& lhs, const String& rhs) noexcept
+{
+	return (lhs > rhs) || (lhs == rhs);
+}
+
+/* Check if the const char* is greater than or equal to the String */
+STRING_CONSTEXPR bool operator>=(const char* lhs, const String& rhs)
+{
+	return (lhs > rhs) || (lhs == rhs);
+}
+
+/* Check if the String is greater than or equal to the const char* */
+STRING_CONSTEXPR bool operator>=(const String& lhs, const char* rhs)
+{
+	return (lhs > rhs) || (lhs == rhs);
+}
+
+/******************************************** ITERATOR FUNCTIONS ********************************************/
+
+/* Dereference the pointer */
+template<bool constness>
+typename String::Iterator<constness>::reference String::Iterator<constness>::operator*() const
+{
+	return *m_cp;
+}
+
+/* Return the pointer, std::to_address() uses it */
+template<bool constness>
+typename String::Iterator<constness>::pointer String::Iterator<constness>::operator->() const
+{
+	return m_cp;
+}
+
+/* Iterate one place forward */
+template<bool constness>
+String::Iterator<constness>& String::Iterator<constness>::operator++()
+{
+	++m_cp;
+	return *this;
+}
+
+/* Iterate one place forward, return the old pointer */
+template<bool constness>
+String::Iterator<constness> String::Iterator<constness>::operator++(int)
+{
+	Iterator result(*this);
+	++m_cp;
+	return result;
+}
+
+/* Iterate one place backward */
+template<bool constness>
+String::Iterator<constness>& String::Iterator<constness>::operator--()
+{
+	--m_cp;
+	return *this;
+}
+
+/* Iterate one place backward, return the old pointer */
+template<bool constness>
+String::Iterator<constness> String::Iterator<constness>::operator--(int)
+{
+	Iterator result(*this);
+	--m_cp;
+	return result;
+}
+
+/* Return the dereferenced character at the given index */
+template<bool constness>
+typename String::Iterator<constness>::reference String::Iterator<constness>::operator[](difference_type index) const
+{
+	return *(m_cp + index);
+}
+
+/* Return the iterator, that's incremented (n) times */
+template<bool constness>
+String::Iterator<constness> String::Iterator<constness>::operator+(difference_type n) const
+{
+	Iterator result(*this);
+	result.m_cp += n;
+	return result;
+}
+
+/* Return the iterator, that's decremented (n) times */
+template<bool constness>
+String::Iterator<constness> String::Iterator<constness>::operator-(difference_type n) const
+{
+	Iterator result(*this);
+	result.m_cp -= n;
+	return result;
+}
+
+/* Move this iterator forward (n) times */
+template<bool constness>
+String::Iterator<constness>& String::Iterator<constness>::operator+=(difference_type n)
+{
+	m_cp += n;
+	return *this;
+}
+
+/* Move this iterator backward (n) times */
+template<bool constness>
+String::Iterator<constness>& String::Iterator<constness>::operator-=(difference_type n)
+{
+	m_cp -= n;
+	return *this;
+}
+
+/* Return the distance from the second iterator to this one */
+template<bool constness> template<bool other>
+typename String::Iterator<constness>::difference_type String::Iterator<constness>::operator-(const Iterator<other>& rhs) const
+{
+	return m_cp - rhs.m_cp;
+}
+
+/* Check if the iterators are equal to each other */
+template<bool constness> template<bool other>
+bool String::Iterator<constness>::operator==(const Iterator<other>& rhs) const
+{
+	return m_cp == rhs.m_cp;
+}
+
+/* Check if the iterators aren't equal to each other */
+template<bool constness> template<bool other>
+bool String::Iterator<constness>::operator!=(const Iterator<other>& rhs) const
+{
+	return m_cp != rhs.m_cp;
+}
+
+/* Check if the first iterator is lesser than the second */
+template<bool constness> template<bool other>
+bool String::Iterator<constness>::operator<(const Iterator<other>& rhs) const
+{
+	return m_cp < rhs.m_cp;
+}
+
+/* Check if the first iterator is lesser than or equal to the second */
+template<bool constness> template<bool other>
+bool String::Iterator<constness>::operator<=(const Iterator<other>& rhs) const
+{
+	return m_cp <= rhs.m_cp;
+}
+
+/* Check if the first iterator is higher than the second */
+template<bool constness> template<bool other>
+bool String::Iterator<constness>::operator>(const Iterator<other>& rhs) const
+{
+	return m_cp > rhs.m_cp;
+}
+
+/* Check if the first iterator is higher than or equal to the second */
+template<bool constness> template<bool other>
+bool String::Iterator<constness>::operator>=(const Iterator<other>& rhs) const
+{
+	return m_cp >= rhs.m_cp;
+}
+
+
+/* Iterate this reverse iterator "forwards"*/
+template <bool constness>
+String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator++()
+{
+	--m_cp;
+	return *this;
+}
+
+/* Iterate this reverse iterator "forwards", return the old reverse iterator */
+template <bool constness>
+String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator++(int)
+{
+	Reverse_Iterator result(*this);
+	--m_cp;
+	return result;
+}
+
+/* Iterate this reverse iterator "backwards" */
+template <bool constness>
+String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator--()
+{
+	++m_cp;
+	return *this;
+}
+
+/* Iterate this reverse iterator "backwards", return the old reverse iterator */
+template <bool constness>
+String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator--(int)
+{
+	Reverse_Iterator result(*this);
+	++m_cp;
+	return result;
+}
+
+/* Move the reverse iterator "fowards" (n) times, return it */
+template<bool constness>
+String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator+(difference_type n) const
+{
+	Reverse_Iterator result(*this);
+	result.m_cp -= n;
+	return result;
+}
+
+/* Move the reverse iterator "backwards" (n) times, return it */
+template<bool constness>
+String::Reverse_Iterator<constness> String::Reverse_Iterator<constness>::operator-(difference_type n) const
+{
+	Reverse_Iterator result(*this);
+	result.m_cp += n;
+	return result;
+}
+
+/* Move this reverse iterator "fowards" (n) times, return it*/
+template<bool constness>
+String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator+=(difference_type n)
+{
+	m_cp -= n;
+	return *this;
+}
+
+/* Move this reverse iterator "backwards" (n) times, return it */
+template <bool constness>
+String::Reverse_Iterator<constness>& String::Reverse_Iterator<constness>::operator-=(difference_type n)
+{
+	m_cp += n;
+	return *this;
+}
+
+/* Return the distance from the second reverse iterator to this one, counted "forwards" */
+template<bool constness> template<bool other>
+typename String::Reverse_Iterator<constness>::difference_type
+String::Reverse_Iterator<constness>::operator-(const Reverse_Iterator<other>& rhs) const
+{
+	return rhs.m_cp - m_cp;
+}
+
+/* Dereference this reverse iterator */
+template<bool constness>
+typename String::Reverse_Iterator<constness>::reference String::Reverse_Iterator<constness>::operator*() const
+{
+	return *(m_cp - 1);
+}
+
+/* Return the pointer to the character this reverse iterator is at */
+template<bool constness>
+typename String::Reverse_Iterator<constness>::pointer String::Reverse_Iterator<constness>::operator->() const
+{
+	return m_cp - 1;
+}
+
+/* Return the dereferenced character at the given index, counted "forwards" */
+template<bool constness>
+typename String::Reverse_Iterator<constness>::reference
+String::Reverse_Iterator<constness>::operator[](difference_type index) const
+{
+	return *(m_cp - 1 - index);
+}
+
+/* Check if both reverse iterators are equal to each other */
+template <bool constness> template<bool other>
+bool String::Reverse_Iterator<constness>::operator==(const Reverse_Iterator<other>& rhs) const
+{
+	return (m_cp == rhs.m_cp);
+}
+
+/* Check if both reverse iterators aren't equal to each other */
+template <bool constness> template<bool other>
+bool String::Reverse_Iterator<constness>::operator!=(const Reverse_Iterator<other>& rhs) const
+{
+	return (m_cp != rhs.m_cp);
+}
+
+/* Check if this reverse iterator is lesser than the second, so it's closer to rbegin() */
+template <bool constness> template<bool other>
+bool String::Reverse_Iterator<constness>::operator<(const Reverse_Iterator<other>& rhs) const
+{
+	return rhs.m_cp < m_cp;
+}
+
+/* Check if this reverse iterator is lesser than or equal to the second */
+template <bool constness> template<bool other>
+bool String::Reverse_Iterator<constness>::operator<=(const Reverse_Iterator<other>& rhs) const
+{
+	return rhs.m_cp <= m_cp;
+}
+
+/* Check if this reverse iterator is higher than the second */
+template <bool constness> template<bool other>
+bool String::Reverse_Iterator<constness>::operator>(const Reverse_Iterator<other>& rhs) const
+{
+	return rhs.m_cp > m_cp;
+}
+
+/* Check if this reverse iterator is higher than or equal to the second */
+template <bool constness> template<bool other>
+bool String::Reverse_Iterator<constness>::operator>=(const Reverse_Iterator<other>& rhs) const
+{
+	return rhs.m_cp >= m_cp;
+}
+
+/************************************* STRING ITERATOR FUNCTIONS ****************************************/
+
+/* Return an iterator to the beginning of this String */
+inline String::iterator String::begin() noexcept
+{
+	return iterator(cp);
+}
+
+/* Return a const iterator to the beginning of this String */
+inline String::const_iterator String::begin() const noexcept
+{
+	return const_iterator(cp);
+}
+
+/* Return an iterator to the end of this String */
+inline String::iterator String::end() noexcept
+{
+	return iterator(cp + sz);
+}
+
+/* Return a const iterator to the end of this String */
+inline String::const_iterator String::end() const noexcept
+{
+	return const_iterator(cp + sz);
+}
+
+/* Return a reverse iterator to the reverse beginning of this String */
+inline String::reverse_iterator String::rbegin() noexcept
+{
+	return reverse_iterator(cp + sz);
+}
+
+/* Return a const reverse iterator to the reverse beginning of this String */
+inline String::const_reverse_iterator String::rbegin() const noexcept
+{
+	return const_reverse_iterator(cp + sz);
+}
+
+/* Return a reverse iterator to the reverse end of this String */
+inline String::reverse_iterator String::rend() noexcept
+{
+	return reverse_iterator(cp);
+}
+
+/* Return a const reverse iterator to the reverse end of this String */
+inline String::const_reverse_iterator String::rend() const noexcept
+{
+	return const_reverse_iterator(cp);
+}
+
+/* Return a const iterator to the beginning of this String */
+inline String::const_iterator String::cbegin() const noexcept
+{
+	return const_iterator(cp);
+}
+
+/* Return a const iterator to the end of this String */
+inline String::const_iterator String::cend() const noexcept
+{
+	return const_iterator(cp + sz);
+}
+
+/* Return a const reverse iterator to the reverse beginning of this String  */
+inline String::const_reverse_iterator String::crbegin() const noexcept
+{
+	return const_reverse_iterator(cp + sz);
+}
+
+/* Return a const reverse iterator to the reverse end of this String  */
+inline String::const_reverse_iterator String::crend() const noexcept
+{
+	return const_reverse_iterator(cp);
+}
+
+/* Check if the iterators point into a contiguous array of chars, so the range can be copied at once */
+template<typename It> constexpr bool String::contiguous_range() noexcept
+{
+	if constexpr (std::is_pointer_v<It>)
+		return std::is_same_v<std::remove_cv_t<std::remove_pointer_t<It>>, char>;
+	else if constexpr (std::is_same_v<It, iterator> || std::is_same_v<It, const_iterator>)
+		return true;
+#ifdef __cpp_lib_concepts
+	else if constexpr (std::contiguous_iterator<It>)
+		return std::is_same_v<std::iter_value_t<It>, char>;
+#endif
+	else
+		return false;
+}
+
+/* Return the address of the character the contiguous iterator points to, without reading it, so it works for end iterators */
+template<typename It> const char* String::range_data(It it) noexcept
+{
+	if constexpr (std::is_pointer_v<It>)
+		return it;
+	else if constexpr (std::is_same_v<It, iterator> || std::is_same_v<It, const_iterator>)
+		return it.m_cp;
+#ifdef __cpp_lib_concepts
+	else
+		return std::to_address(it);
+#endif
+}
+
+/* Return the length of the range, in one step when the iterators can be subtracted */
+template<typename It> auto String::range_length(It first, It last, int) -> decltype(size_t(last - first))
+{
+	return size_t(last - first);
+}
+
+/* Return the length of the range, counting its elements */
+template<typename It> size_t String::range_length(It first, It last, long)
+{
+	size_t n = 0;
+	for (; first != last; ++first)
+		n++;
+	return n;
+}
+
+/* Append the range: contiguous ones are copied at once, other multi-pass ones are measured once and copied,
+and single-pass ones are read once, growing the capacity geometrically */
+template<typename It> void String::append_range(It first, It last)
+{
+	using Category = typename std::iterator_traits<It>::iterator_category;
+	if constexpr (contiguous_range<It>()) {
+		append_chars(range_data(first), range_data(last) - range_data(first));
+	}
+	else if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+		const size_t newSize = sz + range_length(first, last, 0);
+		if (newSize > cap) {
+			// The range may point into this String, so it's read before the old buffer is freed
+			String grown;
+			grown.reserve((newSize > cap * 2) ? newSize : cap * 2);
+			if (sz)
+				std::char_traits<char>::copy(grown.cp, cp, sz);
+			grown.sz = sz;
+			for (; first != last; ++first)
+				construct(grown.cp + grown.sz++, *first);
+			grown.terminate();
+			swap(grown);
+			return;
+		}
+		for (; first != last; ++first)
+			construct(cp + sz++, *first);
+		terminate();
+	}
+	else {
+		// Writing through locals, so the size isn't stored and loaded again for every character
+		char* out = cp + sz;
+		char* limit = cp + cap;
+		for (; first != last; ++first) {
+			if (out == limit) {
+				sz = out - cp;
+				grow(sz + 1);
+				out = cp + sz;
+				limit = cp + cap;
+			}
+			construct(out++, *first);
+		}
+		sz = out - cp;
+		terminate();
+	}
+}
+
+/* Create String from the range in between two input iterators */
+template<typename InputIterator> String::String(InputIterator first, InputIterator last)
+{
+	append_range(first, last);
+}
+
+/* Append the String created from the given range, to this String */
+template<typename InputIterator> String& String::append(InputIterator first, InputIterator last)
+{
+	append_range(first, last);
+	return *this;
+}
+
+/* Assign this String to the String created from the given range */
+template<typename InputIterator> String& String::assign(InputIterator first, InputIterator last)
+{
+	if constexpr (contiguous_range<InputIterator>()) {
+		assign_chars(range_data(first), range_data(last) - range_data(first));
+	}
+	else {
+		String range(first, last); // The range may be read from this String
+		swap(range);
+	}
+	return *this;
+}
+
+/* Insert the characters from the given range into the place where iterator points to,
+return iterator past them, or end() if the iterator doesn't point into this String */
+template<typename InputIterator> 
+String::iterator String::insert(iterator p, InputIterator first, InputIterator last)
+{
+	const size_t index = index_of(p.m_cp);
+	if (index == npos)
+		return end();
+
+	if constexpr (contiguous_range<InputIterator>()) {
+		const size_t n = range_data(last) - range_data(first);
+		insert_chars(index, range_data(first), n);
+		return begin() + index + n;
+	}
+	else {
+		String range(first, last);
+		insert_chars(index, range.cp, range.sz);
+		return begin() + index + range.sz;
+	}
+}
+
+/* Replace the given range with characters from the second range,
+if the first range isn't a part of this String, leave it unchanged */
+template<typename InputIterator>
+String& String::replace(const_iterator i1, const_iterator i2, InputIterator first, InputIterator last)
+{
+	const size_t index_first = index_of(i1.m_cp), index_last = index_of(i2.m_cp);
+	if (index_first == npos || index_last == npos || index_last < index_first)
+		return *this;
+
+	if constexpr (contiguous_range<InputIterator>()) {
+		replace_chars(index_first, index_last - index_first, range_data(first), range_data(last) - range_data(first));
+	}
+	else {
+		String range(first, last);
+		replace_chars(index_first, index_last - index_first, range.cp, range.sz);
+	}
+	return *this;
+}
+
+/************************************* STRING BUFFER FUNCTIONS ****************************************/
+
+/* Make room for (n) characters and call op(char* buffer, size_t n), that writes the text into the buffer and returns its new size.
+The characters after the old size aren't initialized, so the operation can fill them without writing them twice */
+template<typename Operation> void String::resize_and_overwrite(size_t n, Operation op)
+{
+	grow(n);
+	const size_t newSize = std::move(op)(cp, n);
+	if (newSize > n)
+		throw std::out_of_range("resize_and_overwrite() operation returned a size larger than the buffer!");
+	sz = newSize;
+	terminate();
+}
+
+/************************************* STRING NUMERIC FUNCTIONS ****************************************/
+
+/* Append the decimal representation of the given integer to this String */
+template<typename Integer>
+std::enable_if_t<std::is_integral_v<Integer>, String&> String::append_number(Integer value)
+{
+	if constexpr (std::is_same_v<Integer, bool>)
+		return append_unsigned(value ? 1 : 0);
+	else if constexpr (std::is_signed_v<Integer>)
+		return append_signed(static_cast<long long>(value));
+	else
+		return append_unsigned(static_cast<unsigned long long>(value));
+}
+
+/************************************* STRING FORMAT FUNCTIONS ****************************************/
+
+/* Return the kind of the format argument with the given type */
+template<typename T> constexpr String::Format_Kind String::format_kind()
+{
+	if constexpr (std::is_same_v<T, char>)
+		return Format_Kind::Character;
+	else if constexpr (std::is_same_v<T, bool>)
+		return Format_Kind::Text;
+	else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+		return Format_Kind::Signed;
+	else if constexpr (std::is_integral_v<T>)
+		return Format_Kind::Unsigned;
+	else if constexpr (std::is_same_v<T, float>)
+		return Format_Kind::Float;
+	else if constexpr (std::is_floating_point_v<T>)
+		return Format_Kind::Double;
+	else if constexpr (std::is_same_v<T, String> || std::is_convertible_v<T, const char*>
+		|| std::is_convertible_v<T, std::string_view>)
+		return Format_Kind::Text;
+	else
+		return Format_Kind::None;
+}
+
+/* Store the argument of the format functions */
+template<typename T> String::Format_Arg String::make_format_arg(const T& value)
+{
+	constexpr Format_Kind kind = format_kind<T>();
+	static_assert(kind != Format_Kind::None, "Unsupported type of the format argument!");
+
+	Format_Arg arg;
+	arg.kind = kind;
+	if constexpr (std::is_same_v<T, bool>) {
+		arg.text.ptr = value ? "true" : "false";
+		arg.text.len = value ? 4 : 5;
+	}
+	else if constexpr (kind == Format_Kind::Character)
+		arg.ch = value;
+	else if constexpr (kind == Format_Kind::Signed)
+		arg.i = value;
+	else if constexpr (kind == Format_Kind::Unsigned)
+		arg.u = value;
+	else if constexpr (kind == Format_Kind::Float)
+		arg.f = value;
+	else if constexpr (kind == Format_Kind::Double)
+		arg.d = static_cast<double>(value);
+	else if constexpr (std::is_same_v<T, String>) {
+		arg.text.ptr = value.cp;
+		arg.text.len = value.sz;
+	}
+	else if constexpr (std::is_convertible_v<T, const char*>) {
+		const char* ptr = value;
+		arg.text.ptr = ptr;
+		arg.text.len = std::char_traits<char>::length(ptr);
+	}
+	else {
+		std::string_view view = value;
+		arg.text.ptr = view.data();
+		arg.text.len = view.size();
+	}
+	return arg;
+}
+
+/* Parse the replacement field starting right after '{' at (i), leave (i) at its closing '}',
+return false if the field is malformed */
+constexpr bool String::parse_format_spec(const char* str, size_t len, size_t& i, Format_Spec& spec)
+{
+	if (i < len && str[i] == ':') {
+		i++;
+		if (i < len && str[i] == '.') {
+			i++;
+			if (i >= len || str[i] < '0' || str[i] > '9')
+				return false;
+			spec.precision = 0;
+			for (int digits = 0; i < len && str[i] >= '0' && str[i] <= '9'; i++, digits++) {
+				if (digits == 2)
+					return false; // Precision is limited to two digits
+				spec.precision = spec.precision * 10 + (str[i] - '0');
+			}
+		}
+		if (i < len && (str[i] == 'x' || str[i] == 'X' || str[i] == 'f'))
+			spec.type = str[i++];
+	}
+	return i < len && str[i] == '}';
+}
+
+/* Check if every replacement field matches the type of its argument */
+template<typename... Args> constexpr void String::Format_String<Args...>::check() const
+{
+	constexpr Format_Kind kinds[] = { format_kind<Args>()..., Format_Kind::None };
+	size_t argIndex = 0;
+	for (size_t i = 0; i < m_len; i++) {
+		if (m_str[i] == '}') {
+			if (i + 1 < m_len && m_str[i + 1] == '}') {
+				i++;
+				continue;
+			}
+			throw std::runtime_error("Unmatched '}' in the format string!");
+		}
+		if (m_str[i] != '{')
+			continue;
+		if (i + 1 < m_len && m_str[i + 1] == '{') {
+			i++;
+			continue;
+		}
+
+		Format_Spec spec;
+		i++;
+		if (!parse_format_spec(m_str, m_len, i, spec))
+			throw std::runtime_error("Invalid replacement field in the format string!");
+		if (argIndex >= sizeof...(Args))
+			throw std::runtime_error("Not enough arguments for the format string!");
+
+		Format_Kind kind = kinds[argIndex++];
+		bool integer = (kind == Format_Kind::Signed || kind == Format_Kind::Unsigned);
+		bool floating = (kind == Format_Kind::Double || kind == Format_Kind::Float);
+		if ((spec.type == 'x' || spec.type == 'X') && !integer)
+			throw std::runtime_error("Hexadecimal format used with a non-integer argument!");
+		if ((spec.type == 'f' || spec.precision >= 0) && !floating)
+			throw std::runtime_error("Precision used with a non-floating-point argument!");
+	}
+	if (argIndex != sizeof...(Args))
+		throw std::runtime_error("Too many arguments for the format string!");
+}
+
+/* Return the String built from the format string, with every {} replaced by the next argument */
+template<typename... Args>
+String String::format(Format_String<std::decay_t<Args>...> fmt, Args&&... args)
+{
+	String result;
+	format_to(result, fmt, std::forward<Args>(args)...);
+	return result;
+}
+
+/* Append the text built from the format string to the given String, reusing its capacity */
+template<typename... Args>
+String& format_to(String& out, String::Format_String<std::decay_t<Args>...> fmt, Args&&... args)
+{
+	const String::Format_Arg list[] = { String::make_format_arg<std::decay_t<Args>>(args)..., String::Format_Arg() };
+	String::vformat_to(out, fmt.str(), fmt.length(), list);
+	return out;
+}
@@ -0,0 +1,573 @@
+#include <cstring>
+using std::memcpy;
+using std::memcmp;
+
+#include <cstdint>
+
+#include <stdexcept>
+using std::out_of_range;
+using std::runtime_error;
+using std::invalid_argument;
+
+#include <vector>
+using std::vector;
+
+#include <algorithm>
+
+#include <functional>
+using std::less;
+using std::less_equal;
+
+#include <string_view>
+using std::string_view;
+
+#include <functional>
+using std::function;
+
+#include "StringColumn.h"
+#include "StringParallel.h"
+#include "StringPattern.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*********************************************** HELPERS ***************************************************/
+
+//Start of a serialized StringColumn
+static const char columnMagic[8] = { 'S', 't', 'r', 'C', 'o', 'l', '0', '1' };
+
+//Offsets and characters are read in pieces of this size, so a damaged header can't make it allocate everything at once
+static const size_t readChunk = 1 << 20;
+
+/* Position of a value, with 8 of its characters packed into a number, that orders the same way they do */
+struct Sort_Key
+{
+	uint64_t prefix;
+	size_t index;
+	unsigned char rest; // Characters left from the packed ones on, 9 standing for more than 8
+};
+
+/* Pack 8 characters from (depth) on into a number, the first one in the highest byte, missing ones are 0 */
+static void pack_key(Sort_Key& key, string_view view, size_t depth) noexcept
+{
+	size_t rest = (view.size() > depth) ? view.size() - depth : 0;
+	uint64_t prefix = 0;
+	for (size_t i = 0; i < 8; i++)
+		prefix = (prefix << 8) | ((i < rest) ? static_cast<unsigned char>(view[depth + i]) : 0u);
+	key.prefix = prefix;
+	key.rest = static_cast<unsigned char>((rest > 8) ? 9 : rest);
+}
+
+/* Count the set bits of the word */
+static inline unsigned bitCount(uint64_t word)
+{
+#if defined(_MSC_VER)
+	return (unsigned) __popcnt64(word);
+#else
+	return __builtin_popcountll(word);
+#endif
+}
+
+/* Return the index of the lowest set bit, the word can't be 0 */
+static inline unsigned lowestBit64(uint64_t word)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return index;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+/* Load 8 characters as one number, in the byte order of this machine */
+static inline uint64_t load8(const char* cptr)
+{
+	uint64_t word;
+	memcpy(&word, cptr, sizeof(word));
+	return word;
+}
+
+/* Compare (n) characters, the first 8 of them as one number, the rest with memcmp() */
+static inline bool same_chars(const char* cptr, const char* value, size_t n, uint64_t first8)
+{
+	if (n >= 8)
+		return load8(cptr) == first8 && memcmp(cptr + 8, value + 8, n - 8) == 0;
+	return memcmp(cptr, value, n) == 0;
+}
+
+/* Switch the offsets to 64 bits, once the blob doesn't fit 32 bit ones */
+void StringColumn::widen()
+{
+	wideEnds.assign(narrowEnds.begin(), narrowEnds.end());
+	vector<uint32_t>().swap(narrowEnds);
+	wide = true;
+}
+
+/* Record the end of the value, that was just copied to the blob */
+void StringColumn::end_value()
+{
+	const size_t end = blob.size();
+	if (!wide && end > UINT32_MAX)
+		widen();
+	if (wide)
+		wideEnds.push_back(end);
+	else
+		narrowEnds.push_back(static_cast<uint32_t>(end));
+}
+
+/* Return the value at the given position, without checking it */
+string_view StringColumn::value(size_t n) const noexcept
+{
+	size_t start = n ? end_of(n - 1) : 0;
+	return string_view(blob.data() + start, end_of(n) - start);
+}
+
+/* Check if the view points into the blob, the characters of this column */
+bool StringColumn::in_blob(string_view view) const noexcept
+{
+	const char* chars = blob.data();
+	return less_equal<const char*>()(chars, view.data()) && less<const char*>()(view.data(), chars + blob.size());
+}
+
+/* Split the words of a selection into chunks, one per task of the pool, and call task(firstWord, lastWord) for each.
+Columns below String_Pool::min_chunk characters per chunk are done in one piece on the calling thread */
+void StringColumn::run_chunks(size_t words, const function<void(size_t, size_t)>& task) const
+{
+	String_Pool& pool = String_Pool::shared();
+	size_t chunks = bytes() / String_Pool::min_chunk;
+	if (chunks > pool.size() * 4)
+		chunks = pool.size() * 4;
+	if (chunks > words)
+		chunks = words;
+	if (chunks <= 1) {
+		task(0, words);
+		return;
+	}
+	pool.run(chunks, [&](size_t i) { task(words * i / chunks, words * (i + 1) / chunks); });
+}
+
+/* Select the values, for which match(characters, length) is true, 64 of them per word of the bitmap */
+template<typename Match>
+StringColumn::Selection StringColumn::select(Match&& match) const
+{
+	const size_t count = size();
+	Selection result(count);
+	auto scan = [&](const auto* ends) {
+		run_chunks(result.m_words.size(), [&](size_t firstWord, size_t lastWord) {
+			const char* chars = blob.data();
+			for (size_t w = firstWord; w < lastWord; w++) {
+				const size_t first = w * 64, last = (first + 64 < count) ? first + 64 : count;
+				size_t start = first ? ends[first - 1] : 0;
+				uint64_t bits = 0;
+				for (size_t i = first; i < last; i++) {
+					const size_t end = ends[i];
+					bits |= static_cast<uint64_t>(match(chars + start, end - start)) << (i - first);
+					start = end;
+				}
+				result.m_words[w] = bits;
+			}
+		});
+	};
+	if (wide)
+		scan(wideEnds.data());
+	else
+		scan(narrowEnds.data());
+	return result;
+}
+
+/*********************************************** STRINGCOLUMN FUNCTIONS ***************************************************/
+
+/* Return the bytes held by the blob and the offsets, counting their unused room */
+size_t StringColumn::memory_usage() const noexcept
+{
+	return (blob.capacity() ? blob.capacity() + 1 : 0) + narrowEnds.capacity() * sizeof(uint32_t)
+		+ wideEnds.capacity() * sizeof(uint64_t);
+}
+
+/* Remove every value, keeping the room of the blob and the offsets */
+void StringColumn::clear() noexcept
+{
+	blob.clear();
+	narrowEnds.clear();
+	wideEnds.clear();
+	wide = false;
+}
+
+/* Make room for (values) values of (bytes) characters together */
+void StringColumn::reserve(size_t values, size_t bytes)
+{
+	blob.reserve(bytes);
+	if (!wide && bytes > UINT32_MAX)
+		widen();
+	if (wide)
+		wideEnds.reserve(values);
+	else
+		narrowEnds.reserve(values);
+}
+
+/* Make room for (values) values of (bytes) characters, when there isn't enough. The blob and the offsets grow to at least
+twice their capacity, unlike reserve() */
+void StringColumn::grow(size_t values, size_t bytes)
+{
+	if (bytes > blob.capacity())
+		blob.reserve(grown(bytes, blob.capacity()));
+	if (!wide && bytes > UINT32_MAX)
+		widen();
+	if (wide && values > wideEnds.capacity())
+		wideEnds.reserve(grown(values, wideEnds.capacity()));
+	else if (!wide && values > narrowEnds.capacity())
+		narrowEnds.reserve(grown(values, narrowEnds.capacity()));
+}
+
+/* Return the value at the given position */
+string_view StringColumn::operator[](size_t n) const
+{
+	if (n >= size())
+		throw out_of_range("Index is out of the range!");
+	return value(n);
+}
+
+/* Return the first value, if the column is empty, throw runtime_error */
+string_view StringColumn::front() const
+{
+	if (empty())
+		throw runtime_error("front() used on empty StringColumn!");
+	return value(0);
+}
+
+/* Return the last value, if the column is empty, throw runtime_error */
+string_view StringColumn::back() const
+{
+	if (empty())
+		throw runtime_error("back() used on empty StringColumn!");
+	return value(size() - 1);
+}
+
+/* Return iterator to the first value */
+StringColumn::Iterator StringColumn::begin() const noexcept
+{
+	return Iterator(this, 0);
+}
+
+/* Return iterator past the last value */
+StringColumn::Iterator StringColumn::end() const noexcept
+{
+	return Iterator(this, size());
+}
+
+/* Copy the value to the end of the blob. It may be a view of this column, the blob can move before it's copied */
+void StringColumn::append(string_view value)
+{
+	const size_t n = value.size();
+	if (n) {
+		if (in_blob(value)) {
+			size_t offset = value.data() - blob.data();
+			char* out = blob.prepare(n);
+			memcpy(out, blob.data() + offset, n);
+		}
+		else {
+			memcpy(blob.prepare(n), value.data(), n);
+		}
+		blob.commit(n);
+	}
+	end_value();
+}
+
+/* Remove the last value, if the column is empty, throw runtime_error */
+void StringColumn::pop_back()
+{
+	if (empty())
+		throw runtime_error("pop_back() used on empty StringColumn!");
+	if (wide)
+		wideEnds.pop_back();
+	else
+		narrowEnds.pop_back();
+	blob.resize(empty() ? 0 : end_of(size() - 1));
+}
+
+/* Swap the columns */
+void StringColumn::swap(StringColumn& column) noexcept
+{
+	blob.swap(column.blob);
+	narrowEnds.swap(column.narrowEnds);
+	wideEnds.swap(column.wideEnds);
+	std::swap(wide, column.wide);
+}
+
+/* Return the positions of the values in sorted order. The values are sorted by 8 characters at a time, packed into
+a number, and only the values, that tie on all of them so far, are sorted again by their next 8 characters */
+vector<size_t> StringColumn::sorted_order() const
+{
+	const size_t count = size();
+	vector<Sort_Key> keys(count);
+	for (size_t i = 0; i < count; i++) {
+		keys[i].index = i;
+		pack_key(keys[i], value(i), 0);
+	}
+
+	struct Range { size_t first, last, depth; };
+	vector<Range> pending{ Range{ 0, count, 0 } };
+	while (!pending.empty()) {
+		const Range range = pending.back();
+		pending.pop_back();
+		if (range.depth)
+			for (size_t i = range.first; i < range.last; i++)
+				pack_key(keys[i], value(keys[i].index), range.depth);
+		std::sort(keys.begin() + range.first, keys.begin() + range.last, [](const Sort_Key& lhs, const Sort_Key& rhs) {
+			return (lhs.prefix != rhs.prefix) ? lhs.prefix < rhs.prefix : lhs.rest < rhs.rest;
+		});
+		// Values, that tie and go on past these characters, are ordered by the next ones
+		for (size_t i = range.first, j; i < range.last; i = j) {
+			for (j = i + 1; j < range.last && keys[j].prefix == keys[i].prefix && keys[j].rest == keys[i].rest; j++)
+				;
+			if (j - i > 1 && keys[i].rest > 8)
+				pending.push_back(Range{ i, j, range.depth + 8 });
+		}
+	}
+
+	vector<size_t> order(count);
+	for (size_t i = 0; i < count; i++)
+		order[i] = keys[i].index;
+	return order;
+}
+
+/* Rebuild the column from the values at the given positions, in their order. With the result of sorted_order()
+this sorts the column, other orders can also repeat or leave out values */
+void StringColumn::reorder(const vector<size_t>& order)
+{
+	const size_t count = size();
+	size_t total = 0;
+	for (size_t index : order) {
+		if (index >= count)
+			throw out_of_range("Index is out of the range!");
+		total += end_of(index) - (index ? end_of(index - 1) : 0);
+	}
+
+	StringColumn result;
+	result.reserve(order.size(), total);
+	for (size_t index : order)
+		result.append(value(index));
+	swap(result);
+}
+
+/* Select the values equal to the given one. Only the values of the same length are read, their first 8 characters
+are compared as one number */
+StringColumn::Selection StringColumn::equals(string_view value) const
+{
+	const char* chars = value.data();
+	const size_t n = value.size();
+	const uint64_t first8 = (n >= 8) ? load8(chars) : 0;
+	return select([chars, n, first8](const char* cptr, size_t len) {
+		return len == n && same_chars(cptr, chars, n, first8);
+	});
+}
+
+/* Select the values starting with the prefix, the values shorter than it aren't read */
+StringColumn::Selection StringColumn::starts_with(string_view prefix) const
+{
+	const char* chars = prefix.data();
+	const size_t n = prefix.size();
+	const uint64_t first8 = (n >= 8) ? load8(chars) : 0;
+	return select([chars, n, first8](const char* cptr, size_t len) {
+		return len >= n && same_chars(cptr, chars, n, first8);
+	});
+}
+
+/* Select the values containing the needle. Instead of a search per value, String::search() runs over the blob,
+and each match is given to the value it lies in. A match crossing into the next value is skipped */
+StringColumn::Selection StringColumn::contains(string_view needle) const
+{
+	const size_t count = size();
+	Selection result(count);
+	if (needle.empty()) {
+		for (size_t i = 0; i < count; i++)
+			result.m_words[i / 64] |= uint64_t(1) << (i % 64);
+		return result;
+	}
+	run_chunks(result.m_words.size(), [&](size_t firstWord, size_t lastWord) {
+		const size_t first = firstWord * 64, last = (lastWord * 64 < count) ? lastWord * 64 : count;
+		if (first >= last)
+			return;
+		const char* chars = blob.data();
+		const size_t textEnd = end_of(last - 1);
+		size_t i = first, pos = first ? end_of(first - 1) : 0;
+		for (size_t m = String::search(chars, textEnd, needle.data(), needle.size(), pos); m != String::npos;
+			m = String::search(chars, textEnd, needle.data(), needle.size(), pos)) {
+			while (end_of(i) <= m)
+				i++;
+			if (m + needle.size() > end_of(i)) {
+				pos = m + 1;
+				continue;
+			}
+			result.m_words[i / 64] |= uint64_t(1) << (i % 64);
+			pos = end_of(i++); // The rest of the value doesn't matter anymore
+			if (i == last)
+				break;
+		}
+	});
+	return result;
+}
+
+/* Select the values matching the LIKE or glob pattern */
+StringColumn::Selection StringColumn::matching(const String_Pattern& pattern) const
+{
+	return select([&pattern](const char* cptr, size_t len) { return pattern.matches(string_view(cptr, len)); });
+}
+
+/* Write the column in binary: a header, the offsets and the blob, in the byte order of this machine */
+void StringColumn::serialize(std::ostream& os) const
+{
+	const uint64_t header[2] = { size(), bytes() };
+	const char width = wide ? 8 : 4;
+	os.write(columnMagic, sizeof(columnMagic));
+	os.write(reinterpret_cast<const char*>(header), sizeof(header));
+	os.write(&width, 1);
+	if (wide)
+		os.write(reinterpret_cast<const char*>(wideEnds.data()), wideEnds.size() * sizeof(uint64_t));
+	else
+		os.write(reinterpret_cast<const char*>(narrowEnds.data()), narrowEnds.size() * sizeof(uint32_t));
+	os.write(blob.data(), blob.size());
+}
+
+/* Read a column written by serialize(), throw runtime_error if the data isn't one or is damaged */
+StringColumn StringColumn::deserialize(std::istream& is)
+{
+	char magic[sizeof(columnMagic)];
+	uint64_t header[2];
+	char width = 0;
+	if (!is.read(magic, sizeof(magic)) || memcmp(magic, columnMagic, sizeof(magic)) != 0)
+		throw runtime_error("Not a serialized StringColumn!");
+	if (!is.read(reinterpret_cast<char*>(header), sizeof(header)) || !is.read(&width, 1))
+		throw runtime_error("Serialized StringColumn is cut short!");
+	const uint64_t count = header[0], bytes = header[1];
+	if ((width != 4 && width != 8) || (width == 4 && bytes > UINT32_MAX))
+		throw runtime_error("Serialized StringColumn is damaged!");
+
+	StringColumn column;
+	if (width == 8)
+		column.widen();
+	for (uint64_t done = 0; done < count; ) {
+		size_t chunk = (count - done < readChunk) ? static_cast<size_t>(count - done) : readChunk;
+		char* out;
+		if (width == 8) {
+			column.wideEnds.resize(done + chunk);
+			out = reinterpret_cast<char*>(column.wideEnds.data() + done);
+		}
+		else {
+			column.narrowEnds.resize(done + chunk);
+			out = reinterpret_cast<char*>(column.narrowEnds.data() + done);
+		}
+		if (!is.read(out, chunk * width))
+			throw runtime_error("Serialized StringColumn is cut short!");
+		done += chunk;
+	}
+	for (uint64_t done = 0; done < bytes; ) {
+		size_t chunk = (bytes - done < readChunk) ? static_cast<size_t>(bytes - done) : readChunk;
+		if (!is.read(column.blob.prepare(chunk), chunk))
+			throw runtime_error("Serialized StringColumn is cut short!");
+		column.blob.commit(chunk);
+		done += chunk;
+	}
+
+	// Every value has to end after the previous one, and the last one at the end of the blob
+	size_t previous = 0;
+	for (size_t i = 0; i < count; i++) {
+		size_t end = column.end_of(i);
+		if (end < previous)
+			throw runtime_error("Serialized StringColumn is damaged!");
+		previous = end;
+	}
+	if (previous != bytes)
+		throw runtime_error("Serialized StringColumn is damaged!");
+	return column;
+}
+
+/*********************************************** SELECTION FUNCTIONS ***************************************************/
+
+/* Check if the value at the given position is selected */
+bool StringColumn::Selection::test(size_t n) const
+{
+	if (n >= m_size)
+		throw out_of_range("Index is out of the range!");
+	return (m_words[n / 64] >> (n % 64)) & 1;
+}
+
+/* Count the selected values */
+size_t StringColumn::Selection::count() const noexcept
+{
+	size_t selected = 0;
+	for (uint64_t word : m_words)
+		selected += bitCount(word);
+	return selected;
+}
+
+/* Return the positions of the selected values, in order */
+vector<size_t> StringColumn::Selection::positions() const
+{
+	vector<size_t> found;
+	found.reserve(count());
+	for (size_t w = 0; w < m_words.size(); w++) {
+		for (uint64_t word = m_words[w]; word; word &= word - 1)
+			found.push_back(w * 64 + lowestBit64(word));
+	}
+	return found;
+}
+
+/* Keep only the values selected by both, the selections have to be of the same size */
+StringColumn::Selection& StringColumn::Selection::operator&=(const Selection& rhs)
+{
+	if (m_size != rhs.m_size)
+		throw invalid_argument("Selections of different sizes!");
+	for (size_t w = 0; w < m_words.size(); w++)
+		m_words[w] &= rhs.m_words[w];
+	return *this;
+}
+
+/* Add the values selected by the other one, the selections have to be of the same size */
+StringColumn::Selection& StringColumn::Selection::operator|=(const Selection& rhs)
+{
+	if (m_size != rhs.m_size)
+		throw invalid_argument("Selections of different sizes!");
+	for (size_t w = 0; w < m_words.size(); w++)
+		m_words[w] |= rhs.m_words[w];
+	return *this;
+}
+
+/* Return the values selected by both */
+StringColumn::Selection operator&(StringColumn::Selection lhs, const StringColumn::Selection& rhs)
+{
+	return lhs &= rhs;
+}
+
+/* Return the values selected by either */
+StringColumn::Selection operator|(StringColumn::Selection lhs, const StringColumn::Selection& rhs)
+{
+	return lhs |= rhs;
+}
+
+/* Check if both columns hold the same values */
+bool operator==(const StringColumn& lhs, const StringColumn& rhs)
+{
+	const size_t count = lhs.size();
+	if (count != rhs.size() || lhs.bytes() != rhs.bytes())
+		return false;
+	for (size_t i = 0; i < count; i++) {
+		if (lhs.end_of(i) != rhs.end_of(i))
+			return false;
+	}
+	return memcmp(lhs.blob.data(), rhs.blob.data(), lhs.bytes()) == 0;
+}
+
+/* Check if the columns hold different values */
+bool operator!=(const StringColumn& lhs, const StringColumn& rhs)
+{
+	return !(lhs == rhs);
+}
+
+/* Swap the columns */
+void swap(StringColumn& lhs, StringColumn& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
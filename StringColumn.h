@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <string_view>
+#include <functional>
+
+#include "String.h"
+
+class String_Pattern;
+
+/*********************************************** CLASSES ***************************************************/
+
+/*////////////////////////////////////////// StringColumn class /////////////////////////////////////////////*/
+
+/* Many small strings kept in one contiguous blob, with the offsets of their ends in a separate array.
+A value costs its characters and a 4 byte offset, the offsets widen to 8 bytes once the blob passes 4GB.
+Values are read as std::string_view, appending can move the blob, so views stay valid until the next append */
+class StringColumn
+{
+private:
+	//Helping functions
+	void widen();
+	void end_value();
+	size_t end_of(size_t n) const noexcept { return wide ? static_cast<size_t>(wideEnds[n]) : narrowEnds[n]; }
+	std::string_view value(size_t n) const noexcept;
+	bool in_blob(std::string_view view) const noexcept;
+	static size_t grown(size_t needed, size_t capacity) noexcept { return (needed > capacity * 2) ? needed : capacity * 2; }
+	void grow(size_t values, size_t bytes);
+	void run_chunks(size_t words, const std::function<void(size_t, size_t)>& task) const;
+	static std::string_view view_of(std::string_view view) noexcept { return view; }
+	static std::string_view view_of(const String& str) noexcept { return std::string_view(str.data(), str.size()); }
+	static std::string_view view_of(const char* cptr) { return std::string_view(cptr); }
+public:
+	//Types
+	typedef std::string_view value_type;
+	typedef size_t size_type;
+	class Iterator;
+	class Selection;
+
+public:
+	//Constructors
+	StringColumn() = default;
+
+	//Capacity
+	size_t size() const noexcept { return wide ? wideEnds.size() : narrowEnds.size(); }
+	bool empty() const noexcept { return size() == 0; }
+	size_t bytes() const noexcept { return blob.size(); }
+	size_t memory_usage() const noexcept;
+
+	void clear() noexcept;
+	void reserve(size_t values, size_t bytes);
+
+	//Element access
+	std::string_view operator[](size_t n) const;
+	std::string_view at(size_t n) const { return (*this)[n]; }
+	std::string_view front() const;
+	std::string_view back() const;
+	const char* data() const noexcept { return blob.data(); }
+
+	//Iterators
+	Iterator begin() const noexcept;
+	Iterator end() const noexcept;
+
+	//Modifiers
+	void append(std::string_view value);
+	void append(const String& str) { append(view_of(str)); }
+	void append(const char* cptr) { append(std::string_view(cptr)); }
+	template<typename Range> void append_all(const Range& values);
+	void pop_back();
+	void swap(StringColumn& column) noexcept;
+
+	//Scanning, calls function(view) for every value in order
+	template<typename Function> void for_each(Function&& function) const;
+
+	//Sorting
+	std::vector<size_t> sorted_order() const;
+	void reorder(const std::vector<size_t>& order);
+	void sort() { reorder(sorted_order()); }
+
+	//Predicates, selecting the values that match them
+	Selection equals(std::string_view value) const;
+	Selection starts_with(std::string_view prefix) const;
+	Selection contains(std::string_view needle) const;
+	Selection matching(const String_Pattern& pattern) const;
+
+	//Serialization
+	void serialize(std::ostream& os) const;
+	static StringColumn deserialize(std::istream& is);
+
+	//Non-member function overloads
+	friend bool operator==(const StringColumn& lhs, const StringColumn& rhs);
+	friend bool operator!=(const StringColumn& lhs, const StringColumn& rhs);
+private:
+	//Helping function of the predicates
+	template<typename Match> Selection select(Match&& match) const;
+
+	String blob; // The characters of every value, one after another
+	std::vector<uint32_t> narrowEnds; // Where each value ends in the blob, while it's below 4GB
+	std::vector<uint64_t> wideEnds; // The same, once it isn't
+	bool wide = false;
+};
+
+/*/////////////////////////////////////// StringColumn::Iterator class //////////////////////////////////////////*/
+
+/* Forward iterator over the values of StringColumn, giving std::string_view */
+class StringColumn::Iterator
+{
+public:
+	//Types
+	typedef std::forward_iterator_tag iterator_category;
+	typedef std::string_view value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const std::string_view* pointer;
+	typedef std::string_view reference;
+
+	//Constructors
+	Iterator() = default;
+	Iterator(const StringColumn* column, size_t index) : m_column(column), m_index(index) {}
+
+	//Access operators
+	std::string_view operator*() const { return (*m_column)[m_index]; }
+
+	//Incrementation
+	Iterator& operator++() { m_index++; return *this; }
+	Iterator operator++(int) { Iterator temp = *this; m_index++; return temp; }
+
+	//Rational operators
+	bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+	bool operator!=(const Iterator& rhs) const { return m_index != rhs.m_index; }
+private:
+	const StringColumn* m_column = nullptr;
+	size_t m_index = 0;
+};
+
+/*/////////////////////////////////////// StringColumn::Selection class //////////////////////////////////////////*/
+
+/* Bitmap of the values of StringColumn, that matched a predicate, bit (i % 64) of word (i / 64) stands for value i.
+Selections of the same column can be combined with & and | */
+class StringColumn::Selection
+{
+public:
+	//Constructors
+	Selection() = default;
+	explicit Selection(size_t n) : m_words((n + 63) / 64), m_size(n) {}
+
+	//Capacity
+	size_t size() const noexcept { return m_size; }
+	const std::vector<uint64_t>& words() const noexcept { return m_words; }
+
+	//Selected values
+	bool test(size_t n) const;
+	size_t count() const noexcept;
+	std::vector<size_t> positions() const;
+
+	//Combining
+	Selection& operator&=(const Selection& rhs);
+	Selection& operator|=(const Selection& rhs);
+
+	friend class StringColumn;
+private:
+	std::vector<uint64_t> m_words;
+	size_t m_size = 0;
+};
+
+/*********************************************** TEMPLATE FUNCTIONS ***************************************************/
+
+/* Append every value of the range. Forward ranges are measured first, so the blob and the offsets grow at most once,
+to at least twice their capacity, keeping repeated calls linear.
+The values may be views of this column, a blob that has to grow is kept until they are copied out of it */
+template<typename Range>
+void StringColumn::append_all(const Range& values)
+{
+	if constexpr (std::is_same_v<Range, StringColumn>) {
+		if (&values == this) {
+			StringColumn copy(values);
+			return append_all(copy);
+		}
+	}
+	using std::begin;
+	using std::end;
+	typedef typename std::iterator_traits<decltype(begin(values))>::iterator_category category;
+	String kept; // The old blob, while values pointing into it are copied
+	if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+		size_t count = 0, total = 0;
+		bool aliased = false;
+		for (auto it = begin(values); it != end(values); ++it) {
+			std::string_view view = view_of(*it);
+			aliased = aliased || in_blob(view);
+			total += view.size();
+			count++;
+		}
+		if (aliased && bytes() + total > blob.capacity()) {
+			const size_t used = bytes();
+			kept = std::move(blob);
+			blob.reserve(grown(used + total, kept.capacity()));
+			std::memcpy(blob.prepare(used), kept.data(), used);
+			blob.commit(used);
+		}
+		grow(size() + count, bytes() + total);
+	}
+	for (auto it = begin(values); it != end(values); ++it)
+		append(view_of(*it));
+}
+
+/* Call the function with every value, reading the offsets straight from their array */
+template<typename Function>
+void StringColumn::for_each(Function&& function) const
+{
+	const char* chars = blob.data();
+	size_t start = 0;
+	if (wide) {
+		for (uint64_t end : wideEnds) {
+			function(std::string_view(chars + start, end - start));
+			start = end;
+		}
+	}
+	else {
+		for (uint32_t end : narrowEnds) {
+			function(std::string_view(chars + start, end - start));
+			start = end;
+		}
+	}
+}
+
+/****************************************** FUNCTIONS DECLARATIONS *********************************************/
+
+bool operator==(const StringColumn& lhs, const StringColumn& rhs);
+bool operator!=(const StringColumn& lhs, const StringColumn& rhs);
+void swap(StringColumn& lhs, StringColumn& rhs) noexcept;
+
+StringColumn::Selection operator&(StringColumn::Selection lhs, const StringColumn::Selection& rhs);
+StringColumn::Selection operator|(StringColumn::Selection lhs, const StringColumn::Selection& rhs);
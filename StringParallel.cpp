@@ -0,0 +1,290 @@
+#include <cstring>
+using std::strlen;
+
+#include <vector>
+using std::vector;
+
+#include <thread>
+using std::thread;
+
+#include <mutex>
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+
+#include <atomic>
+using std::atomic;
+
+#include <functional>
+using std::function;
+
+#include <exception>
+using std::exception_ptr;
+using std::current_exception;
+using std::rethrow_exception;
+
+#include "StringParallel.h"
+#include "String.h"
+
+/*********************************************** HELPERS ***************************************************/
+
+//Positions kept from every chunk by parallel_count(), to find where the matches of the previous chunk meet its own
+static const size_t syncWindow = 64;
+
+//Set in the threads running a job, so jobs started by its tasks run on their own thread instead of waiting for the pool
+static thread_local bool insidePool = false;
+
+/* Matches of the pattern starting in one chunk, found as if the chunk was searched on its own from its start */
+struct Chunk_Matches
+{
+	vector<size_t> positions; // All of them, or the first syncWindow when only counting
+	size_t count = 0;
+	size_t last = 0;
+};
+
+/*********************************************** POOL FUNCTIONS ***************************************************/
+
+/* Start the workers, by default one less than the hardware threads, as the caller of run() works too */
+String_Pool::String_Pool(size_t threads)
+{
+	if (threads == 0)
+		threads = thread::hardware_concurrency();
+	for (size_t i = 1; i < threads; i++)
+		workers.emplace_back(&String_Pool::work, this);
+}
+
+/* Stop and join the workers */
+String_Pool::~String_Pool()
+{
+	{
+		lock_guard<mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (thread& worker : workers)
+		worker.join();
+}
+
+/* Return the pool used by String, created on the first use */
+String_Pool& String_Pool::shared()
+{
+	static String_Pool pool;
+	return pool;
+}
+
+/* Call task(i) for every i in [0, tasks) on the threads of the pool, and wait for all of them */
+void String_Pool::run(size_t tasks, const function<void(size_t)>& task)
+{
+	if (tasks == 0)
+		return;
+	if (tasks == 1 || workers.empty() || insidePool) {
+		for (size_t i = 0; i < tasks; i++)
+			task(i);
+		return;
+	}
+
+	lock_guard<mutex> running(runLock);
+	{
+		lock_guard<mutex> guard(lock);
+		job = &task;
+		jobTasks = tasks;
+		next = 0;
+		error = nullptr;
+		generation++;
+	}
+	wake.notify_all();
+	insidePool = true;
+	execute(task, tasks);
+	insidePool = false;
+
+	exception_ptr failure;
+	{
+		unique_lock<mutex> guard(lock);
+		finished.wait(guard, [this] { return active == 0; });
+		job = nullptr;
+		failure = error;
+	}
+	if (failure)
+		rethrow_exception(failure);
+}
+
+/* Take the tasks of the job, until there are none left */
+void String_Pool::execute(const function<void(size_t)>& task, size_t tasks)
+{
+	for (size_t i = next++; i < tasks; i = next++) {
+		try {
+			task(i);
+		}
+		catch (...) {
+			lock_guard<mutex> guard(lock);
+			if (!error)
+				error = current_exception();
+		}
+	}
+}
+
+/* Loop of a worker, joining every new job */
+void String_Pool::work()
+{
+	insidePool = true;
+	unsigned seen = 0;
+	unique_lock<mutex> guard(lock);
+	while (true) {
+		wake.wait(guard, [&] { return stopping || generation != seen; });
+		if (stopping)
+			return;
+		seen = generation;
+		if (!job)
+			continue; // The job ended before this worker woke up
+		const function<void(size_t)>* task = job;
+		size_t tasks = jobTasks;
+		active++;
+		guard.unlock();
+		execute(*task, tasks);
+		guard.lock();
+		if (--active == 0)
+			finished.notify_all();
+	}
+}
+
+/*********************************************** PARALLEL SEARCH FUNCTIONS ***************************************************/
+
+/* Count the matches that count() would, with chunks of the text searched by the pool. Each chunk is searched from its start,
+then the chunks are joined in order. When the last match of the previous chunk reaches into the next one,
+that chunk is searched again from the end of the match, until it meets one of the chunk's own matches */
+size_t String::parallel_matches(const char* pat, size_t patLen, size_t pos, vector<size_t>* found) const
+{
+	if (patLen == 0 || pos > sz || patLen > sz - pos)
+		return 0;
+	String_Pool& pool = String_Pool::shared();
+	const size_t starts = sz - patLen + 1 - pos; // Positions, where a match can start
+	size_t chunks = starts / String_Pool::min_chunk;
+	if (chunks > pool.size() * 4)
+		chunks = pool.size() * 4;
+	if (chunks <= 1)
+		return count_matches(cp, sz, pat, patLen, pos, sz, found);
+
+	auto chunkStart = [&](size_t i) { return pos + starts * i / chunks; };
+	vector<Chunk_Matches> results(chunks);
+	pool.run(chunks, [&](size_t i) {
+		const size_t end = chunkStart(i + 1);
+		Chunk_Matches& result = results[i];
+		for (size_t m = search(cp, end + patLen - 1, pat, patLen, chunkStart(i)); m != npos;
+			m = search(cp, end + patLen - 1, pat, patLen, m + patLen)) {
+			if (found || result.positions.size() < syncWindow)
+				result.positions.push_back(m);
+			result.count++;
+			result.last = m;
+		}
+	});
+
+	size_t matches = 0;
+	size_t allowed = pos; // Where the next match can start, after the last one taken
+	for (size_t i = 0; i < chunks; i++) {
+		const Chunk_Matches& result = results[i];
+		const size_t begin = chunkStart(i), end = chunkStart(i + 1);
+		if (allowed <= begin) {
+			matches += result.count;
+			if (found)
+				found->insert(found->end(), result.positions.begin(), result.positions.end());
+			if (result.count)
+				allowed = result.last + patLen;
+			continue;
+		}
+
+		size_t j = 0;
+		for (size_t m = search(cp, end + patLen - 1, pat, patLen, allowed); m != npos;
+			m = search(cp, end + patLen - 1, pat, patLen, m + patLen)) {
+			while (j < result.positions.size() && result.positions[j] < m)
+				j++;
+			if (j < result.positions.size() && result.positions[j] == m) {
+				// From here on both searches find the same matches
+				matches += result.count - j;
+				if (found)
+					found->insert(found->end(), result.positions.begin() + j, result.positions.end());
+				allowed = result.last + patLen;
+				break;
+			}
+			matches++;
+			if (found)
+				found->push_back(m);
+			allowed = m + patLen;
+		}
+	}
+	return matches;
+}
+
+/* Find the pattern in this String, starting at the given position, with the chunks of the text searched by the pool */
+size_t String::parallel_search(const char* pat, size_t patLen, size_t pos) const
+{
+	if (patLen == 0 || pos > sz || patLen > sz - pos)
+		return search(cp, sz, pat, patLen, pos);
+	String_Pool& pool = String_Pool::shared();
+	const size_t starts = sz - patLen + 1 - pos;
+	size_t chunks = starts / String_Pool::min_chunk;
+	if (chunks > pool.size() * 4)
+		chunks = pool.size() * 4;
+	if (chunks <= 1)
+		return search(cp, sz, pat, patLen, pos);
+
+	// The first chunk with a match holds the answer, chunks after it aren't searched anymore
+	vector<size_t> firsts(chunks);
+	atomic<size_t> best(chunks);
+	pool.run(chunks, [&](size_t i) {
+		if (i > best.load())
+			return;
+		const size_t begin = pos + starts * i / chunks, end = pos + starts * (i + 1) / chunks;
+		firsts[i] = search(cp, end + patLen - 1, pat, patLen, begin);
+		if (firsts[i] == npos)
+			return;
+		size_t current = best.load();
+		while (i < current && !best.compare_exchange_weak(current, i))
+			;
+	});
+	return (best.load() < chunks) ? firsts[best.load()] : npos;
+}
+
+/* Find given String in this String, starting at the given position, with the chunks of the text searched by the pool */
+size_t String::parallel_find(const String& str, size_t pos) const
+{
+	return parallel_search(str.cp, str.sz, pos);
+}
+
+/* Find given text in this String, starting at the given position, with the chunks of the text searched by the pool */
+size_t String::parallel_find(const char* cptr, size_t pos) const
+{
+	if (!cptr)
+		return npos;
+	return parallel_search(cptr, strlen(cptr), pos);
+}
+
+/* Return the positions that find_all() returns, with the chunks of the text searched by the pool */
+vector<size_t> String::parallel_find_all(const String& str, size_t pos) const
+{
+	vector<size_t> found;
+	parallel_matches(str.cp, str.sz, pos, &found);
+	return found;
+}
+
+/* Return the positions that find_all() returns, with the chunks of the text searched by the pool */
+vector<size_t> String::parallel_find_all(const char* cptr, size_t pos) const
+{
+	vector<size_t> found;
+	if (cptr)
+		parallel_matches(cptr, strlen(cptr), pos, &found);
+	return found;
+}
+
+/* Count the copies that count() counts, with the chunks of the text searched by the pool */
+size_t String::parallel_count(const String& str, size_t pos) const
+{
+	return parallel_matches(str.cp, str.sz, pos, nullptr);
+}
+
+/* Count the copies that count() counts, with the chunks of the text searched by the pool */
+size_t String::parallel_count(const char* cptr, size_t pos) const
+{
+	if (!cptr)
+		return 0;
+	return parallel_matches(cptr, strlen(cptr), pos, nullptr);
+}
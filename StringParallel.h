@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+/*********************************************** CLASSES ***************************************************/
+
+/*////////////////////////////////////////// String_Pool class /////////////////////////////////////////////*/
+
+/* Threads used by String's parallel_* functions. run() hands out the tasks to the workers and the calling thread,
+and returns when all of them are done. Jobs are run one at a time, a job started from inside a task runs on its thread */
+class String_Pool
+{
+public:
+	//Pieces of text smaller than this aren't worth handing to another thread
+	static const size_t min_chunk = 1 << 20;
+
+	//Constructors, Destructor
+	explicit String_Pool(size_t threads = 0);
+	String_Pool(const String_Pool&) = delete;
+	String_Pool& operator=(const String_Pool&) = delete;
+	~String_Pool();
+
+	static String_Pool& shared();
+
+	//Threads working on a job, the caller included
+	size_t size() const noexcept { return workers.size() + 1; }
+
+	//Call task(i) for every i in [0, tasks), rethrow the first exception of the tasks
+	void run(size_t tasks, const std::function<void(size_t)>& task);
+private:
+	//Helping functions
+	void work();
+	void execute(const std::function<void(size_t)>& task, size_t tasks);
+private:
+	std::vector<std::thread> workers;
+	std::mutex runLock; // Held for the whole job
+	std::mutex lock; // Guards the fields below
+	std::condition_variable wake;
+	std::condition_variable finished;
+	const std::function<void(size_t)>* job = nullptr;
+	size_t jobTasks = 0;
+	std::atomic<size_t> next{ 0 };
+	size_t active = 0; // Workers inside the current job
+	unsigned generation = 0;
+	bool stopping = false;
+	std::exception_ptr error;
+};
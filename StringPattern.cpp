@@ -0,0 +1,272 @@
+#include <cstring>
+using std::memcmp;
+using std::memchr;
+
+#include <stdexcept>
+using std::invalid_argument;
+
+#include <string_view>
+using std::string_view;
+
+#include "StringPattern.h"
+
+/*********************************************** HELPERS ***************************************************/
+
+/* Return the ASCII lowercase version of the character, leave other characters untouched */
+static inline char asciiLower(char ch)
+{
+	return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+/* Return the ASCII uppercase version of the character, leave other characters untouched */
+static inline char asciiUpper(char ch)
+{
+	return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - 'a' + 'A') : ch;
+}
+
+//Below this many characters a plain loop finds a character sooner than the call to memchr()
+static const size_t shortScan = 32;
+
+/* Find the character in (n) characters, return nullptr if it's not there */
+static const char* findChar(const char* cptr, size_t n, char ch)
+{
+	if (n >= shortScan)
+		return static_cast<const char*>(memchr(cptr, ch, n));
+	for (size_t i = 0; i < n; i++) {
+		if (cptr[i] == ch)
+			return cptr + i;
+	}
+	return nullptr;
+}
+
+/* Find the character, given in lowercase, in (n) characters ignoring ASCII case, return nullptr if it's not there */
+static const char* findFolded(const char* cptr, size_t n, char lower)
+{
+	if (asciiUpper(lower) == lower)
+		return findChar(cptr, n, lower);
+	for (size_t i = 0; i < n; i++) {
+		if (asciiLower(cptr[i]) == lower)
+			return cptr + i;
+	}
+	return nullptr;
+}
+
+/* Read a LIKE pattern: % is any text, _ any character, the escape character makes the next one literal */
+void String_Pattern::parse_like(string_view pattern, char escape)
+{
+	for (size_t i = 0; i < pattern.size(); i++) {
+		char ch = pattern[i];
+		if (ch == escape) {
+			if (++i == pattern.size())
+				throw invalid_argument("Pattern ends with the escape character!");
+			add_char(pattern[i]);
+		}
+		else if (ch == '%') {
+			add_star();
+		}
+		else if (ch == '_') {
+			add_kind(anyChar);
+		}
+		else {
+			add_char(ch);
+		}
+	}
+}
+
+/* Read a glob pattern: * is any text, ? any character, [abc], [a-z] and [!abc] sets, \ makes the next character literal.
+A [ without its ] is literal */
+void String_Pattern::parse_glob(string_view pattern)
+{
+	for (size_t i = 0; i < pattern.size(); i++) {
+		char ch = pattern[i];
+		if (ch == '\\') {
+			if (++i == pattern.size())
+				throw invalid_argument("Pattern ends with the escape character!");
+			add_char(pattern[i]);
+		}
+		else if (ch == '*') {
+			add_star();
+		}
+		else if (ch == '?') {
+			add_kind(anyChar);
+		}
+		else if (ch == '[') {
+			size_t next = parse_set(pattern, i);
+			if (next == String::npos)
+				add_char(ch);
+			else
+				i = next - 1;
+		}
+		else {
+			add_char(ch);
+		}
+	}
+}
+
+/* Read the set starting with [ at the given position and add it to the pattern,
+return the position after its ], or npos if it has none */
+size_t String_Pattern::parse_set(string_view pattern, size_t pos)
+{
+	const size_t n = pattern.size();
+	size_t i = pos + 1;
+	bool negated = false;
+	if (i < n && (pattern[i] == '!' || pattern[i] == '^')) {
+		negated = true;
+		i++;
+	}
+
+	bool member[256] = {};
+	for (bool first = true; i < n && (pattern[i] != ']' || first); first = false) {
+		char low = pattern[i];
+		if (low == '\\' && i + 1 < n)
+			low = pattern[++i];
+		if (i + 2 < n && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+			for (unsigned ch = static_cast<unsigned char>(low); ch <= static_cast<unsigned char>(pattern[i + 2]); ch++)
+				member[ch] = true;
+			i += 3;
+		}
+		else {
+			member[static_cast<unsigned char>(low)] = true;
+			i++;
+		}
+	}
+	if (i >= n)
+		return String::npos;
+
+	String members;
+	for (unsigned ch = 0; ch < 256; ch++) {
+		char c = static_cast<char>(ch);
+		bool in = member[ch] || (ignoreCase && (member[static_cast<unsigned char>(asciiLower(c))]
+			|| member[static_cast<unsigned char>(asciiUpper(c))]));
+		if (in != negated)
+			members.push_back(c);
+	}
+	sets.emplace_back(members.data(), members.size());
+	add_kind(static_cast<int>(sets.size() - 1));
+	return i + 1;
+}
+
+/* Add a literal character to the last part */
+void String_Pattern::add_char(char ch)
+{
+	Part& part = parts.back();
+	part.chars.push_back(ignoreCase ? asciiLower(ch) : ch);
+	part.kinds.push_back(literalChar);
+	if (part.anchor == String::npos)
+		part.anchor = part.kinds.size() - 1;
+	minLength++;
+}
+
+/* Add any character or a set to the last part */
+void String_Pattern::add_kind(int kind)
+{
+	Part& part = parts.back();
+	part.chars.push_back('\0');
+	part.kinds.push_back(kind);
+	part.literal = false;
+	minLength++;
+}
+
+/* Start a new part after % or *, a run of them is the same as one */
+void String_Pattern::add_star()
+{
+	if (parts.size() > 1 && parts.back().kinds.empty())
+		return;
+	parts.emplace_back();
+}
+
+/* Check if the part matches the text at the given position, the text has to hold enough characters */
+bool String_Pattern::match_at(const Part& part, const char* text, size_t pos) const noexcept
+{
+	const size_t len = part.kinds.size();
+	if (len == 0)
+		return true;
+	const char* at = text + pos;
+	if (part.literal && !ignoreCase)
+		return memcmp(at, part.chars.data(), len) == 0;
+	for (size_t i = 0; i < len; i++) {
+		const int kind = part.kinds[i];
+		if (kind == literalChar) {
+			if ((ignoreCase ? asciiLower(at[i]) : at[i]) != part.chars[i])
+				return false;
+		}
+		else if (kind != anyChar && !sets[kind].contains(at[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Find the first place in [pos, end) of the text, where the whole part matches, return its position or npos */
+size_t String_Pattern::find(const Part& part, const char* text, size_t pos, size_t end) const noexcept
+{
+	const size_t len = part.kinds.size();
+	if (pos > end || len > end - pos)
+		return String::npos;
+	if (part.literal) {
+		return ignoreCase ? String::isearch(text, end, part.chars.data(), len, pos)
+			: String::search(text, end, part.chars.data(), len, pos);
+	}
+
+	const size_t last = end - len; // Last position, where the part can start
+	if (part.anchor == String::npos) {
+		for (size_t start = pos; start <= last; start++) {
+			if (match_at(part, text, start))
+				return start;
+		}
+		return String::npos;
+	}
+
+	// Jump between the places of the first literal character, only there the rest is compared
+	const size_t anchor = part.anchor;
+	const char ch = part.chars[anchor];
+	for (size_t start = pos; start <= last; start++) {
+		const char* found = ignoreCase ? findFolded(text + start + anchor, last - start + 1, ch)
+			: findChar(text + start + anchor, last - start + 1, ch);
+		if (!found)
+			return String::npos;
+		start = (found - text) - anchor;
+		if (match_at(part, text, start))
+			return start;
+	}
+	return String::npos;
+}
+
+/*********************************************** STRING_PATTERN FUNCTIONS ***************************************************/
+
+/* Compile the pattern. The escape character makes the next one literal in LIKE patterns, globs always use \ */
+String_Pattern::String_Pattern(string_view pattern, Pattern_Syntax syntax, bool ignoreCase, char escape)
+	: parts(1), ignoreCase(ignoreCase)
+{
+	if (syntax == Pattern_Syntax::Like)
+		parse_like(pattern, escape);
+	else
+		parse_glob(pattern);
+}
+
+/* Check if the whole text matches the pattern. The first and the last part are compared at the ends of the text,
+the parts in between are found from left to right. As each part matches a fixed number of characters,
+taking the first place for every part never misses a match */
+bool String_Pattern::matches(string_view text) const noexcept
+{
+	const size_t n = text.size();
+	if (n < minLength)
+		return false;
+	const char* chars = text.data();
+	const Part& first = parts.front();
+	if (parts.size() == 1)
+		return n == first.kinds.size() && match_at(first, chars, 0);
+
+	const Part& last = parts.back();
+	const size_t end = n - last.kinds.size();
+	if (!match_at(first, chars, 0) || !match_at(last, chars, end))
+		return false;
+	size_t pos = first.kinds.size();
+	for (size_t i = 1; i + 1 < parts.size(); i++) {
+		size_t found = find(parts[i], chars, pos, end);
+		if (found == String::npos)
+			return false;
+		pos = found + parts[i].kinds.size();
+	}
+	return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <string_view>
+
+#include "String.h"
+
+/*********************************************** CLASSES ***************************************************/
+
+/* Wildcards understood by String_Pattern: SQL LIKE uses % and _, shell globs use *, ? and [sets] */
+enum class Pattern_Syntax
+{
+	Like,
+	Glob
+};
+
+/*////////////////////////////////////////// String_Pattern class /////////////////////////////////////////////*/
+
+/* LIKE or glob pattern, compiled once and matched against many texts. The pattern is split at its % (or *)
+into parts, that match a fixed number of characters. The first part has to match at the start of the text,
+the last one at its end, and the parts in between are found left to right, each after the previous one.
+Literal parts are found with String::search(), other parts start at their first literal character found by memchr() */
+class String_Pattern
+{
+private:
+	/* Characters between two %, each one a literal, any character (_ or ?) or one of a set */
+	struct Part
+	{
+		String chars; // Literal characters, lowercase when the case is ignored, 0 in place of the others
+		std::vector<int> kinds; // For every character: literal, any, or the index of its set
+		bool literal = true;
+		size_t anchor = String::npos; // Position of the first literal character
+	};
+	static constexpr int literalChar = -1;
+	static constexpr int anyChar = -2;
+
+	//Helping functions
+	void parse_like(std::string_view pattern, char escape);
+	void parse_glob(std::string_view pattern);
+	size_t parse_set(std::string_view pattern, size_t pos);
+	void add_char(char ch);
+	void add_kind(int kind);
+	void add_star();
+	bool match_at(const Part& part, const char* text, size_t pos) const noexcept;
+	size_t find(const Part& part, const char* text, size_t pos, size_t end) const noexcept;
+public:
+	//Constructors
+	explicit String_Pattern(std::string_view pattern, Pattern_Syntax syntax = Pattern_Syntax::Like,
+		bool ignoreCase = false, char escape = '\\');
+
+	//Matching
+	bool matches(std::string_view text) const noexcept;
+	bool matches(const String& str) const noexcept { return matches(std::string_view(str.data(), str.size())); }
+	bool matches(const char* cptr) const noexcept { return matches(std::string_view(cptr)); }
+	bool operator()(std::string_view text) const noexcept { return matches(text); }
+
+	//Information
+	size_t min_length() const noexcept { return minLength; }
+	bool ignores_case() const noexcept { return ignoreCase; }
+private:
+	std::vector<Part> parts; // Separated by % or *, there's always at least one
+	std::vector<String::Char_Set> sets;
+	size_t minLength = 0;
+	bool ignoreCase = false;
+};
@@ -0,0 +1,772 @@
+#include <cstring>
+using std::memcmp;
+
+#include <stdexcept>
+using std::invalid_argument;
+
+#include <algorithm>
+using std::sort;
+using std::remove;
+
+#include <bitset>
+using std::bitset;
+
+#include <mutex>
+using std::lock_guard;
+using std::mutex;
+
+#include <vector>
+using std::vector;
+
+#include <string_view>
+using std::string_view;
+
+#include "StringRegex.h"
+
+/*********************************************** HELPERS ***************************************************/
+
+//Limits keeping hostile patterns from taking the stack or the memory
+static const int maxDepth = 1000;
+static const int maxRepeat = 1000;
+static const size_t maxNfaStates = 100000;
+
+//Once the DFA has this many states, it's dropped and built again from the current one
+static const size_t maxDfaStates = 2000;
+
+/* Add the characters of \d, \w or \s to the set */
+static void addClass(bitset<256>& members, char kind)
+{
+	for (unsigned ch = 0; ch < 256; ch++) {
+		bool digit = ch >= '0' && ch <= '9';
+		bool letter = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+		bool space = ch == ' ' || (ch >= '\t' && ch <= '\r');
+		if ((kind == 'd' && digit) || (kind == 'w' && (digit || letter || ch == '_')) || (kind == 's' && space))
+			members.set(ch);
+	}
+}
+
+/* Add the other case of every ASCII letter in the set */
+static void foldCase(bitset<256>& members)
+{
+	for (unsigned ch = 'a'; ch <= 'z'; ch++) {
+		if (members[ch] || members[ch - 'a' + 'A']) {
+			members.set(ch);
+			members.set(ch - 'a' + 'A');
+		}
+	}
+}
+
+/* Read a number of a repetition, return false if there are no digits */
+static bool readCount(string_view pattern, size_t& pos, int& count)
+{
+	size_t start = pos;
+	count = 0;
+	for (; pos < pattern.size() && pattern[pos] >= '0' && pattern[pos] <= '9'; pos++) {
+		if (count <= maxRepeat)
+			count = count * 10 + (pattern[pos] - '0');
+	}
+	return pos != start;
+}
+
+/* Read {n}, {n,} or {n,m} at the given position, return false and leave the position if it isn't one */
+static bool readBounds(string_view pattern, size_t& pos, int& min, int& max)
+{
+	size_t i = pos + 1;
+	if (!readCount(pattern, i, min))
+		return false;
+	max = min;
+	if (i < pattern.size() && pattern[i] == ',') {
+		i++;
+		max = -1;
+		if (i < pattern.size() && pattern[i] != '}' && !readCount(pattern, i, max))
+			return false;
+	}
+	if (i >= pattern.size() || pattern[i] != '}')
+		return false;
+	pos = i + 1;
+	return true;
+}
+
+/*********************************************** PARSER ***************************************************/
+
+/* Read alternatives separated by | */
+int String_Regex::parse_alternate(string_view pattern, size_t& pos, int depth)
+{
+	if (depth > maxDepth)
+		throw invalid_argument("Regex is nested too deeply!");
+	int first = parse_concat(pattern, pos, depth);
+	if (pos >= pattern.size() || pattern[pos] != '|')
+		return first;
+
+	int alternate = add_node(Node::Alternate);
+	nodes[alternate].children.push_back(first);
+	while (pos < pattern.size() && pattern[pos] == '|') {
+		pos++;
+		int next = parse_concat(pattern, pos, depth);
+		nodes[alternate].children.push_back(next);
+	}
+	return alternate;
+}
+
+/* Read repeated atoms one after another, up to | or ) */
+int String_Regex::parse_concat(string_view pattern, size_t& pos, int depth)
+{
+	int concat = add_node(Node::Concat);
+	while (pos < pattern.size() && pattern[pos] != '|' && pattern[pos] != ')') {
+		int atom = parse_atom(pattern, pos, depth);
+		atom = parse_repeat(pattern, pos, atom);
+		nodes[concat].children.push_back(atom);
+	}
+	if (nodes[concat].children.size() == 1)
+		return nodes[concat].children.front();
+	return concat;
+}
+
+/* Read a character, a set, an anchor or a group */
+int String_Regex::parse_atom(string_view pattern, size_t& pos, int depth)
+{
+	const char ch = pattern[pos];
+	int min, max;
+	bitset<256> members;
+	switch (ch) {
+	case '(': {
+		pos++;
+		if (pattern.substr(pos, 2) == "?:")
+			pos += 2;
+		else if (pos < pattern.size() && pattern[pos] == '?')
+			throw invalid_argument("Unsupported group in the regex!");
+		int inner = parse_alternate(pattern, pos, depth + 1);
+		if (pos >= pattern.size() || pattern[pos] != ')')
+			throw invalid_argument("Unmatched ( in the regex!");
+		pos++;
+		return inner;
+	}
+	case '*':
+	case '+':
+	case '?':
+		throw invalid_argument("Nothing to repeat in the regex!");
+	case '{':
+		if (readBounds(pattern, pos, min, max))
+			throw invalid_argument("Nothing to repeat in the regex!");
+		members.set('{');
+		pos++;
+		break;
+	case '[':
+		return add_node(Node::Set, parse_set(pattern, pos));
+	case '.':
+		pos++;
+		return add_node(Node::Set, dotChars);
+	case '^':
+		pos++;
+		return add_node(Node::Begin);
+	case '$':
+		pos++;
+		return add_node(Node::End);
+	case '\\':
+		parse_escape(pattern, pos, members);
+		break;
+	default:
+		members.set(static_cast<unsigned char>(ch));
+		pos++;
+		break;
+	}
+	if (ignoreCase)
+		foldCase(members);
+	return add_node(Node::Set, add_set(members));
+}
+
+/* Read *, +, ? and {n,m} after an atom, and wrap it in them */
+int String_Regex::parse_repeat(string_view pattern, size_t& pos, int atom)
+{
+	for (int count = 0; pos < pattern.size(); count++) {
+		int min = 0, max = -1;
+		const char ch = pattern[pos];
+		if (ch == '*' || ch == '+' || ch == '?') {
+			min = (ch == '+') ? 1 : 0;
+			max = (ch == '?') ? 1 : -1;
+			pos++;
+		}
+		else if (ch != '{' || !readBounds(pattern, pos, min, max)) {
+			break;
+		}
+
+		if (pos < pattern.size() && pattern[pos] == '?')
+			throw invalid_argument("Lazy quantifiers aren't supported, matches are the longest ones!");
+		if (min > maxRepeat || max > maxRepeat)
+			throw invalid_argument("Repetition count is too big!");
+		if (max != -1 && max < min)
+			throw invalid_argument("Repetition bounds are out of order!");
+		if (count > maxDepth)
+			throw invalid_argument("Regex is nested too deeply!");
+
+		int repeat = add_node(Node::Repeat);
+		nodes[repeat].children.push_back(atom);
+		nodes[repeat].min = min;
+		nodes[repeat].max = max;
+		atom = repeat;
+	}
+	return atom;
+}
+
+/* Read the set starting with [ at the given position, with ranges, escapes and ^ negating it, return its index */
+int String_Regex::parse_set(string_view pattern, size_t& pos)
+{
+	const size_t n = pattern.size();
+	size_t i = pos + 1;
+	bool negated = false;
+	if (i < n && pattern[i] == '^') {
+		negated = true;
+		i++;
+	}
+
+	bitset<256> members;
+	for (bool first = true; i < n && (pattern[i] != ']' || first); first = false) {
+		bitset<256> low;
+		if (pattern[i] == '\\')
+			parse_escape(pattern, i, low);
+		else
+			low.set(static_cast<unsigned char>(pattern[i++]));
+		if (low.count() != 1 || i + 1 >= n || pattern[i] != '-' || pattern[i + 1] == ']') {
+			members |= low;
+			continue;
+		}
+
+		i++;
+		bitset<256> high;
+		if (pattern[i] == '\\')
+			parse_escape(pattern, i, high);
+		else
+			high.set(static_cast<unsigned char>(pattern[i++]));
+		unsigned from = 0, to = 0;
+		while (!low[from])
+			from++;
+		while (to < 256 && !high[to])
+			to++;
+		if (high.count() != 1 || to < from)
+			throw invalid_argument("Bad range in the regex set!");
+		for (unsigned ch = from; ch <= to; ch++)
+			members.set(ch);
+	}
+	if (i >= n)
+		throw invalid_argument("Unterminated [ in the regex!");
+	pos = i + 1;
+
+	if (ignoreCase)
+		foldCase(members);
+	if (negated)
+		members.flip();
+	return add_set(members);
+}
+
+/* Read the escape starting with \ at the given position and add its characters to the set */
+void String_Regex::parse_escape(string_view pattern, size_t& pos, bitset<256>& members)
+{
+	if (pos + 1 >= pattern.size())
+		throw invalid_argument("Regex ends with the escape character!");
+	const char ch = pattern[pos + 1];
+	pos += 2;
+
+	bitset<256> chars;
+	switch (ch) {
+	case 'd': case 'w': case 's':
+		addClass(members, ch);
+		return;
+	case 'D': case 'W': case 'S':
+		addClass(chars, static_cast<char>(ch - 'A' + 'a'));
+		members |= ~chars;
+		return;
+	case 'n': members.set('\n'); return;
+	case 't': members.set('\t'); return;
+	case 'r': members.set('\r'); return;
+	case 'f': members.set('\f'); return;
+	case 'v': members.set('\v'); return;
+	case '0': members.set(0); return;
+	case 'x': {
+		unsigned value = 0;
+		for (size_t end = pos + 2; pos < end; pos++) {
+			const char digit = pos < pattern.size() ? pattern[pos] : '\0';
+			if (digit >= '0' && digit <= '9')
+				value = value * 16 + (digit - '0');
+			else if ((digit | 0x20) >= 'a' && (digit | 0x20) <= 'f')
+				value = value * 16 + ((digit | 0x20) - 'a' + 10);
+			else
+				throw invalid_argument("\\x in the regex needs two hex digits!");
+		}
+		members.set(value);
+		return;
+	}
+	default:
+		if ((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'))
+			throw invalid_argument("Unsupported escape in the regex!");
+		members.set(static_cast<unsigned char>(ch));
+	}
+}
+
+/* Add a node to the parsed pattern, return its index */
+int String_Regex::add_node(Node::Kind kind, int set)
+{
+	nodes.push_back(Node{ kind, set, {} });
+	return static_cast<int>(nodes.size() - 1);
+}
+
+/* Add a set of characters, return its index */
+int String_Regex::add_set(bitset<256> members)
+{
+	sets.push_back(members);
+	return static_cast<int>(sets.size() - 1);
+}
+
+/* Find the longest run of single characters among the top nodes of the pattern, every match contains it.
+If the pattern starts with it, after its ^ anchors, every match starts with it too */
+void String_Regex::find_literal(int root)
+{
+	vector<int> items;
+	if (nodes[root].kind == Node::Concat)
+		items = nodes[root].children;
+	else
+		items.push_back(root);
+
+	size_t first = 0;
+	while (first < items.size() && nodes[items[first]].kind == Node::Begin)
+		first++;
+	String run;
+	size_t runStart = first;
+	for (size_t i = first; i <= items.size(); i++) {
+		const Node* node = (i < items.size()) ? &nodes[items[i]] : nullptr;
+		if (node && node->kind == Node::Set && sets[node->set].count() == 1) {
+			unsigned ch = 0;
+			while (!sets[node->set][ch])
+				ch++;
+			if (run.empty())
+				runStart = i;
+			run.push_back(static_cast<char>(ch));
+			continue;
+		}
+		if (run.size() > literal.size()) {
+			literal = run;
+			literalPrefix = (runStart == first);
+		}
+		run.clear();
+	}
+}
+
+/*********************************************** COMPILER ***************************************************/
+
+/* Add a state to the NFA, return its index */
+int String_Regex::add_state(Program& prog, Nfa_State::Kind kind, int out, int out1, int set)
+{
+	if (prog.states.size() >= maxNfaStates)
+		throw invalid_argument("Regex is too big!");
+	prog.states.push_back(Nfa_State{ kind, out, out1, set });
+	return static_cast<int>(prog.states.size() - 1);
+}
+
+/* Build the NFA of the node, backward when it's reversed: concatenations run from the end, and ^ swaps with $ */
+String_Regex::Fragment String_Regex::compile(Program& prog, int node, bool reversed, int depth)
+{
+	if (depth > 2 * maxDepth)
+		throw invalid_argument("Regex is nested too deeply!");
+	auto connect = [&prog](const vector<int>& exits, int target) {
+		for (int exit : exits) {
+			if (exit & 1)
+				prog.states[exit >> 1].out1 = target;
+			else
+				prog.states[exit >> 1].out = target;
+		}
+	};
+	// Put the fragment after the result, the result is empty while its start is -1
+	auto chain = [&connect](Fragment& result, Fragment&& next) {
+		if (result.start == -1) {
+			result = std::move(next);
+			return;
+		}
+		connect(result.exits, next.start);
+		result.exits = std::move(next.exits);
+	};
+
+	const Node::Kind kind = nodes[node].kind;
+	const vector<int>& children = nodes[node].children;
+	Fragment result{ -1, {} };
+	switch (kind) {
+	case Node::Set: {
+		int state = add_state(prog, Nfa_State::Set, -1, -1, nodes[node].set);
+		return Fragment{ state, { state * 2 } };
+	}
+	case Node::Begin:
+	case Node::End: {
+		int state = add_state(prog, (kind == Node::Begin) != reversed ? Nfa_State::Begin : Nfa_State::End);
+		return Fragment{ state, { state * 2 } };
+	}
+	case Node::Concat:
+		for (size_t i = 0; i < children.size(); i++)
+			chain(result, compile(prog, children[reversed ? children.size() - 1 - i : i], reversed, depth + 1));
+		break;
+	case Node::Alternate: {
+		int fork = -1; // Split waiting for the next alternative
+		for (size_t i = 0; i < children.size(); i++) {
+			Fragment next = compile(prog, children[i], reversed, depth + 1);
+			int entry = next.start;
+			if (i + 1 < children.size())
+				entry = add_state(prog, Nfa_State::Split, next.start);
+			if (fork == -1)
+				result.start = entry;
+			else
+				prog.states[fork].out1 = entry;
+			fork = entry;
+			result.exits.insert(result.exits.end(), next.exits.begin(), next.exits.end());
+		}
+		break;
+	}
+	case Node::Repeat: {
+		const int min = nodes[node].min;
+		const int max = nodes[node].max;
+		for (int i = 0; i < min - (max == -1 ? 1 : 0); i++)
+			chain(result, compile(prog, children.front(), reversed, depth + 1));
+		if (max == -1) {
+			// The last required copy loops back to itself, with no required copies the loop can be skipped
+			Fragment body = compile(prog, children.front(), reversed, depth + 1);
+			int fork = add_state(prog, Nfa_State::Split, body.start);
+			connect(body.exits, fork);
+			chain(result, Fragment{ min > 0 ? body.start : fork, { fork * 2 + 1 } });
+		}
+		else {
+			for (int i = min; i < max; i++) {
+				Fragment body = compile(prog, children.front(), reversed, depth + 1);
+				int fork = add_state(prog, Nfa_State::Split, body.start);
+				body.exits.push_back(fork * 2 + 1);
+				chain(result, Fragment{ fork, std::move(body.exits) });
+			}
+		}
+		break;
+	}
+	}
+
+	if (result.start == -1) {
+		int state = add_state(prog, Nfa_State::Jump);
+		return Fragment{ state, { state * 2 } };
+	}
+	return result;
+}
+
+/* Build the NFA of the whole pattern, ending in the match. The unanchored start loops over any character first */
+void String_Regex::compile(Program& prog, int root, bool reversed)
+{
+	Fragment body = compile(prog, root, reversed, 0);
+	int match = add_state(prog, Nfa_State::Match);
+	for (int exit : body.exits) {
+		if (exit & 1)
+			prog.states[exit >> 1].out1 = match;
+		else
+			prog.states[exit >> 1].out = match;
+	}
+	prog.anchored = body.start;
+
+	int any = add_state(prog, Nfa_State::Set, -1, -1, allChars);
+	int loop = add_state(prog, Nfa_State::Split, any, body.start);
+	prog.states[any].out = loop;
+	prog.unanchored = loop;
+	prog.any = any;
+}
+
+/*********************************************** DFA ***************************************************/
+
+/* Follow the NFA from the seeds without reading a character. ^ is crossed only at the beginning of the text,
+$ only at its end, the other $ states are kept, so the end of the text can cross them later.
+Return the states, which read a character, match, or wait for the end, sorted */
+vector<int> String_Regex::closure(const Program& prog, vector<int> seeds, bool atBegin, bool atEnd) const
+{
+	vector<char> seen(prog.states.size());
+	vector<int> states;
+	while (!seeds.empty()) {
+		int index = seeds.back();
+		seeds.pop_back();
+		if (seen[index])
+			continue;
+		seen[index] = 1;
+
+		const Nfa_State& state = prog.states[index];
+		switch (state.kind) {
+		case Nfa_State::Set:
+		case Nfa_State::Match:
+			states.push_back(index);
+			break;
+		case Nfa_State::Split:
+			seeds.push_back(state.out1);
+			seeds.push_back(state.out);
+			break;
+		case Nfa_State::Jump:
+			seeds.push_back(state.out);
+			break;
+		case Nfa_State::Begin:
+			if (atBegin)
+				seeds.push_back(state.out);
+			break;
+		case Nfa_State::End:
+			states.push_back(index);
+			if (atEnd)
+				seeds.push_back(state.out);
+			break;
+		}
+	}
+	sort(states.begin(), states.end());
+	return states;
+}
+
+/* Return the DFA state of the set of NFA states, adding it if it's new */
+int String_Regex::add_state(Dfa& dfa, vector<int>&& states) const
+{
+	auto found = dfa.ids.find(states);
+	if (found != dfa.ids.end())
+		return found->second;
+
+	const Program& prog = program(dfa);
+	vector<int> ends;
+	bool accepting = false;
+	for (int index : states) {
+		if (prog.states[index].kind == Nfa_State::Match)
+			accepting = true;
+		else if (prog.states[index].kind == Nfa_State::End)
+			ends.push_back(prog.states[index].out);
+	}
+	bool acceptingAtEnd = accepting;
+	if (!acceptingAtEnd && !ends.empty())
+		acceptingAtEnd = has_match(prog, closure(prog, std::move(ends), false, true));
+
+	const int id = static_cast<int>(dfa.sets.size());
+	if (states.empty())
+		dfa.dead = id;
+	dfa.accepting.push_back(accepting);
+	dfa.acceptingAtEnd.push_back(acceptingAtEnd);
+	dfa.next.resize(dfa.next.size() + 256, -1);
+	dfa.ids.emplace(states, id);
+	dfa.sets.push_back(std::move(states));
+	return id;
+}
+
+/* Return the state the scan starts from, at the beginning of the text or inside it */
+int String_Regex::start_state(Dfa& dfa, bool atBegin) const
+{
+	int& start = atBegin ? dfa.startAtBegin : dfa.start;
+	if (start == -1) {
+		const Program& prog = program(dfa);
+		start = add_state(dfa, closure(prog, { dfa.anchored ? prog.anchored : prog.unanchored }, atBegin, false));
+	}
+	return start;
+}
+
+/* Build the state after reading the character, step() uses it from then on */
+int String_Regex::add_transition(Dfa& dfa, int state, unsigned char ch) const
+{
+	const size_t slot = static_cast<size_t>(state) * 256 + ch;
+	const Program& prog = program(dfa);
+	vector<int> seeds;
+	for (int index : dfa.sets[state]) {
+		const Nfa_State& nfa = prog.states[index];
+		if (nfa.kind == Nfa_State::Set && sets[nfa.set][ch])
+			seeds.push_back(nfa.out);
+	}
+	vector<int> target = closure(prog, std::move(seeds), false, false);
+
+	// Out of room: start over from the new state, the old ones are built again if they're needed
+	if (dfa.sets.size() >= maxDfaStates && dfa.ids.find(target) == dfa.ids.end()) {
+		reset(dfa);
+		return add_state(dfa, std::move(target));
+	}
+	int next = add_state(dfa, std::move(target));
+	dfa.next[slot] = next;
+	return next;
+}
+
+/* Drop every state of the DFA */
+void String_Regex::reset(Dfa& dfa) const
+{
+	dfa.sets.clear();
+	dfa.ids.clear();
+	dfa.next.clear();
+	dfa.accepting.clear();
+	dfa.acceptingAtEnd.clear();
+	dfa.start = dfa.startAtBegin = dfa.dead = -1;
+}
+
+/* Check if the NFA states hold the match */
+bool String_Regex::has_match(const Program& prog, const vector<int>& states) const noexcept
+{
+	for (int index : states) {
+		if (prog.states[index].kind == Nfa_State::Match)
+			return true;
+	}
+	return false;
+}
+
+/* Check if the pattern matches the empty text */
+bool String_Regex::matches_empty(const Program& prog) const
+{
+	return has_match(prog, closure(prog, { prog.anchored }, true, true));
+}
+
+/* Return where the first match to end, starting at or after the position, ends, or npos if there's none,
+leaving the state of the search there. While the DFA is in its start state, no match is under way,
+so when every match starts with the literal, the scan jumps to its next place */
+size_t String_Regex::first_end(string_view text, size_t pos, int& state) const
+{
+	const size_t n = text.size();
+	const unsigned char* chars = reinterpret_cast<const unsigned char*>(text.data());
+	state = start_state(searcher, pos == 0);
+	if (searcher.accepting[state])
+		return pos;
+	for (size_t i = pos; i < n; i++) {
+		if (literalPrefix && state == start_state(searcher, false)) {
+			i = String::search(text.data(), n, literal.data(), literal.size(), i);
+			if (i == String::npos)
+				return String::npos;
+		}
+		state = step(searcher, state, chars[i]);
+		if (searcher.accepting[state])
+			return i + 1;
+	}
+	return searcher.acceptingAtEnd[state] ? n : String::npos;
+}
+
+/* Return the leftmost position in [pos, end], where a match ending by (end) starts, or npos if there's none.
+The reversed pattern is scanned back from (end), each of its matches is the start of a forward one */
+size_t String_Regex::leftmost_start(string_view text, size_t pos, size_t end) const
+{
+	const unsigned char* chars = reinterpret_cast<const unsigned char*>(text.data());
+	int state = start_state(reverser, end == text.size());
+	size_t best = reverser.accepting[state] ? end : String::npos;
+	for (size_t i = end; i > pos; i--) {
+		state = step(reverser, state, chars[i - 1]);
+		if (reverser.accepting[state])
+			best = i - 1;
+	}
+	if (pos == 0 && reverser.acceptingAtEnd[state])
+		best = 0;
+	return best;
+}
+
+/* Return where the longest match ends, continuing from the state of the anchored DFA at the position,
+or npos if there's none */
+size_t String_Regex::longest_end(string_view text, size_t pos, int state) const
+{
+	const size_t n = text.size();
+	const unsigned char* chars = reinterpret_cast<const unsigned char*>(text.data());
+	size_t last = matcher.accepting[state] ? pos : String::npos;
+	for (size_t i = pos; i < n; i++) {
+		state = step(matcher, state, chars[i]);
+		if (state == matcher.dead)
+			return last;
+		if (matcher.accepting[state])
+			last = i + 1;
+	}
+	return matcher.acceptingAtEnd[state] ? n : last;
+}
+
+/*********************************************** STRING_REGEX FUNCTIONS ***************************************************/
+
+/* Parse the pattern and build its NFA, forward and backward. Throw invalid_argument if the pattern is wrong */
+String_Regex::String_Regex(string_view pattern, bool ignoreCase) : ignoreCase(ignoreCase)
+{
+	bitset<256> any;
+	any.set();
+	add_set(any);
+	any.reset('\n');
+	add_set(any);
+
+	size_t pos = 0;
+	int root = parse_alternate(pattern, pos, 0);
+	if (pos < pattern.size())
+		throw invalid_argument("Unmatched ) in the regex!");
+	find_literal(root);
+	compile(forward, root, false);
+	compile(backward, root, true);
+	nodes.clear();
+	nodes.shrink_to_fit();
+
+	searcher.anchored = false;
+	reverser.reversed = true;
+	reverser.anchored = false;
+}
+
+/* Copy the other regex, with the DFA built so far */
+String_Regex::String_Regex(const String_Regex& regex)
+{
+	*this = regex;
+}
+
+/* Assign the other regex to this one */
+String_Regex& String_Regex::operator=(const String_Regex& regex)
+{
+	if (&regex == this)
+		return *this;
+	lock_guard<mutex> guard(regex.lock);
+	lock_guard<mutex> ownGuard(lock);
+	sets = regex.sets;
+	forward = regex.forward;
+	backward = regex.backward;
+	literal = regex.literal;
+	literalPrefix = regex.literalPrefix;
+	ignoreCase = regex.ignoreCase;
+	matcher = regex.matcher;
+	searcher = regex.searcher;
+	reverser = regex.reverser;
+	return *this;
+}
+
+/* Check if the whole text matches the regex */
+bool String_Regex::matches(string_view text) const
+{
+	if (literalPrefix && (text.size() < literal.size() || memcmp(text.data(), literal.data(), literal.size()) != 0))
+		return false;
+	lock_guard<mutex> guard(lock);
+	if (text.empty())
+		return matches_empty(forward);
+
+	const unsigned char* chars = reinterpret_cast<const unsigned char*>(text.data());
+	int state = start_state(matcher, true);
+	for (size_t i = 0; i < text.size(); i++) {
+		state = step(matcher, state, chars[i]);
+		if (state == matcher.dead)
+			return false;
+	}
+	return matcher.acceptingAtEnd[state];
+}
+
+/* Check if a part of the text matches the regex */
+bool String_Regex::search(string_view text) const
+{
+	if (!literalPrefix && String::search(text.data(), text.size(), literal.data(), literal.size()) == String::npos)
+		return false;
+	lock_guard<mutex> guard(lock);
+	if (text.empty())
+		return matches_empty(forward);
+	int state;
+	return first_end(text, 0, state) != String::npos;
+}
+
+/* Find the leftmost match starting at or after the position, the longest one of those starting there.
+The first match to end tells if there's any, the leftmost match starts before it. The threads of the search
+are followed further without starting new ones, to the last end of a match starting by then.
+From there the reversed pattern finds the leftmost start, and the forward one the longest match from it.
+Every pass stops by that end, so finding the matches one after another doesn't scan the rest of the text each time */
+String_Regex::Match String_Regex::find(string_view text, size_t pos) const
+{
+	const Match none{ String::npos, 0 };
+	if (pos > text.size())
+		return none;
+	if (!literalPrefix && String::search(text.data(), text.size(), literal.data(), literal.size(), pos) == String::npos)
+		return none;
+	lock_guard<mutex> guard(lock);
+	if (text.empty())
+		return matches_empty(forward) ? Match{ 0, 0 } : none;
+	int state;
+	size_t end = first_end(text, pos, state);
+	if (end == String::npos)
+		return none;
+	if (end < text.size()) {
+		vector<int> threads = searcher.sets[state];
+		threads.erase(remove(threads.begin(), threads.end(), forward.any), threads.end());
+		end = longest_end(text, end, add_state(matcher, std::move(threads)));
+	}
+	size_t start = leftmost_start(text, pos, end);
+	return Match{ start, longest_end(text, start, start_state(matcher, start == 0)) - start };
+}
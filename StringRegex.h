@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <bitset>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <string_view>
+
+#include "String.h"
+
+/*********************************************** CLASSES ***************************************************/
+
+/*////////////////////////////////////////// String_Regex class /////////////////////////////////////////////*/
+
+/* Regular expression without backreferences, compiled once and matched against many texts in linear time.
+Understands literals, ., [sets] with ranges and ^, the \d \w \s escapes (and their negations), groups (...) and (?:...),
+alternation |, repetition * + ? {n} {n,} {n,m}, and the ^ and $ anchors, standing for the start and the end of the text.
+The pattern becomes an NFA, from which a DFA is built lazily, a state at a time, as the texts need it.
+A literal every match contains is looked up with String::search() first, texts without it are rejected right away.
+When every match starts with it, the search jumps from one place of that literal to the next one.
+Matches are leftmost-longest, as in POSIX. Calls on one regex from many threads take turns, as they share the DFA */
+class String_Regex
+{
+private:
+	/* Node of the parsed pattern */
+	struct Node
+	{
+		enum Kind { Set, Concat, Alternate, Repeat, Begin, End } kind;
+		int set = -1; // Index of the characters, for a Set
+		std::vector<int> children;
+		int min = 0; // Bounds of a Repeat, max is -1 when there's none
+		int max = -1;
+	};
+	/* State of the NFA: one of a set of characters, a fork, a jump, an anchor, or the match */
+	struct Nfa_State
+	{
+		enum Kind { Set, Split, Jump, Begin, End, Match } kind;
+		int out = -1;
+		int out1 = -1; // Second way of a Split
+		int set = -1;
+	};
+	/* Part of the NFA being built, with the exits still left to connect */
+	struct Fragment
+	{
+		int start;
+		std::vector<int> exits; // State * 2, plus 1 for its out1
+	};
+	/* NFA of the pattern, read forward or, to find where a match starts, backward */
+	struct Program
+	{
+		std::vector<Nfa_State> states;
+		int anchored = -1; // Start, matching right at the current position
+		int unanchored = -1; // Start, matching anywhere after the current position
+		int any = -1; // State of the unanchored start, that reads a character before starting again
+	};
+	/* DFA built from a Program as it's used, each state is the set of NFA states the text can be in.
+	The states are dropped, once there are too many, to keep the memory bounded */
+	struct Dfa
+	{
+		bool reversed = false;
+		bool anchored = true;
+		std::vector<std::vector<int>> sets;
+		std::map<std::vector<int>, int> ids;
+		std::vector<int> next; // 256 transitions of every state, -1 until they're needed
+		std::vector<char> accepting; // Match without reading more
+		std::vector<char> acceptingAtEnd; // Match at the end of the text
+		int start = -1; // State at the start of a scan, inside the text
+		int startAtBegin = -1; // State at the start of a scan, at the beginning of the text
+		int dead = -1; // State, from which nothing matches
+	};
+	static constexpr int allChars = 0; // Index of the set of every character, read by the unanchored start
+	static constexpr int dotChars = 1; // Index of the set of ., every character but \n
+
+	//Helping functions of the parser
+	int parse_alternate(std::string_view pattern, size_t& pos, int depth);
+	int parse_concat(std::string_view pattern, size_t& pos, int depth);
+	int parse_atom(std::string_view pattern, size_t& pos, int depth);
+	int parse_repeat(std::string_view pattern, size_t& pos, int atom);
+	int parse_set(std::string_view pattern, size_t& pos);
+	void parse_escape(std::string_view pattern, size_t& pos, std::bitset<256>& members);
+	int add_node(Node::Kind kind, int set = -1);
+	int add_set(std::bitset<256> members);
+	void find_literal(int root);
+
+	//Helping functions of the compiler
+	int add_state(Program& prog, Nfa_State::Kind kind, int out = -1, int out1 = -1, int set = -1);
+	Fragment compile(Program& prog, int node, bool reversed, int depth);
+	void compile(Program& prog, int root, bool reversed);
+
+	//Helping functions of the DFA
+	const Program& program(const Dfa& dfa) const noexcept { return dfa.reversed ? backward : forward; }
+	std::vector<int> closure(const Program& prog, std::vector<int> seeds, bool atBegin, bool atEnd) const;
+	int add_state(Dfa& dfa, std::vector<int>&& states) const;
+	int start_state(Dfa& dfa, bool atBegin) const;
+	int step(Dfa& dfa, int state, unsigned char ch) const
+	{
+		const int next = dfa.next[static_cast<size_t>(state) * 256 + ch];
+		return next != -1 ? next : add_transition(dfa, state, ch);
+	}
+	int add_transition(Dfa& dfa, int state, unsigned char ch) const;
+	void reset(Dfa& dfa) const;
+	bool has_match(const Program& prog, const std::vector<int>& states) const noexcept;
+	bool matches_empty(const Program& prog) const;
+	size_t first_end(std::string_view text, size_t pos, int& state) const;
+	size_t leftmost_start(std::string_view text, size_t pos, size_t end) const;
+	size_t longest_end(std::string_view text, size_t pos, int state) const;
+public:
+	/* Place of a match in the text, position is npos when there's none */
+	struct Match
+	{
+		size_t position;
+		size_t length;
+	};
+
+	//Constructors
+	explicit String_Regex(std::string_view pattern, bool ignoreCase = false);
+	String_Regex(const String_Regex& regex);
+	String_Regex& operator=(const String_Regex& regex);
+
+	//Matching the whole text
+	bool matches(std::string_view text) const;
+	bool matches(const String& str) const { return matches(std::string_view(str.data(), str.size())); }
+	bool matches(const char* cptr) const { return matches(std::string_view(cptr)); }
+
+	//Searching inside the text
+	bool search(std::string_view text) const;
+	bool search(const String& str) const { return search(std::string_view(str.data(), str.size())); }
+	bool search(const char* cptr) const { return search(std::string_view(cptr)); }
+	Match find(std::string_view text, size_t pos = 0) const;
+	Match find(const String& str, size_t pos = 0) const { return find(std::string_view(str.data(), str.size()), pos); }
+	Match find(const char* cptr, size_t pos = 0) const { return find(std::string_view(cptr), pos); }
+	bool operator()(std::string_view text) const { return search(text); }
+
+	//Information
+	const String& required_literal() const noexcept { return literal; }
+	bool ignores_case() const noexcept { return ignoreCase; }
+private:
+	std::vector<Node> nodes;
+	std::vector<std::bitset<256>> sets;
+	Program forward;
+	Program backward;
+	String literal; // Text every match contains
+	bool literalPrefix = false; // Every match starts with it
+	bool ignoreCase = false;
+
+	mutable Dfa matcher; // Forward, anchored, for matches() and the end of a match
+	mutable Dfa searcher; // Forward, unanchored, for search()
+	mutable Dfa reverser; // Backward, unanchored, for the start of a match
+	mutable std::mutex lock;
+};
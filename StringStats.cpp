@@ -0,0 +1,256 @@
+#include "StringStats.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+using std::vector;
+using std::memory_order_relaxed;
+
+/*********************************************** HELPERS ***************************************************/
+
+/* Places of the counters, in the arrays kept for every thread */
+enum Counter : size_t
+{
+	Allocations, Deallocations, Reallocations, Bytes_Allocated, Bytes_Freed, Copies, Bytes_Copied,
+	Allocation_Sizes, Copy_Sizes = Allocation_Sizes + String_Stats::buckets,
+	Counter_Count = Copy_Sizes + String_Stats::buckets
+};
+
+/* Counters of one thread. Only the owning thread writes (values), so a load and a store are enough,
+the atomics only keep snapshot() from racing with it */
+struct Thread_Counters
+{
+	atomic<uint64_t> values[Counter_Count] = {};
+	atomic<uint64_t> base[Counter_Count] = {}; // Values at the last reset()
+
+	void add(size_t index, uint64_t value) noexcept
+	{
+		values[index].store(values[index].load(memory_order_relaxed) + value, memory_order_relaxed);
+	}
+};
+
+/* All the threads' counters, never destroyed so Strings freed during shutdown can still be counted */
+struct Registry
+{
+	mutex lock;
+	vector<Thread_Counters*> threads;
+	uint64_t retired[Counter_Count] = {}; // Totals of the threads that have finished
+	uint64_t base[Counter_Count] = {}; // Totals at the last reset()
+};
+
+static Registry& registry()
+{
+	static Registry* instance = new Registry;
+	return *instance;
+}
+
+static thread_local Thread_Counters* current = nullptr;
+static thread_local bool finished = false;
+
+/* Move the finished thread's counters into the retired totals */
+struct Thread_Guard
+{
+	~Thread_Guard()
+	{
+		Registry& reg = registry();
+		lock_guard<mutex> guard(reg.lock);
+		for (size_t i = 0; i < Counter_Count; i++)
+			reg.retired[i] += current->values[i].load(memory_order_relaxed);
+		reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(), current));
+		delete current;
+		current = nullptr;
+		finished = true;
+	}
+};
+
+/* Return this thread's counters, or nullptr once the thread is shutting down */
+static Thread_Counters* counters()
+{
+	if (current || finished)
+		return current;
+	current = new Thread_Counters;
+	{
+		Registry& reg = registry();
+		lock_guard<mutex> guard(reg.lock);
+		reg.threads.push_back(current);
+	}
+	static thread_local Thread_Guard guard;
+	(void) guard;
+	return current;
+}
+
+/* Add to this thread's counter, or straight to the retired totals after the thread's counters are gone */
+static void add(size_t index, uint64_t value) noexcept
+{
+	if (Thread_Counters* own = counters()) {
+		own->add(index, value);
+		return;
+	}
+	Registry& reg = registry();
+	lock_guard<mutex> guard(reg.lock);
+	reg.retired[index] += value;
+}
+
+/* Fill the public fields from the array of counters */
+static String_Stats fromCounters(const uint64_t* values)
+{
+	String_Stats stats;
+	stats.allocations = values[Allocations];
+	stats.deallocations = values[Deallocations];
+	stats.reallocations = values[Reallocations];
+	stats.bytesAllocated = values[Bytes_Allocated];
+	stats.bytesFreed = values[Bytes_Freed];
+	stats.copies = values[Copies];
+	stats.bytesCopied = values[Bytes_Copied];
+	for (size_t i = 0; i < String_Stats::buckets; i++) {
+		stats.allocationSizes[i] = values[Allocation_Sizes + i];
+		stats.copySizes[i] = values[Copy_Sizes + i];
+	}
+	return stats;
+}
+
+/*********************************************** STRING_STATS FUNCTIONS ***************************************************/
+
+/* Return the index of the histogram bucket for the size, or (buckets) if it's larger than all of them */
+size_t String_Stats::bucket(size_t bytes) noexcept
+{
+	size_t i = 0;
+	while (i < buckets && (size_t(1) << i) < bytes)
+		i++;
+	return i;
+}
+
+/* Count the new buffer, (moved) is the number of characters taken over from the old buffer, if there was one */
+void String_Stats::record_allocation(size_t bytes, size_t moved) noexcept
+{
+	add(Allocations, 1);
+	add(Bytes_Allocated, bytes);
+	size_t i = bucket(bytes);
+	if (i < buckets)
+		add(Allocation_Sizes + i, 1);
+	if (moved) {
+		add(Reallocations, 1);
+		record_copy(moved);
+	}
+}
+
+/* Count the freed buffer */
+void String_Stats::record_deallocation(size_t bytes) noexcept
+{
+	add(Deallocations, 1);
+	add(Bytes_Freed, bytes);
+}
+
+/* Count the copy of (bytes) characters */
+void String_Stats::record_copy(size_t bytes) noexcept
+{
+	add(Copies, 1);
+	add(Bytes_Copied, bytes);
+	size_t i = bucket(bytes);
+	if (i < buckets)
+		add(Copy_Sizes + i, 1);
+}
+
+/* Return the counters of all threads added together, since the last reset() */
+String_Stats String_Stats::snapshot()
+{
+	Registry& reg = registry();
+	lock_guard<mutex> guard(reg.lock);
+	uint64_t totals[Counter_Count];
+	for (size_t i = 0; i < Counter_Count; i++) {
+		totals[i] = reg.retired[i] - reg.base[i];
+		for (Thread_Counters* thread : reg.threads)
+			totals[i] += thread->values[i].load(memory_order_relaxed);
+	}
+	return fromCounters(totals);
+}
+
+/* Return the counters of the calling thread, since the last reset() */
+String_Stats String_Stats::thread_snapshot()
+{
+	uint64_t totals[Counter_Count] = {};
+	if (Thread_Counters* own = counters()) {
+		for (size_t i = 0; i < Counter_Count; i++)
+			totals[i] = own->values[i].load(memory_order_relaxed) - own->base[i].load(memory_order_relaxed);
+	}
+	return fromCounters(totals);
+}
+
+/* Start counting from zero again, both in snapshot() and thread_snapshot() */
+void String_Stats::reset()
+{
+	Registry& reg = registry();
+	lock_guard<mutex> guard(reg.lock);
+	for (size_t i = 0; i < Counter_Count; i++) {
+		uint64_t total = reg.retired[i];
+		for (Thread_Counters* thread : reg.threads) {
+			uint64_t value = thread->values[i].load(memory_order_relaxed);
+			thread->base[i].store(value, memory_order_relaxed);
+			total += value;
+		}
+		reg.base[i] = total;
+	}
+}
+
+/*********************************************** PROMETHEUS EXPORT ***************************************************/
+
+/* Write one counter in the Prometheus text format */
+static void writeCounter(FILE* file, const char* name, const char* help, uint64_t value)
+{
+	std::fprintf(file, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n", name, help, name, name, (unsigned long long) value);
+}
+
+/* Write one histogram in the Prometheus text format, its buckets are cumulative */
+static void writeHistogram(FILE* file, const char* name, const char* help, const uint64_t* counts,
+	uint64_t count, uint64_t sum)
+{
+	std::fprintf(file, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+	uint64_t cumulative = 0;
+	for (size_t i = 0; i < String_Stats::buckets; i++) {
+		cumulative += counts[i];
+		std::fprintf(file, "%s_bucket{le=\"%llu\"} %llu\n", name, 1ull << i, (unsigned long long) cumulative);
+	}
+	std::fprintf(file, "%s_bucket{le=\"+Inf\"} %llu\n", name, (unsigned long long) count);
+	std::fprintf(file, "%s_sum %llu\n%s_count %llu\n", name, (unsigned long long) sum, name, (unsigned long long) count);
+}
+
+/* Write the counters to the file in the Prometheus text format, replacing it in one step,
+return false if the file couldn't be written */
+bool String_Stats::write_prometheus(const char* path) const
+{
+	std::string temp = std::string(path) + ".tmp";
+	FILE* file = std::fopen(temp.c_str(), "w");
+	if (!file)
+		return false;
+
+	writeCounter(file, "string_allocations_total", "Buffers allocated by String.", allocations);
+	writeCounter(file, "string_deallocations_total", "Buffers freed by String.", deallocations);
+	writeCounter(file, "string_reallocations_total", "Buffers replaced by String while keeping the text.", reallocations);
+	writeCounter(file, "string_allocated_bytes_total", "Bytes allocated by String.", bytesAllocated);
+	writeCounter(file, "string_freed_bytes_total", "Bytes freed by String.", bytesFreed);
+	writeCounter(file, "string_copies_total", "String copies, including moves done by reallocations.", copies);
+	writeCounter(file, "string_copied_bytes_total", "Bytes copied by String.", bytesCopied);
+	writeHistogram(file, "string_allocation_size_bytes", "Sizes of the buffers allocated by String.",
+		allocationSizes, allocations, bytesAllocated);
+	writeHistogram(file, "string_copy_size_bytes", "Sizes of the copies made by String.",
+		copySizes, copies, bytesCopied);
+
+	bool written = (std::fflush(file) == 0);
+	written = (std::fclose(file) == 0) && written;
+#ifdef _WIN32
+	if (written)
+		std::remove(path);
+#endif
+	if (!written || std::rename(temp.c_str(), path) != 0) {
+		std::remove(temp.c_str());
+		return false;
+	}
+	return true;
+}
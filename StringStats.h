@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* Counting is compiled in only with STRING_INSTRUMENT defined, otherwise the hooks in String disappear */
+#ifdef STRING_INSTRUMENT
+#define STRING_RECORD(call) String_Stats::call
+#else
+#define STRING_RECORD(call) ((void) 0)
+#endif
+
+/*********************************************** CLASSES ***************************************************/
+
+/*///////////////////////////////////////// String_Stats class ////////////////////////////////////////////*/
+
+/* Counters of the memory work done by String. Every thread counts into its own copy,
+snapshot() adds them together */
+struct String_Stats
+{
+	//Histogram bucket (i) counts the sizes up to 2^i bytes, larger ones are only in the totals
+	static const size_t buckets = 32;
+
+	uint64_t allocations = 0; // Buffers allocated
+	uint64_t deallocations = 0; // Buffers freed
+	uint64_t reallocations = 0; // Buffers replaced while keeping the text, a subset of allocations
+	uint64_t bytesAllocated = 0;
+	uint64_t bytesFreed = 0;
+	uint64_t copies = 0; // Whole copies of a String, and the moves done by reallocations
+	uint64_t bytesCopied = 0;
+	uint64_t allocationSizes[buckets] = {};
+	uint64_t copySizes[buckets] = {};
+
+	//Reading and resetting
+	static String_Stats snapshot();
+	static String_Stats thread_snapshot();
+	static void reset();
+
+	//Exporting
+	bool write_prometheus(const char* path) const;
+
+	//Recording, called by String
+	static void record_allocation(size_t bytes, size_t moved) noexcept;
+	static void record_deallocation(size_t bytes) noexcept;
+	static void record_copy(size_t bytes) noexcept;
+
+	static size_t bucket(size_t bytes) noexcept;
+};
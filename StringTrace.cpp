@@ -0,0 +1,245 @@
+#include "StringTrace.h"
+
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <execinfo.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#define STRING_TRACE_EXECINFO
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+using std::map;
+using std::vector;
+using std::string;
+using std::memory_order_relaxed;
+
+/*********************************************** HELPERS ***************************************************/
+
+/* Estimated allocations and bytes of one call stack */
+struct Site
+{
+	double count = 0;
+	double bytes = 0;
+};
+
+/* The samples of all threads, never destroyed so Strings freed during shutdown can't reach a dead map */
+struct Trace_State
+{
+	mutex lock;
+	map<vector<void*>, Site> sites;
+	size_t samples = 0;
+};
+
+static Trace_State& state()
+{
+	static Trace_State* instance = new Trace_State;
+	return *instance;
+}
+
+static atomic<bool> enabled(false);
+static atomic<size_t> meanGap(512 * 1024);
+static atomic<unsigned> generation(0); // Changed by start(), so every thread draws a new gap
+
+static thread_local long long countdown = 0;
+static thread_local unsigned seenGeneration = ~0u;
+static thread_local bool sampling = false;
+
+/* Draw the number of bytes until the next sample. Exponential gaps make every byte equally likely to be sampled,
+so allocations of a regular size can't always fall between the samples */
+static long long nextGap()
+{
+	static thread_local std::minstd_rand random((unsigned) (std::uintptr_t) &countdown);
+	double u = std::generate_canonical<double, 32>(random);
+	return (long long) (-std::log(1.0 - u) * (double) meanGap.load(memory_order_relaxed)) + 1;
+}
+
+/* Capture the return addresses of the current call stack, return their count */
+static size_t captureStack(void** frames, size_t max)
+{
+#if defined(STRING_TRACE_EXECINFO)
+	int count = backtrace(frames, (int) max);
+	return (count > 0) ? (size_t) count : 0;
+#elif defined(_WIN32)
+	return CaptureStackBackTrace(0, (DWORD) max, frames, nullptr);
+#else
+	(void) frames;
+	(void) max;
+	return 0;
+#endif
+}
+
+/* Return a readable name of the code at the address */
+static string symbolize(void* address)
+{
+	char buffer[64];
+#if defined(STRING_TRACE_EXECINFO)
+	Dl_info info;
+	// Return addresses point after the call, step back into it so inlined and tail frames resolve right
+	void* inside = (char*) address - 1;
+	if (dladdr(inside, &info) && info.dli_sname) {
+		int status = 0;
+		char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+		string name = (status == 0 && demangled) ? demangled : info.dli_sname;
+		std::free(demangled);
+		return name;
+	}
+	if (dladdr(inside, &info) && info.dli_fname) {
+		const char* file = info.dli_fname;
+		for (const char* p = file; *p; p++) {
+			if (*p == '/')
+				file = p + 1;
+		}
+		std::snprintf(buffer, sizeof(buffer), "+0x%llx", (unsigned long long) ((char*) address - (char*) info.dli_fbase));
+		return string(file) + buffer;
+	}
+#endif
+	std::snprintf(buffer, sizeof(buffer), "0x%llx", (unsigned long long) (std::uintptr_t) address);
+	return buffer;
+}
+
+/*********************************************** STRING_TRACE FUNCTIONS ***************************************************/
+
+/* Start sampling about one allocation per (sampleBytes) bytes, keeping the samples taken so far */
+void String_Trace::start(size_t sampleBytes)
+{
+	meanGap.store(sampleBytes ? sampleBytes : 1, memory_order_relaxed);
+	generation.fetch_add(1, memory_order_relaxed);
+	enabled.store(true, memory_order_relaxed);
+}
+
+/* Stop sampling, the samples stay until reset() */
+void String_Trace::stop() noexcept
+{
+	enabled.store(false, memory_order_relaxed);
+}
+
+/* Check if the allocations are being sampled */
+bool String_Trace::active() noexcept
+{
+	return enabled.load(memory_order_relaxed);
+}
+
+/* Forget all the samples */
+void String_Trace::reset()
+{
+	Trace_State& st = state();
+	lock_guard<mutex> guard(st.lock);
+	st.sites.clear();
+	st.samples = 0;
+}
+
+/* Return the number of samples taken */
+size_t String_Trace::samples()
+{
+	Trace_State& st = state();
+	lock_guard<mutex> guard(st.lock);
+	return st.samples;
+}
+
+/* Count the allocated bytes towards the next sample, cheap until a sample is due */
+void String_Trace::record_allocation(size_t bytes) noexcept
+{
+	if (!enabled.load(memory_order_relaxed))
+		return;
+	unsigned current = generation.load(memory_order_relaxed);
+	if (seenGeneration != current) {
+		seenGeneration = current;
+		countdown = nextGap();
+	}
+	countdown -= (long long) bytes;
+	if (countdown > 0)
+		return;
+	countdown = nextGap();
+	sample(bytes);
+}
+
+/* Remember the call stack of the allocation, weighted by the bytes and allocations it stands for */
+void String_Trace::sample(size_t bytes) noexcept
+{
+	if (sampling || bytes == 0)
+		return;
+	sampling = true;
+	try {
+		void* frames[max_frames];
+		size_t count = captureStack(frames, max_frames);
+		// An allocation of (bytes) is sampled with probability 1 - e^(-bytes / mean), divide it out
+		double probability = 1.0 - std::exp(-(double) bytes / (double) meanGap.load(memory_order_relaxed));
+		double weight = 1.0 / probability;
+
+		Trace_State& st = state();
+		lock_guard<mutex> guard(st.lock);
+		Site& site = st.sites[vector<void*>(frames, frames + count)];
+		site.count += weight;
+		site.bytes += weight * (double) bytes;
+		st.samples++;
+	}
+	catch (...) {
+		// Running out of memory while tracing only loses the sample
+	}
+	sampling = false;
+}
+
+/* Write one line per call stack, "outermost;...;innermost bytes", return false if the file couldn't be written */
+bool String_Trace::write_folded(const char* path)
+{
+	map<vector<void*>, Site> sites;
+	{
+		Trace_State& st = state();
+		lock_guard<mutex> guard(st.lock);
+		sites = st.sites;
+	}
+
+	// Stacks that only differ in addresses inside the same functions end up on one line
+	map<void*, string> names;
+	map<string, double> lines;
+	for (const auto& entry : sites) {
+		const vector<void*>& frames = entry.first;
+		vector<string> stack;
+		for (void* frame : frames) {
+			auto found = names.find(frame);
+			if (found == names.end())
+				found = names.emplace(frame, symbolize(frame)).first;
+			stack.push_back(found->second);
+		}
+		// Leave out the tracer, and whatever it called to take the backtrace
+		size_t first = 0;
+		for (size_t i = 0; i < stack.size(); i++) {
+			if (stack[i].compare(0, 14, "String_Trace::") == 0)
+				first = i + 1;
+		}
+
+		string line;
+		for (size_t i = stack.size(); i-- > first;) {
+			string& name = stack[i];
+			for (char& ch : name) {
+				if (ch == ';' || ch == '\n')
+					ch = ':';
+			}
+			if (!line.empty())
+				line += ';';
+			line += name;
+		}
+		lines[line] += entry.second.bytes;
+	}
+
+	FILE* file = std::fopen(path, "w");
+	if (!file)
+		return false;
+	for (const auto& line : lines)
+		std::fprintf(file, "%s %llu\n", line.first.c_str(), (unsigned long long) (line.second + 0.5));
+	return std::fclose(file) == 0;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* Tracing is part of the STRING_INSTRUMENT build, and is started at run time with String_Trace::start() */
+#ifdef STRING_INSTRUMENT
+#define STRING_TRACE(call) String_Trace::call
+#else
+#define STRING_TRACE(call) ((void) 0)
+#endif
+
+/*********************************************** CLASSES ***************************************************/
+
+/*///////////////////////////////////////// String_Trace class ////////////////////////////////////////////*/
+
+/* Samples String's allocations, about one per (sampleBytes) allocated bytes, remembers the call stack of every
+sample and writes them as folded stacks, that flamegraph.pl, speedscope and inferno read */
+class String_Trace
+{
+public:
+	static const size_t max_frames = 32;
+
+	//Control
+	static void start(size_t sampleBytes = 512 * 1024);
+	static void stop() noexcept;
+	static bool active() noexcept;
+	static void reset();
+
+	//Output
+	static bool write_folded(const char* path);
+	static size_t samples();
+
+	//Recording, called by String
+	static void record_allocation(size_t bytes) noexcept;
+
+private:
+	static void sample(size_t bytes) noexcept;
+};
@@ -0,0 +1,224 @@
+#include <cstring>
+using std::memcpy;
+
+#include <stdexcept>
+using std::out_of_range;
+using std::runtime_error;
+
+#include <memory>
+using std::allocator;
+
+#include <new>
+
+#include "StringVector.h"
+
+allocator<String> StringVector::alloc;
+
+/*********************************************** HELPERS ***************************************************/
+
+/* Return the capacity to grow to, to fit (n) Strings, growing geometrically */
+size_t StringVector::next_capacity(size_t n) const noexcept
+{
+	size_t newCap = cap * 2;
+	if (newCap < n)
+		newCap = n;
+	if (newCap < 8)
+		newCap = 8;
+	return newCap;
+}
+
+/* Move the Strings to a new buffer of (newCap) Strings */
+void StringVector::relocate(size_t newCap)
+{
+	relocate(allocate(newCap), newCap);
+}
+
+/* Move the Strings to the given buffer of (newCap) Strings and free the old one. Trivially relocatable Strings
+are copied byte by byte, the old ones aren't destroyed, as the new ones own their text now */
+void StringVector::relocate(String* newItems, size_t newCap) noexcept
+{
+	if constexpr (is_trivially_relocatable<String>::value) {
+		if (sz)
+			memcpy(static_cast<void*>(newItems), static_cast<const void*>(items), sz * sizeof(String));
+	}
+	else {
+		for (size_t i = 0; i < sz; i++) {
+			::new (static_cast<void*>(newItems + i)) String(std::move(items[i]));
+			items[i].~String();
+		}
+	}
+	deallocate();
+	items = newItems;
+	cap = newCap;
+}
+
+/*********************************************** STRINGVECTOR FUNCTIONS ***************************************************/
+
+/* Copy every String of the other vector */
+StringVector::StringVector(const StringVector& vec)
+{
+	if (vec.sz == 0)
+		return;
+	items = allocate(vec.sz);
+	cap = vec.sz;
+	try {
+		for (; sz < vec.sz; sz++)
+			::new (static_cast<void*>(items + sz)) String(vec.items[sz]);
+	}
+	catch (...) {
+		clear();
+		deallocate();
+		throw;
+	}
+}
+
+/* Move the buffer from the other vector */
+StringVector::StringVector(StringVector&& vec) noexcept : items(vec.items), sz(vec.sz), cap(vec.cap)
+{
+	vec.items = nullptr;
+	vec.sz = vec.cap = 0;
+}
+
+/* Destroy the Strings and free the buffer */
+StringVector::~StringVector()
+{
+	clear();
+	deallocate();
+}
+
+/* Assign the other vector to this one */
+StringVector& StringVector::operator=(const StringVector& vec)
+{
+	if (&vec != this) {
+		StringVector copy(vec);
+		swap(copy);
+	}
+	return *this;
+}
+
+/* Move the other vector to this one */
+StringVector& StringVector::operator=(StringVector&& vec) noexcept
+{
+	if (&vec != this) {
+		StringVector moved(std::move(vec));
+		swap(moved);
+	}
+	return *this;
+}
+
+/* Destroy every String, keeping the buffer */
+void StringVector::clear() noexcept
+{
+	for (String* it = items + sz; it != items; )
+		(--it)->~String();
+	sz = 0;
+}
+
+/* Make room for at least (n) Strings */
+void StringVector::reserve(size_t n)
+{
+	if (n > cap)
+		relocate(n);
+}
+
+/* Free the room after the last String */
+void StringVector::shrink_to_fit()
+{
+	if (cap == sz)
+		return;
+	if (sz == 0) {
+		deallocate();
+		items = nullptr;
+		cap = 0;
+		return;
+	}
+	relocate(sz);
+}
+
+/* Return reference to the String at the given position */
+String& StringVector::operator[](size_t n)
+{
+	if (n >= sz)
+		throw out_of_range("Index is out of the range!");
+	return items[n];
+}
+
+/* Return reference to the const String at the given position */
+const String& StringVector::operator[](size_t n) const
+{
+	if (n >= sz)
+		throw out_of_range("Index is out of the range!");
+	return items[n];
+}
+
+/* Return reference to the last String, if the vector is empty, throw runtime_error */
+String& StringVector::back()
+{
+	if (empty())
+		throw runtime_error("back() used on empty StringVector!");
+	return items[sz - 1];
+}
+
+/* Return reference to the last, const String, if the vector is empty, throw runtime_error */
+const String& StringVector::back() const
+{
+	if (empty())
+		throw runtime_error("back() used on empty StringVector!");
+	return items[sz - 1];
+}
+
+/* Return reference to the first String, if the vector is empty, throw runtime_error */
+String& StringVector::front()
+{
+	if (empty())
+		throw runtime_error("front() used on empty StringVector!");
+	return items[0];
+}
+
+/* Return reference to the first, const String, if the vector is empty, throw runtime_error */
+const String& StringVector::front() const
+{
+	if (empty())
+		throw runtime_error("front() used on empty StringVector!");
+	return items[0];
+}
+
+/* Destroy the last String, if the vector is empty, throw runtime_error */
+void StringVector::pop_back()
+{
+	if (empty())
+		throw runtime_error("pop_back() used on empty StringVector!");
+	items[--sz].~String();
+}
+
+/* Swap the vectors */
+void StringVector::swap(StringVector& vec) noexcept
+{
+	std::swap(items, vec.items);
+	std::swap(sz, vec.sz);
+	std::swap(cap, vec.cap);
+}
+
+/* Check if both vectors hold the same Strings */
+bool operator==(const StringVector& lhs, const StringVector& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+	for (size_t i = 0; i < lhs.size(); i++) {
+		if (lhs.data()[i] != rhs.data()[i])
+			return false;
+	}
+	return true;
+}
+
+/* Check if the vectors hold different Strings */
+bool operator!=(const StringVector& lhs, const StringVector& rhs)
+{
+	return !(lhs == rhs);
+}
+
+/* Swap the vectors */
+void swap(StringVector& lhs, StringVector& rhs) noexcept
+{
+	lhs.swap(rhs);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <string_view>
+
+#include "String.h"
+
+/*********************************************** CLASSES ***************************************************/
+
+/*////////////////////////////////////////// StringVector class /////////////////////////////////////////////*/
+
+/* Growable array of Strings. When it grows, the Strings are relocated by copying their bytes (see is_trivially_relocatable),
+instead of moving and destroying them one by one, so growing costs one memcpy() of the old buffer */
+class StringVector
+{
+private:
+	//Helping functions
+	void relocate(size_t newCap);
+	void relocate(String* newItems, size_t newCap) noexcept;
+	size_t next_capacity(size_t n) const noexcept;
+	static String* allocate(size_t n) { return alloc.allocate(n); }
+	void deallocate() { if (items) alloc.deallocate(items, cap); }
+public:
+	//Types
+	typedef String value_type;
+	typedef size_t size_type;
+	typedef String& reference;
+	typedef const String& const_reference;
+	typedef String* iterator;
+	typedef const String* const_iterator;
+
+public:
+	//Constructors, Destructor
+	StringVector() = default;
+	StringVector(const StringVector& vec);
+	StringVector(StringVector&& vec) noexcept;
+	~StringVector();
+
+	//Assignment overloads
+	StringVector& operator=(const StringVector& vec);
+	StringVector& operator=(StringVector&& vec) noexcept;
+
+	//Capacity
+	size_t size() const noexcept { return sz; }
+	size_t capacity() const noexcept { return cap; }
+	bool empty() const noexcept { return sz == 0; }
+
+	void clear() noexcept;
+	void reserve(size_t n);
+	void shrink_to_fit();
+
+	//Element access
+	String& operator[](size_t n);
+	const String& operator[](size_t n) const;
+	String& at(size_t n) { return (*this)[n]; }
+	const String& at(size_t n) const { return (*this)[n]; }
+	String& back();
+	const String& back() const;
+	String& front();
+	const String& front() const;
+	String* data() noexcept { return items; }
+	const String* data() const noexcept { return items; }
+
+	//Iterators
+	iterator begin() noexcept { return items; }
+	const_iterator begin() const noexcept { return items; }
+	iterator end() noexcept { return items + sz; }
+	const_iterator end() const noexcept { return items + sz; }
+
+	//Modifiers
+	void push_back(const String& str) { emplace_back(str); }
+	void push_back(String&& str) { emplace_back(std::move(str)); }
+	template<typename... Args> String& emplace_back(Args&&... args);
+	template<typename Range> void emplace_back_all(const Range& views);
+	void pop_back();
+	void swap(StringVector& vec) noexcept;
+private:
+	static std::allocator<String> alloc;
+	String* items = nullptr;
+	size_t sz = 0;
+	size_t cap = 0;
+};
+
+/*********************************************** TEMPLATE FUNCTIONS ***************************************************/
+
+/* Construct a String from the arguments at the end. When the vector grows, the String is made in the new buffer first,
+so the arguments may refer to the Strings of this vector */
+template<typename... Args>
+String& StringVector::emplace_back(Args&&... args)
+{
+	if (sz == cap) {
+		size_t newCap = next_capacity(sz + 1);
+		String* newItems = allocate(newCap);
+		try {
+			::new (static_cast<void*>(newItems + sz)) String(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			alloc.deallocate(newItems, newCap);
+			throw;
+		}
+		relocate(newItems, newCap);
+	}
+	else {
+		::new (static_cast<void*>(items + sz)) String(std::forward<Args>(args)...);
+	}
+	return items[sz++];
+}
+
+/* Append a String made from every view of the range. A forward range is counted first, so the vector grows at most once,
+a single-pass range is appended one view at a time. The views may point into the Strings of this vector, their text
+stays in place when the Strings are relocated */
+template<typename Range>
+void StringVector::emplace_back_all(const Range& views)
+{
+	using std::begin;
+	using std::end;
+	auto first = begin(views), last = end(views);
+	typedef typename std::iterator_traits<decltype(first)>::iterator_category category;
+	if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+		const size_t n = sz + static_cast<size_t>(std::distance(first, last));
+		if (n > cap)
+			relocate(next_capacity(n));
+		for (; first != last; ++first) {
+			std::string_view view = *first;
+			::new (static_cast<void*>(items + sz)) String(view.data(), view.data() + view.size());
+			sz++;
+		}
+	}
+	else {
+		for (; first != last; ++first) {
+			std::string_view view = *first;
+			emplace_back(view.data(), view.data() + view.size());
+		}
+	}
+}
+
+/****************************************** FUNCTIONS DECLARATIONS *********************************************/
+
+bool operator==(const StringVector& lhs, const StringVector& rhs);
+bool operator!=(const StringVector& lhs, const StringVector& rhs);
+void swap(StringVector& lhs, StringVector& rhs) noexcept;
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+/*********************************************** BENCHMARK HELPERS ***************************************************/
+
+/* Keep the compiler from optimizing away the value */
+template<typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const T* sink;
+	sink = &value;
+#endif
+}
+
+/* Run the function (iterations) times and return the average number of nanoseconds per call */
+template<typename Function>
+double time_ns(size_t iterations, Function&& function)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		function();
+	auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+/* Print one result line, comparing String against std::string */
+inline void report(const char* name, double stringNs, double stdNs)
+{
+	std::printf("%-40s %12.1f ns %12.1f ns %8.2fx\n", name, stringNs, stdNs, stdNs > 0 ? stringNs / stdNs : 0.0);
+}
+
+/* Print the header for the result lines, (first) and (second) name the compared columns */
+inline void report_header(const char* title, const char* first = "String", const char* second = "std::string")
+{
+	std::printf("\n%s\n%-40s %15s %15s %9s\n", title, "benchmark", first, second, "ratio");
+}
+
+/*********************************************** BENCHMARK RUNNER ***************************************************/
+
+/* Settings given on the command line */
+struct Bench_Options
+{
+	const char* filter = nullptr; // Run only the benchmarks whose names contain this text
+	size_t maxSize = 64u << 20; // The largest input size
+	double minTime = 0.05; // Seconds each measurement should last at least
+	double maxTime = 10.0; // Skip larger sizes when a single call is expected to take longer than this many seconds
+};
+
+/* Read --filter=, --max-size=, --min-time= and --max-time= from the arguments */
+inline Bench_Options parse_bench_options(int argc, char** argv)
+{
+	Bench_Options options;
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		if (std::strncmp(arg, "--filter=", 9) == 0)
+			options.filter = arg + 9;
+		else if (std::strncmp(arg, "--max-size=", 11) == 0)
+			options.maxSize = std::strtoull(arg + 11, nullptr, 10);
+		else if (std::strncmp(arg, "--min-time=", 11) == 0)
+			options.minTime = std::strtod(arg + 11, nullptr);
+		else if (std::strncmp(arg, "--max-time=", 11) == 0)
+			options.maxTime = std::strtod(arg + 11, nullptr);
+		else {
+			std::fprintf(stderr, "usage: %s [--filter=text] [--max-size=bytes] [--min-time=s] [--max-time=s]\n", argv[0]);
+			std::exit(1);
+		}
+	}
+	return options;
+}
+
+/* Measure the function, running it enough times to last at least (minTime) seconds */
+template<typename Function>
+double measure_ns(const Bench_Options& options, Function&& function)
+{
+	double once = time_ns(1, function);
+	double budget = options.minTime * 1e9;
+	if (once >= budget)
+		return once;
+	size_t iterations = (size_t) (budget / (once > 1.0 ? once : 1.0));
+	if (iterations > 10000000)
+		iterations = 10000000;
+	return time_ns(iterations ? iterations : 1, function);
+}
+
+/* Format the byte count as 1B, 4KB, 64MB and so on */
+inline const char* format_size(size_t size, char* buffer, size_t len)
+{
+	if (size >= (1u << 20) && size % (1u << 20) == 0)
+		std::snprintf(buffer, len, "%zuMB", size >> 20);
+	else if (size >= 1024 && size % 1024 == 0)
+		std::snprintf(buffer, len, "%zuKB", size >> 10);
+	else
+		std::snprintf(buffer, len, "%zuB", size);
+	return buffer;
+}
+
+/* Compare String against std::string on every size, (prepare) gives the pair of functions to time for one size */
+template<typename Prepare>
+void run_benchmark(const Bench_Options& options, const char* name, const size_t* sizes, size_t count, Prepare&& prepare)
+{
+	if (options.filter && !std::strstr(name, options.filter))
+		return;
+	bool tooSlow = false;
+	double lastNs = 0;
+	for (size_t i = 0; i < count && sizes[i] <= options.maxSize; i++) {
+		char label[96], size[24];
+		std::snprintf(label, sizeof(label), "%s/%s", name, format_size(sizes[i], size, sizeof(size)));
+		// Assume the worst case of quadratic growth, when guessing how long the next size takes
+		if (i > 0 && !tooSlow) {
+			double ratio = (double) sizes[i] / sizes[i - 1];
+			tooSlow = (lastNs * ratio * ratio > options.maxTime * 1e9);
+		}
+		if (tooSlow) {
+			std::printf("%-40s %15s\n", label, "skipped (slow)");
+			continue;
+		}
+		auto functions = prepare(sizes[i]);
+		double stringNs = measure_ns(options, functions.first);
+		double stdNs = measure_ns(options, functions.second);
+		report(label, stringNs, stdNs);
+		std::fflush(stdout);
+		lastNs = (stringNs > stdNs) ? stringNs : stdNs;
+	}
+}
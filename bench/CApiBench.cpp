@@ -0,0 +1,73 @@
+#include "../String.h"
+#include "Bench.h"
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+
+/* Measure the cost of handing the text to C APIs through c_str() and data() */
+int main()
+{
+	const size_t iterations = 1000000;
+	const char* text = "The quick brown fox jumps over the lazy dog";
+	char buffer[128];
+	FILE* null = std::fopen(
+#ifdef _WIN32
+		"NUL",
+#else
+		"/dev/null",
+#endif
+		"w");
+
+	report_header("C API interop");
+
+	report("construct + strlen(c_str())",
+		time_ns(iterations, [&] { String s(text); do_not_optimize(std::strlen(s.c_str())); }),
+		time_ns(iterations, [&] { std::string s(text); do_not_optimize(std::strlen(s.c_str())); }));
+
+	const String str(text);
+	const std::string stdStr(text);
+	report("const strlen(c_str())",
+		time_ns(iterations, [&] { do_not_optimize(std::strlen(str.c_str())); }),
+		time_ns(iterations, [&] { do_not_optimize(std::strlen(stdStr.c_str())); }));
+
+	report("snprintf(\"%s\", c_str())",
+		time_ns(iterations, [&] { do_not_optimize(std::snprintf(buffer, sizeof(buffer), "%s", str.c_str())); }),
+		time_ns(iterations, [&] { do_not_optimize(std::snprintf(buffer, sizeof(buffer), "%s", stdStr.c_str())); }));
+
+	report("append + strcmp(data())",
+		time_ns(iterations, [&] { String s(text); s += '!'; do_not_optimize(std::strcmp(s.data(), text)); }),
+		time_ns(iterations, [&] { std::string s(text); s += '!'; do_not_optimize(std::strcmp(s.data(), text)); }));
+
+	// A malloc'd buffer coming from C, used as a string and handed back to C
+	const size_t length = std::strlen(text);
+	report("malloc'd buffer in and out",
+		time_ns(iterations, [&] {
+			char* in = static_cast<char*>(std::malloc(length + 1));
+			std::memcpy(in, text, length + 1);
+			String s;
+			s.adopt(in, length, length, [](char* buffer, size_t) { std::free(buffer); });
+			String::Buffer out = s.release();
+			do_not_optimize(out.data);
+			out.deleter(out.data, out.capacity);
+		}),
+		time_ns(iterations, [&] {
+			char* in = static_cast<char*>(std::malloc(length + 1));
+			std::memcpy(in, text, length + 1);
+			std::string s(in, length);
+			std::free(in);
+			char* out = static_cast<char*>(std::malloc(s.size() + 1));
+			std::memcpy(out, s.c_str(), s.size() + 1);
+			do_not_optimize(out);
+			std::free(out);
+		}));
+
+	if (null) {
+		report("fputs(c_str())",
+			time_ns(iterations, [&] { std::fputs(str.c_str(), null); }),
+			time_ns(iterations, [&] { std::fputs(stdStr.c_str(), null); }));
+		std::fclose(null);
+	}
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include "../String.h"
+#include "../StringColumn.h"
+#include "../StringPattern.h"
+#include "Bench.h"
+
+#include <vector>
+#include <algorithm>
+#include <string_view>
+
+/* Compare StringColumn, that keeps every value in one blob, against std::vector<String> with a buffer per value */
+int main()
+{
+	const size_t count = 10000000;
+	std::vector<String> texts(count);
+	for (size_t i = 0; i < count; i++) {
+		texts[i].append("value-");
+		texts[i].append_number((i * 2654435761u) % count);
+	}
+
+	report_header("10M short values, per value", "StringColumn", "std::vector");
+
+	StringColumn column;
+	std::vector<String> vec;
+	report("append",
+		time_ns(1, [&] { for (const String& text : texts) column.append(text); }) / count,
+		time_ns(1, [&] { for (const String& text : texts) vec.push_back(text); }) / count);
+
+	// Bytes held by the containers, the allocator's own headers of the Strings aren't counted
+	size_t vecBytes = vec.capacity() * sizeof(String);
+	for (const String& str : vec)
+		vecBytes += str.capacity() + 1;
+	std::printf("%-40s %12.1f B  %12.1f B  %8.2fx\n", "memory", (double) column.memory_usage() / count,
+		(double) vecBytes / count, (double) column.memory_usage() / vecBytes);
+
+	size_t columnMatches = 0, vecMatches = 0;
+	report("scan, values ending with '7'",
+		time_ns(1, [&] { column.for_each([&](std::string_view value) { columnMatches += value.back() == '7'; }); }) / count,
+		time_ns(1, [&] { for (const String& str : vec) vecMatches += str.back() == '7'; }) / count);
+	do_not_optimize(columnMatches);
+	do_not_optimize(vecMatches);
+
+	// Predicates, the column builds a bitmap, the vector is filtered with a loop of comparisons
+	const String target("value-4242"), prefix("value-99"), needle("777");
+	size_t columnSelected = 0, vecSelected = 0;
+	report("equals",
+		time_ns(1, [&] { columnSelected += column.equals("value-4242").count(); }) / count,
+		time_ns(1, [&] { for (const String& str : vec) vecSelected += str == target; }) / count);
+	report("starts_with",
+		time_ns(1, [&] { columnSelected += column.starts_with("value-99").count(); }) / count,
+		time_ns(1, [&] { for (const String& str : vec) vecSelected += str.compare(0, prefix.size(), prefix) == 0; }) / count);
+	report("contains",
+		time_ns(1, [&] { columnSelected += column.contains("777").count(); }) / count,
+		time_ns(1, [&] { for (const String& str : vec) vecSelected += str.find(needle) != String::npos; }) / count);
+	const String_Pattern pattern("value-%7_7%");
+	report("LIKE 'value-%7_7%'",
+		time_ns(1, [&] { columnSelected += column.matching(pattern).count(); }) / count,
+		time_ns(1, [&] { for (const String& str : vec) vecSelected += pattern.matches(str); }) / count);
+	if (columnSelected != vecSelected)
+		std::printf("the predicates selected %zu and %zu values\n", columnSelected, vecSelected);
+
+	report("sort",
+		time_ns(1, [&] { column.sort(); }) / count,
+		time_ns(1, [&] { std::sort(vec.begin(), vec.end()); }) / count);
+	return 0;
+}
@@ -0,0 +1,46 @@
+#include "../String.h"
+#include "../StringRegex.h"
+#include "Bench.h"
+
+#include <regex>
+#include <string>
+#include <vector>
+
+/* Compare String_Regex, a lazily built DFA, against std::regex, that backtracks */
+int main()
+{
+	const size_t count = 1000000;
+	std::vector<std::string> values(count);
+	for (size_t i = 0; i < count; i++)
+		values[i] = "value-" + std::to_string((i * 2654435761u) % count);
+
+	report_header("1M short values, per value", "String_Regex", "std::regex");
+
+	String_Regex regex("\\w+-\\d*7");
+	std::regex stdRegex("\\w+-\\d*7");
+	size_t regexMatches = 0, stdMatches = 0;
+	report("matches '\\w+-\\d*7'",
+		time_ns(1, [&] { for (const std::string& value : values) regexMatches += regex.matches(value); }) / count,
+		time_ns(1, [&] { for (const std::string& value : values) stdMatches += std::regex_match(value, stdRegex); }) / count);
+	do_not_optimize(regexMatches + stdMatches);
+
+	// Lines of a log, the match is on the last one
+	std::string text;
+	for (size_t i = 0; text.size() < (1u << 20); i++)
+		text += "GET /static/file" + std::to_string(i) + ".css HTTP/1.1 200 needless\n";
+	text += "POST /api/upload HTTP/1.1 201 needle42x\n";
+
+	report_header("1MB log, per search", "String_Regex", "std::regex");
+
+	const char* patterns[] = { "needle[0-9]+x", "POST /api/\\w+", "[0-9]{3} [a-z]+[0-9]" };
+	for (const char* pattern : patterns) {
+		String_Regex searched(pattern);
+		std::regex stdSearched(pattern);
+		size_t found = 0;
+		report(pattern,
+			time_ns(10, [&] { found += searched.find(text).position; }),
+			time_ns(10, [&] { std::smatch match; std::regex_search(text, match, stdSearched); found += match.position(0); }));
+		do_not_optimize(found);
+	}
+	return 0;
+}
@@ -0,0 +1,265 @@
+#include "../String.h"
+#include "Bench.h"
+
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <utility>
+#include <cstdio>
+
+/* Tag that carries the string type into the generic benchmark bodies */
+template<typename S> struct Type { using type = S; };
+
+/* Input sizes, from one byte to 64 MB */
+static const size_t sizes[] = { 1, 16, 256, 4u << 10, 64u << 10, 1u << 20, 16u << 20, 64u << 20 };
+static const size_t sizeCount = sizeof(sizes) / sizeof(*sizes);
+
+/* Make (size) bytes of lowercase words, split into lines of about 80 characters */
+static std::string make_text(size_t size)
+{
+	std::string text(size, ' ');
+	unsigned state = 12345;
+	for (size_t i = 0; i < size; i++) {
+		state = state * 1103515245u + 12345u;
+		unsigned r = (state >> 16) % 32;
+		if (i % 80 == 79)
+			text[i] = '\n';
+		else if (r >= 26)
+			text[i] = ' ';
+		else
+			text[i] = (char) ('a' + r);
+	}
+	return text;
+}
+
+/* Make a needle of (size) bytes, that never appear in the text made by make_text() */
+static std::string make_needle(size_t size)
+{
+	std::string needle(size, ' ');
+	for (size_t i = 0; i < size; i++)
+		needle[i] = (char) (0x80 + i % 64);
+	return needle;
+}
+
+/* Keep the buffer of the string alive, so the allocation can't be removed */
+template<typename S>
+static void escape(const S& s)
+{
+	do_not_optimize(s.data());
+}
+
+/* Run the body for both String and std::string, (body) returns the function to time for one size */
+template<typename Body>
+static void compare(const Bench_Options& options, const char* name, Body body)
+{
+	run_benchmark(options, name, sizes, sizeCount, [&](size_t size) {
+		return std::make_pair(body(Type<String>(), size), body(Type<std::string>(), size));
+	});
+}
+
+/* Time insert() and erase() of 8 characters at the given fraction of the text, the tail being the last character */
+static void insert_erase(const Bench_Options& options, const char* name, size_t numerator, size_t denominator)
+{
+	compare(options, name, [=](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		S s(make_text(size).data(), size);
+		size_t pos = (size - 1) * numerator / denominator;
+		return [s, pos]() mutable {
+			s.insert(pos, "01234567", 8);
+			s.erase(pos, 8);
+			escape(s);
+		};
+	});
+}
+
+/* Time find() of a needle of the given size, placed at the end of the text */
+static void find_needle(const Bench_Options& options, const char* name, size_t needleSize)
+{
+	compare(options, name, [=](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size), needle = make_needle(needleSize);
+		size_t fit = (needleSize < size) ? needleSize : size;
+		text.replace(size - fit, fit, needle, 0, fit);
+		S s(text.data(), size);
+		return [s, needle]() {
+			do_not_optimize(s.find(needle.data(), 0, needle.size()));
+		};
+	});
+}
+
+/* Time rfind() of a needle of the given size, placed at the start of the text */
+static void rfind_needle(const Bench_Options& options, const char* name, size_t needleSize)
+{
+	compare(options, name, [=](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size), needle = make_needle(needleSize);
+		text.replace(0, needleSize, needle);
+		S s(text.data(), size);
+		return [s, needle]() {
+			do_not_optimize(s.rfind(needle.c_str()));
+		};
+	});
+}
+
+/* Time find_first_of() with a set of the given size, that matches only the last character */
+static void find_first_of_set(const Bench_Options& options, const char* name, size_t setSize)
+{
+	compare(options, name, [=](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size), set = make_needle(setSize);
+		text[size - 1] = set[setSize - 1];
+		S s(text.data(), size);
+		return [s, set]() {
+			do_not_optimize(s.find_first_of(set.data(), 0, set.size()));
+		};
+	});
+}
+
+/* Compare String against std::string on the common operations */
+int main(int argc, char** argv)
+{
+	Bench_Options options = parse_bench_options(argc, argv);
+	report_header("String vs std::string");
+
+	compare(options, "construct", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size);
+		return [text]() {
+			S s(text.data(), text.size());
+			escape(s);
+		};
+	});
+
+	compare(options, "copy", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		S source(make_text(size).data(), size);
+		return [source]() {
+			S s(source);
+			escape(s);
+		};
+	});
+
+	compare(options, "move", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		S source(make_text(size).data(), size);
+		return [source]() mutable {
+			S s(std::move(source));
+			source = std::move(s);
+			escape(source);
+		};
+	});
+
+	compare(options, "push_back loop", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		return [size]() {
+			S s;
+			for (size_t i = 0; i < size; i++)
+				s.push_back((char) ('a' + i % 26));
+			escape(s);
+		};
+	});
+
+	compare(options, "append loop (16B)", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		return [size]() {
+			S s;
+			for (size_t i = 0; i < size; i += 16)
+				s.append("0123456789abcdef", (size - i < 16) ? size - i : 16);
+			escape(s);
+		};
+	});
+
+	compare(options, "clear+append (scratch reuse)", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size);
+		return [text, scratch = S()]() mutable {
+			scratch.clear();
+			scratch.append(text.data(), text.size());
+			escape(scratch);
+		};
+	});
+
+	insert_erase(options, "insert+erase head", 0, 1);
+	insert_erase(options, "insert+erase middle", 1, 2);
+	insert_erase(options, "insert+erase tail", 1, 1);
+
+	find_needle(options, "find (1B needle)", 1);
+	find_needle(options, "find (8B needle)", 8);
+	find_needle(options, "find (64B needle)", 64);
+
+	rfind_needle(options, "rfind (1B needle)", 1);
+	rfind_needle(options, "rfind (8B needle)", 8);
+	rfind_needle(options, "rfind (64B needle)", 64);
+
+	find_first_of_set(options, "find_first_of (1B set)", 1);
+	find_first_of_set(options, "find_first_of (8B set)", 8);
+	find_first_of_set(options, "find_first_of (64B set)", 64);
+
+	// Standard algorithms over the iterators, std::string's are unwrapped to raw pointers by the library
+	compare(options, "std::find (iterators)", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size);
+		text[size - 1] = '#';
+		S s(text.data(), size);
+		return [s]() {
+			do_not_optimize(std::find(s.begin(), s.end(), '#') - s.begin());
+		};
+	});
+
+	compare(options, "std::copy (iterators)", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		S source(make_text(size).data(), size), target(size, ' ');
+		return [source, target]() mutable {
+			std::copy(source.begin(), source.end(), target.begin());
+			escape(target);
+		};
+	});
+
+	compare(options, "compare", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size);
+		S lhs(text.data(), size);
+		text[size - 1] = '#';
+		S rhs(text.data(), size);
+		return [lhs, rhs]() {
+			do_not_optimize(lhs.compare(rhs));
+		};
+	});
+
+	compare(options, "substr (middle half)", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		S s(make_text(size).data(), size);
+		return [s]() {
+			S sub = s.substr(s.size() / 4, s.size() / 2);
+			escape(sub);
+		};
+	});
+
+	compare(options, "getline (file)", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size);
+		text[size - 1] = '\n';
+		const char* path = "string_bench_getline.tmp";
+		std::ofstream(path, std::ios::binary).write(text.data(), size);
+		return [path]() {
+			std::ifstream in(path, std::ios::binary);
+			S line;
+			size_t total = 0;
+			while (getline(in, line))
+				total += line.size();
+			do_not_optimize(total);
+		};
+	});
+	std::remove("string_bench_getline.tmp");
+
+	compare(options, "operator+ chain", [](auto type, size_t size) {
+		using S = typename decltype(type)::type;
+		std::string text = make_text(size);
+		S a(text.data(), size), b(text.data(), size / 2), c(text.data(), size / 4);
+		return [a, b, c]() {
+			S result = a + "," + b + "," + c + ".";
+			escape(result);
+		};
+	});
+	return 0;
+}
@@ -0,0 +1,43 @@
+#include "../String.h"
+#include "../StringVector.h"
+#include "Bench.h"
+
+#include <vector>
+#include <string_view>
+
+/* Compare StringVector, that relocates its Strings with memcpy(), against std::vector<String>, that moves and destroys them */
+int main()
+{
+	const size_t count = 10000000;
+	const char* text = "relocatable text";
+	std::vector<std::string_view> views(count, std::string_view(text));
+
+	report_header("Growing a vector of 10M Strings, per String", "StringVector", "std::vector");
+
+	report("emplace_back, empty Strings",
+		time_ns(1, [&] { StringVector vec; for (size_t i = 0; i < count; i++) vec.emplace_back(); do_not_optimize(vec.data()); }) / count,
+		time_ns(1, [&] { std::vector<String> vec; for (size_t i = 0; i < count; i++) vec.emplace_back(); do_not_optimize(vec.data()); }) / count);
+
+	report("emplace_back, 16 character Strings",
+		time_ns(1, [&] { StringVector vec; for (size_t i = 0; i < count; i++) vec.emplace_back(text); do_not_optimize(vec.data()); }) / count,
+		time_ns(1, [&] { std::vector<String> vec; for (size_t i = 0; i < count; i++) vec.emplace_back(text); do_not_optimize(vec.data()); }) / count);
+
+	report("bulk from views",
+		time_ns(1, [&] { StringVector vec; vec.emplace_back_all(views); do_not_optimize(vec.data()); }) / count,
+		time_ns(1, [&] {
+			std::vector<String> vec;
+			vec.reserve(views.size());
+			for (std::string_view view : views)
+				vec.emplace_back(view.data(), view.data() + view.size());
+			do_not_optimize(vec.data());
+		}) / count);
+
+	// Only the relocation of 10M filled Strings is timed
+	StringVector filled;
+	filled.emplace_back_all(views);
+	std::vector<String> stdFilled(filled.begin(), filled.end());
+	report("relocating 10M filled Strings",
+		time_ns(1, [&] { filled.reserve(filled.capacity() * 2); }) / count,
+		time_ns(1, [&] { stdFilled.reserve(stdFilled.capacity() * 2); }) / count);
+	return 0;
+}
@@ -0,0 +1,415 @@
+#include "../String.h"
+
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <stdexcept>
+#include <sstream>
+
+/*********************************************** FUZZ INPUT ***************************************************/
+
+/* Reads the operations and their arguments from the fuzzer's bytes */
+class Fuzz_Input
+{
+public:
+	Fuzz_Input(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+	bool done() const { return pos >= size; }
+
+	/* Return the next byte, or 0 once the input has run out */
+	uint8_t byte() { return (pos < size) ? data[pos++] : 0; }
+
+	/* Return a position for a text of (len) characters, sometimes past its end or npos */
+	size_t index(size_t len)
+	{
+		uint8_t b = byte();
+		if (b == 255)
+			return String::npos;
+		return b % (len + 3);
+	}
+
+	/* Return a small count */
+	size_t count() { return byte() % 20; }
+
+	/* Return a character from a small alphabet, so the searches find something */
+	char character()
+	{
+		static const char alphabet[] = { 'a', 'b', 'c', ' ', '\t', (char) 0xE9, 'A', 'z' };
+		return alphabet[byte() % sizeof(alphabet)];
+	}
+
+	/* Return a short text without embedded NULs */
+	std::string text()
+	{
+		std::string result(byte() % 12, ' ');
+		for (char& ch : result)
+			ch = character();
+		return result;
+	}
+
+private:
+	const uint8_t* data;
+	size_t size;
+	size_t pos = 0;
+};
+
+/*********************************************** CHECKS ***************************************************/
+
+/* Report the mismatch and stop */
+[[noreturn]] static void fail(const char* what, int op, const String& str, const std::string& ref)
+{
+	std::fprintf(stderr, "mismatch in %s (operation %d)\n  String:      \"%.*s\" (%zu)\n  std::string: \"%s\" (%zu)\n",
+		what, op, (int) str.size(), str.data(), str.size(), ref.c_str(), ref.size());
+	std::abort();
+}
+
+/* Check that the String holds the same text as the std::string, and is terminated */
+static void check_equal(const char* what, int op, const String& str, const std::string& ref)
+{
+	if (str.size() != ref.size() || std::memcmp(str.data(), ref.data(), ref.size()) != 0)
+		fail(what, op, str, ref);
+	if (str.c_str()[str.size()] != '\0' || str.capacity() < str.size() || str.empty() != ref.empty())
+		fail(what, op, str, ref);
+}
+
+/* Copy the String into a std::string, keeping embedded NULs */
+static std::string to_std(const String& str)
+{
+	return std::string(str.data(), str.size());
+}
+
+/* Return the text lowercased by std::tolower(), the reference of the case-insensitive operations */
+static std::string lower_std(const std::string& text)
+{
+	std::string result(text);
+	for (char& ch : result)
+		ch = (char) std::tolower((unsigned char) ch);
+	return result;
+}
+
+/* Reduce comparison results to their sign */
+static int sign(int value)
+{
+	return (value > 0) - (value < 0);
+}
+
+/* Run the operation on both Strings, and check that they both return the same value or both throw */
+#define DIFF(what, stringExpr, refExpr)                                                     \
+	do {                                                                                    \
+		bool stringThrew = false, refThrew = false;                                         \
+		std::decay_t<decltype(refExpr)> refResult{};                                        \
+		std::decay_t<decltype(refExpr)> stringResult{};                                     \
+		try { refResult = (refExpr); } catch (const std::out_of_range&) { refThrew = true; }       \
+		try { stringResult = (stringExpr); } catch (const std::out_of_range&) { stringThrew = true; } \
+		if (stringThrew != refThrew || (!refThrew && stringResult != refResult))            \
+			fail(what, op, str, ref);                                                       \
+	} while (false)
+
+/* Run the modifying operation on both Strings, and check that they both throw or both succeed */
+#define DIFF_VOID(what, stringStmt, refStmt)                                                \
+	do {                                                                                    \
+		bool stringThrew = false, refThrew = false;                                         \
+		try { refStmt; } catch (const std::out_of_range&) { refThrew = true; }                     \
+		try { stringStmt; } catch (const std::out_of_range&) { stringThrew = true; }               \
+		if (stringThrew != refThrew)                                                        \
+			fail(what, op, str, ref);                                                       \
+	} while (false)
+
+/* Deleter of the malloc() buffers given to adopt() */
+static void free_buffer(char* buffer, size_t)
+{
+	std::free(buffer);
+}
+
+/*********************************************** FUZZ TARGET ***************************************************/
+
+//Number of the operations below, every one of [0, operationCount) has its case
+static const int operationCount = 53;
+
+/* Apply the same sequence of operations to String and std::string, comparing them after each one */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	Fuzz_Input in(data, size);
+	String str, other;
+	std::string ref, otherRef;
+	int op = -1;
+	check_equal("default constructor", op, str, ref);
+
+	for (int steps = 0; !in.done() && steps < 256; steps++) {
+		op = in.byte() % operationCount;
+		switch (op) {
+		case 0: { std::string t = in.text(); str.append(t.c_str()); ref.append(t); break; }
+		case 1: { std::string t = in.text(); size_t n = in.byte() % (t.size() + 1);
+			str.append(t.c_str(), n); ref.append(t.c_str(), n); break; }
+		case 2: { size_t n = in.count(); char ch = in.character(); str.append(n, ch); ref.append(n, ch); break; }
+		case 3: { char ch = in.character(); str.push_back(ch); ref.push_back(ch); break; }
+		case 4: if (!ref.empty()) { str.pop_back(); ref.pop_back(); } break;
+		case 5: { std::string t = in.text(); size_t p = in.index(ref.size());
+			DIFF_VOID("insert(pos, cptr)", str.insert(p, t.c_str()), ref.insert(p, t.c_str())); break; }
+		case 6: { size_t p = in.index(ref.size()), n = in.count(); char ch = in.character();
+			DIFF_VOID("insert(pos, n, ch)", str.insert(p, n, ch), ref.insert(p, n, ch)); break; }
+		case 7: { size_t p = in.index(ref.size()), n = in.index(ref.size());
+			DIFF_VOID("erase(pos, len)", str.erase(p, n), ref.erase(p, n)); break; }
+		case 8: { std::string t = in.text(); size_t p = in.index(ref.size()), n = in.index(ref.size());
+			DIFF_VOID("replace(pos, len, cptr)", str.replace(p, n, t.c_str()), ref.replace(p, n, t.c_str())); break; }
+		case 9: { size_t p = in.index(ref.size()), n = in.index(ref.size()), c = in.count(); char ch = in.character();
+			DIFF_VOID("replace(pos, len, n, ch)", str.replace(p, n, c, ch), ref.replace(p, n, c, ch)); break; }
+		case 10: { std::string t = in.text(); str.assign(t.c_str()); ref.assign(t); break; }
+		case 11: { size_t n = in.count() * 3; char ch = in.character(); str.resize(n, ch); ref.resize(n, ch); break; }
+		case 12: { size_t n = in.count(); str.resize(n); ref.resize(n); break; }
+		case 13: { size_t n = in.count() * 4; str.reserve(n); ref.reserve(n); break; }
+		case 14: str.shrink_to_fit(); ref.shrink_to_fit(); break;
+		case 15: str.clear(); ref.clear(); break;
+		case 16: { size_t p = in.index(ref.size()), n = in.index(ref.size());
+			DIFF("substr", to_std(str.substr(p, n)), ref.substr(p, n)); break; }
+		case 17: { std::string t = in.text(); size_t p = in.index(ref.size());
+			DIFF("find(cptr, pos)", str.find(t.c_str(), p), ref.find(t.c_str(), p));
+			DIFF("find(String, pos)", str.find(String(t.c_str()), p), ref.find(t, p)); break; }
+		case 18: { char ch = in.character(); size_t p = in.index(ref.size());
+			DIFF("find(ch, pos)", str.find(ch, p), ref.find(ch, p)); break; }
+		case 19: { std::string t = in.text(); size_t p = in.index(ref.size());
+			DIFF("rfind(cptr, pos)", str.rfind(t.c_str(), p), ref.rfind(t.c_str(), p));
+			DIFF("rfind(String, pos)", str.rfind(String(t.c_str()), p), ref.rfind(t, p));
+			DIFF("rfind(cptr)", str.rfind(t.c_str()), ref.rfind(t.c_str())); break; }
+		case 20: { char ch = in.character(); size_t p = in.index(ref.size());
+			DIFF("rfind(ch, pos)", str.rfind(ch, p), ref.rfind(ch, p));
+			DIFF("rfind(ch)", str.rfind(ch), ref.rfind(ch)); break; }
+		case 21: { std::string t = in.text(); size_t p = in.index(ref.size()); String set(t.c_str());
+			DIFF("find_first_of(cptr, pos)", str.find_first_of(t.c_str(), p), ref.find_first_of(t.c_str(), p));
+			DIFF("find_first_of(String, pos)", str.find_first_of(set, p), ref.find_first_of(t, p));
+			DIFF("find_last_of(cptr, pos)", str.find_last_of(t.c_str(), p), ref.find_last_of(t.c_str(), p));
+			DIFF("find_last_of(String, pos)", str.find_last_of(set, p), ref.find_last_of(t, p));
+			DIFF("find_last_of(cptr)", str.find_last_of(t.c_str()), ref.find_last_of(t.c_str())); break; }
+		case 22: { std::string t = in.text(); size_t p = in.index(ref.size()); String set(t.c_str());
+			DIFF("find_first_not_of(cptr, pos)", str.find_first_not_of(t.c_str(), p), ref.find_first_not_of(t.c_str(), p));
+			DIFF("find_first_not_of(String, pos)", str.find_first_not_of(set, p), ref.find_first_not_of(t, p));
+			DIFF("find_last_not_of(cptr, pos)", str.find_last_not_of(t.c_str(), p), ref.find_last_not_of(t.c_str(), p));
+			DIFF("find_last_not_of(String, pos)", str.find_last_not_of(set, p), ref.find_last_not_of(t, p));
+			DIFF("find_last_not_of(cptr)", str.find_last_not_of(t.c_str()), ref.find_last_not_of(t.c_str())); break; }
+		case 23: { char ch = in.character(); size_t p = in.index(ref.size());
+			DIFF("find_first_of(ch, pos)", str.find_first_of(ch, p), ref.find_first_of(ch, p));
+			DIFF("find_last_of(ch, pos)", str.find_last_of(ch, p), ref.find_last_of(ch, p));
+			DIFF("find_first_not_of(ch, pos)", str.find_first_not_of(ch, p), ref.find_first_not_of(ch, p));
+			DIFF("find_last_not_of(ch, pos)", str.find_last_not_of(ch, p), ref.find_last_not_of(ch, p)); break; }
+		case 24: { std::string t = in.text(); String s(t.c_str());
+			DIFF("compare(cptr)", sign(str.compare(t.c_str())), sign(ref.compare(t.c_str())));
+			DIFF("compare(String)", sign(str.compare(s)), sign(ref.compare(t)));
+			DIFF("operator==", str == s, ref == t);
+			DIFF("operator<", str < s, ref < t);
+			DIFF("operator>=", str >= t.c_str(), ref >= t); break; }
+		case 25: { std::string t = in.text(); size_t p = in.index(ref.size()), n = in.index(ref.size());
+			DIFF("compare(pos, len, cptr)", sign(str.compare(p, n, t.c_str())), sign(ref.compare(p, n, t.c_str()))); break; }
+		case 26: { std::string t = in.text();
+			str = str + t.c_str(); ref = ref + t; break; }
+		case 27: { char ch = in.character(); str = ch + str; ref = ch + ref;
+			ch = in.character(); str += ch; ref += ch; break; }
+		case 28: { char buffer[32] = {}, refBuffer[32] = {}; size_t n = in.count(), p = in.index(ref.size());
+			DIFF("copy", str.copy(buffer, n, p), ref.copy(refBuffer, n, p));
+			if (std::memcmp(buffer, refBuffer, sizeof(buffer)) != 0)
+				fail("copy contents", op, str, ref);
+			break; }
+		case 29: { size_t p = in.index(ref.size());
+			DIFF("at", str.at(p), ref.at(p)); break; }
+		case 30: { String copy(str); check_equal("copy constructor", op, copy, ref);
+			String moved(std::move(copy)); check_equal("move constructor", op, moved, ref);
+			str = moved; break; }
+		case 31: { size_t p = in.index(ref.size()), n = in.index(ref.size());
+			DIFF("String(str, pos, len)", to_std(String(str, p, n)), std::string(ref, p, n)); break; }
+		case 32: { std::string t = in.text(); other = t.c_str(); otherRef = t;
+			size_t p = in.index(otherRef.size()), n = in.index(otherRef.size()), q = in.index(ref.size());
+			switch (in.byte() % 4) {
+			case 0: DIFF_VOID("append(str, pos, len)", str.append(other, p, n), ref.append(otherRef, p, n)); break;
+			case 1: DIFF_VOID("assign(str, pos, len)", str.assign(other, p, n), ref.assign(otherRef, p, n)); break;
+			case 2: DIFF_VOID("insert(pos, str, subpos, sublen)", str.insert(q, other, p, n), ref.insert(q, otherRef, p, n)); break;
+			default: DIFF_VOID("replace(pos, len, str, subpos, sublen)", str.replace(q, 1, other, p, n), ref.replace(q, 1, otherRef, p, n)); break;
+			}
+			break; }
+		case 33: str.swap(other); ref.swap(otherRef); check_equal("swap", op, other, otherRef); break;
+		case 34: { size_t k = in.byte() % (ref.size() + 1); char ch = in.character();
+			str.insert(str.begin() + k, ch); ref.insert(ref.begin() + k, ch); break; }
+		case 35: if (!ref.empty()) { size_t k = in.byte() % ref.size();
+			str.erase(str.begin() + k); ref.erase(ref.begin() + k); } break;
+		case 36: { size_t k = in.byte() % (ref.size() + 1), len = in.byte() % (ref.size() - k + 1);
+			str.erase(str.begin() + k, str.begin() + k + len); ref.erase(ref.begin() + k, ref.begin() + k + len); break; }
+		case 37: { size_t k = in.byte() % (ref.size() + 1), len = in.byte() % (ref.size() - k + 1); std::string t = in.text();
+			str.replace(str.begin() + k, str.begin() + k + len, t.c_str());
+			ref.replace(ref.begin() + k, ref.begin() + k + len, t); break; }
+		case 38: { size_t k = in.byte() % (ref.size() + 1), n = in.count(); char ch = in.character();
+			str.insert(str.begin() + k, n, ch); ref.insert(ref.begin() + k, n, ch); break; }
+		case 39: { size_t p = in.index(ref.size()), n = in.index(ref.size());
+			switch (in.byte() % 6) {
+			case 0: str.append(str); ref.append(ref); break;
+			case 1: str += str; ref += ref; break;
+			case 2: str = *&str; break;
+			case 3: DIFF_VOID("insert(pos, self)", str.insert(p, str), ref.insert(p, ref)); break;
+			case 4: DIFF_VOID("replace(pos, len, self)", str.replace(p, n, str), ref.replace(p, n, ref)); break;
+			default: DIFF_VOID("assign(self, pos, len)", str.assign(str, p, n), ref.assign(ref, p, n)); break;
+			}
+			break; }
+		case 40: { std::string t = in.text();
+			if (in.byte() % 2)
+				str.append(t.begin(), t.end()), ref.append(t.begin(), t.end());
+			else
+				str.assign(t.begin(), t.end()), ref.assign(t.begin(), t.end());
+			break; }
+		case 41: { std::string t = in.text(); size_t k = in.byte() % (ref.size() + 1);
+			str.insert(str.begin() + k, t.begin(), t.end()); ref.insert(ref.begin() + k, t.begin(), t.end()); break; }
+		case 42: { size_t k = in.byte() % (ref.size() + 1), len = in.byte() % (ref.size() - k + 1); std::string t = in.text();
+			str.replace(str.begin() + k, str.begin() + k + len, t.begin(), t.end());
+			ref.replace(ref.begin() + k, ref.begin() + k + len, t.begin(), t.end()); break; }
+		case 43: { std::string t = in.text(); char delim = in.character();
+			std::istringstream is(t), refIs(t);
+			for (;;) {
+				bool read = (bool) getline(is, str, delim), refRead = (bool) std::getline(refIs, ref, delim);
+				if (read != refRead)
+					fail("getline", op, str, ref);
+				if (!read)
+					break;
+				check_equal("getline", op, str, ref);
+			}
+			std::istringstream words(t), refWords(t);
+			for (;;) {
+				bool read = (bool) (words >> str), refRead = (bool) (refWords >> ref);
+				if (read != refRead || words.eof() != refWords.eof())
+					fail("operator>>", op, str, ref);
+				if (!read)
+					break;
+				check_equal("operator>>", op, str, ref);
+			}
+			str = ref.c_str();
+			break; }
+		case 44: { std::string t = in.text(); size_t p = in.index(ref.size());
+			DIFF("ifind(cptr, pos)", str.ifind(t.c_str(), p), lower_std(ref).find(lower_std(t), p));
+			DIFF("ifind(String, pos)", str.ifind(String(t.c_str()), p), lower_std(ref).find(lower_std(t), p)); break; }
+		case 45: { std::string t = in.text(); String s(t.c_str());
+			DIFF("icompare(cptr)", sign(str.icompare(t.c_str())), sign(lower_std(ref).compare(lower_std(t))));
+			DIFF("icompare(String)", sign(str.icompare(s)), sign(lower_std(ref).compare(lower_std(t))));
+			DIFF("iequals(String)", str.iequals(s), lower_std(ref) == lower_std(t));
+			DIFF("lower()", to_std(str.lower()), lower_std(ref)); break; }
+		case 46: { std::string t = in.text(); size_t p = in.index(ref.size()), n = in.index(ref.size()), c = in.byte() % (t.size() + 1);
+			DIFF_VOID("replace(pos, len, cptr, n)", str.replace(p, n, t.c_str(), c), ref.replace(p, n, t.c_str(), c)); break; }
+		case 47: { std::string t = in.text(); const bool spaces = in.byte() % 2; const std::string members = spaces ? " \t\n\v\f\r" : t;
+			const String::Char_Set set(members.data(), members.size());
+			size_t first = ref.find_first_not_of(members), last = ref.find_last_not_of(members);
+			std::string left = (first == std::string::npos) ? "" : ref.substr(first);
+			std::string right = (last == std::string::npos) ? "" : ref.substr(0, last + 1);
+			std::string both = (first == std::string::npos) ? "" : ref.substr(first, last - first + 1);
+			DIFF("trimmed()", std::string(spaces ? str.trimmed() : str.trimmed(set)), both);
+			DIFF("ltrimmed()", std::string(spaces ? str.ltrimmed() : str.ltrimmed(set)), left);
+			DIFF("rtrimmed()", std::string(spaces ? str.rtrimmed() : str.rtrimmed(set)), right);
+			switch (in.byte() % 3) {
+			case 0: spaces ? str.trim() : str.trim(set); ref = both; break;
+			case 1: spaces ? str.ltrim() : str.ltrim(set); ref = left; break;
+			default: spaces ? str.rtrim() : str.rtrim(set); ref = right; break;
+			}
+			break; }
+		case 48: { std::string t = in.text(); long long i = (int8_t) in.byte() * 1000003LL; unsigned long long u = in.byte() * 0x10001ULL;
+			char expected[128];
+			if (in.byte() % 2) {
+				format_to(str, "{}|{:x}|{{{}}}", i, u, t.c_str());
+				std::snprintf(expected, sizeof(expected), "%lld|%llx|{%s}", i, u, t.c_str());
+			}
+			else {
+				const char ch = in.character();
+				format_to(str, "{:X}{}{:.2f}", u, ch, i / 7.0);
+				std::snprintf(expected, sizeof(expected), "%llX%c%.2f", u, ch, i / 7.0);
+			}
+			ref += expected;
+			break; }
+		case 49: { long long i = (int8_t) in.byte() * 0x123456789LL; unsigned u = in.byte() * 0x1010101u;
+			switch (in.byte() % 3) {
+			case 0: str.append_number(i); ref += std::to_string(i); break;
+			case 1: str.append_number(u); ref += std::to_string(u); break;
+			default: str.append_number((short) i); ref += std::to_string((short) i); break;
+			}
+			break; }
+		case 50: { size_t n = in.count(), k = in.byte() % (n + 1); char ch = in.character();
+			char* room = str.prepare(n);
+			if (k)
+				std::memset(room, ch, k);
+			str.commit(k);
+			ref.append(k, ch);
+			bool thrown = false;
+			try { str.commit(str.capacity() - str.size() + 1); } catch (const std::out_of_range&) { thrown = true; }
+			if (!thrown)
+				fail("commit() past the capacity", op, str, ref);
+			break; }
+		case 51: { size_t n = in.count() * 2, k = in.byte() % (n + 1); char ch = in.character(); size_t old = ref.size();
+			str.resize_and_overwrite(n, [&](char* buffer, size_t room) {
+				for (size_t j = old; j < k && j < room; j++)
+					buffer[j] = ch;
+				return k;
+			});
+			ref.resize(k, ch);
+			break; }
+		case 52: { String::Buffer buffer = str.release();
+			if (!str.empty() || buffer.size != ref.size() || (buffer.data && std::memcmp(buffer.data, ref.data(), ref.size()) != 0))
+				fail("release()", op, str, ref);
+			if (buffer.data && in.byte() % 2) {
+				str.adopt(buffer.data, buffer.size, buffer.capacity, buffer.deleter);
+			}
+			else {
+				if (buffer.data)
+					buffer.deleter(buffer.data, buffer.capacity);
+				// A malloc() buffer with room to spare
+				std::string t = in.text();
+				size_t capacity = t.size() + in.count();
+				char* data = (char*) std::malloc(capacity + 1);
+				std::memcpy(data, t.data(), t.size());
+				str.adopt(data, t.size(), capacity, free_buffer);
+				ref = t;
+			}
+			break; }
+		}
+		check_equal("contents", op, str, ref);
+	}
+	return 0;
+}
+
+/*********************************************** STANDALONE DRIVER ***************************************************/
+
+#ifdef STRING_FUZZ_STANDALONE
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <random>
+
+/* Run the given input files, or random inputs when there are none */
+int main(int argc, char** argv)
+{
+	size_t runs = 100000, seed = 1;
+	std::vector<const char*> files;
+	for (int i = 1; i < argc; i++) {
+		if (std::strncmp(argv[i], "-runs=", 6) == 0)
+			runs = std::strtoull(argv[i] + 6, nullptr, 10);
+		else if (std::strncmp(argv[i], "-seed=", 6) == 0)
+			seed = std::strtoull(argv[i] + 6, nullptr, 10);
+		else
+			files.push_back(argv[i]);
+	}
+
+	for (const char* file : files) {
+		std::ifstream is(file, std::ios::binary);
+		std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+		LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+	}
+	if (!files.empty())
+		return 0;
+
+	std::mt19937_64 rng(seed);
+	std::vector<uint8_t> bytes;
+	for (size_t run = 0; run < runs; run++) {
+		bytes.resize(rng() % 512);
+		for (uint8_t& b : bytes)
+			b = (uint8_t) rng();
+		LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+	}
+	std::printf("%zu runs passed\n", runs);
+	return 0;
+}
+
+#endif
@@ -0,0 +1,272 @@
+#include "../String.h"
+#include "Test.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+//Buffers freed by free_counted(), with the capacity of the last one
+static int freedBuffers = 0;
+static size_t freedCapacity = 0;
+
+/* Deleter of the malloc() buffers, counting them */
+static void free_counted(char* buffer, size_t capacity)
+{
+	freedBuffers++;
+	freedCapacity = capacity;
+	std::free(buffer);
+}
+
+/* Return a malloc() buffer of (capacity + 1) characters, holding the text */
+static char* malloc_text(const char* text, size_t capacity)
+{
+	char* buffer = static_cast<char*>(std::malloc(capacity + 1));
+	std::strcpy(buffer, text);
+	return buffer;
+}
+
+/* release() gives the buffer up, adopt() takes it back without copying */
+static void test_release_and_adopt()
+{
+	String str("hello world");
+	const char* data = str.data();
+	String::Buffer buffer = str.release();
+	CHECK(buffer.data == data && buffer.size == 11 && std::strcmp(buffer.data, "hello world") == 0);
+	CHECK(str.empty() && str.c_str()[0] == '\0');
+
+	String other;
+	other.adopt(buffer.data, buffer.size, buffer.capacity, buffer.deleter);
+	CHECK(other.data() == data && other == "hello world");
+	other += " and more text, past the capacity";
+	CHECK(other == "hello world and more text, past the capacity");
+}
+
+/* A malloc() buffer is freed with its deleter once, when the String grows past it or is destroyed */
+static void test_deleter()
+{
+	freedBuffers = 0;
+	{
+		String str;
+		str.adopt(malloc_text("abc", 8), 3, 8, free_counted);
+		str += "defgh";
+		CHECK(str == "abcdefgh" && freedBuffers == 0);
+		str += "i";
+		CHECK(str == "abcdefghi" && freedBuffers == 1 && freedCapacity == 8);
+	}
+	CHECK(freedBuffers == 1);
+	{
+		String str;
+		str.adopt(malloc_text("abc", 3), 3, 3, free_counted);
+	}
+	CHECK(freedBuffers == 2 && freedCapacity == 3);
+}
+
+/* Adopting the buffer the String already has keeps it, with the new size, capacity and deleter */
+static void test_adopt_own_buffer()
+{
+	freedBuffers = 0;
+	{
+		String str;
+		char* buffer = malloc_text("hello world", 16);
+		str.adopt(buffer, 11, 11, free_counted);
+		str.adopt(buffer, 5, 16, free_counted);
+		CHECK(freedBuffers == 0);
+		CHECK(str.data() == buffer && str.size() == 5 && str.capacity() == 16 && str == "hello");
+		CHECK(str.c_str()[5] == '\0');
+		str += " there";
+		CHECK(str.data() == buffer && str == "hello there");
+	}
+	CHECK(freedBuffers == 1 && freedCapacity == 16);
+
+	// Adopting nothing frees the buffer
+	freedBuffers = 0;
+	String str;
+	str.adopt(malloc_text("abc", 3), 3, 3, free_counted);
+	str.adopt(nullptr, 0, 0, free_counted);
+	CHECK(freedBuffers == 1 && str.empty());
+}
+
+/* Moving and swapping take the deleter along, copying an adopted buffer gives an own one */
+static void test_moves()
+{
+	freedBuffers = 0;
+	{
+		String str;
+		char* buffer = malloc_text("adopted", 16);
+		str.adopt(buffer, 7, 16, free_counted);
+		String moved(std::move(str));
+		CHECK(moved.data() == buffer && str.empty());
+		String assigned("own text");
+		assigned = std::move(moved);
+		CHECK(assigned.data() == buffer && freedBuffers == 0);
+
+		String own("own text");
+		own.swap(assigned);
+		CHECK(own.data() == buffer && assigned == "own text");
+		assigned.swap(own);
+		CHECK(assigned.data() == buffer && own == "own text");
+
+		String copy(assigned);
+		copy = assigned;
+		CHECK(copy == "adopted" && copy.data() != buffer);
+		own = copy;
+		String::Buffer released = copy.release();
+		released.deleter(released.data, released.capacity);
+		CHECK(freedBuffers == 0);
+	}
+	CHECK(freedBuffers == 1 && freedCapacity == 16);
+
+	// A released adopted buffer keeps its deleter, adopting it again takes it back
+	freedBuffers = 0;
+	String str;
+	str.adopt(malloc_text("abc", 8), 3, 8, free_counted);
+	String::Buffer buffer = str.release();
+	CHECK(buffer.deleter == &free_counted && freedBuffers == 0);
+	str.adopt(buffer.data, buffer.size, buffer.capacity, buffer.deleter);
+	str.release_memory();
+	CHECK(freedBuffers == 1);
+}
+
+/* A missing deleter or a size past the capacity throw, leaving the String as it was */
+static void test_errors()
+{
+	String str("abc");
+	char text[8] = "xyz";
+	bool thrown = false;
+	try { str.adopt(text, 3, 7, nullptr); } catch (const std::invalid_argument&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { str.adopt(text, 8, 7, free_counted); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	CHECK(str == "abc");
+}
+
+/* prepare() makes room after the text, commit() adds what was written there, and throws past the capacity */
+static void test_prepare_and_commit()
+{
+	String str("abc");
+	char* room = str.prepare(20);
+	CHECK(room == str.data() + 3 && str.capacity() >= 23 && str.size() == 3);
+	std::memcpy(room, "defgh", 5);
+	str.commit(5);
+	CHECK(str == "abcdefgh" && str.c_str()[8] == '\0');
+
+	// Committing nothing only terminates the text again
+	str.prepare(0);
+	str.commit(0);
+	CHECK(str == "abcdefgh");
+
+	// Up to the capacity is fine, one more throws and leaves the text as it was
+	const size_t left = str.capacity() - str.size();
+	std::memset(str.prepare(left), 'x', left);
+	str.commit(left);
+	CHECK(str.size() == str.capacity() && str.c_str()[str.size()] == '\0');
+	const String before(str);
+	bool thrown = false;
+	try { str.commit(1); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown && str == before);
+	thrown = false;
+	try { str.commit(static_cast<size_t>(-1)); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown && str == before);
+}
+
+/* resize_and_overwrite() lets the operation write the whole text, and keeps the size it returns */
+static void test_resize_and_overwrite()
+{
+	String str("keep");
+	str.resize_and_overwrite(32, [](char* buffer, size_t n) {
+		CHECK(n == 32 && std::memcmp(buffer, "keep", 4) == 0);
+		std::memcpy(buffer + 4, " this", 5);
+		return size_t(9);
+	});
+	CHECK(str == "keep this" && str.size() == 9 && str.capacity() >= 32 && str.c_str()[9] == '\0');
+
+	// Shrinking keeps the buffer, the operation can make the text empty
+	const char* data = str.data();
+	str.resize_and_overwrite(2, [](char*, size_t) { return size_t(2); });
+	CHECK(str == "ke" && str.data() == data);
+	str.resize_and_overwrite(10, [](char*, size_t) { return size_t(0); });
+	CHECK(str.empty() && str.c_str()[0] == '\0');
+
+	// A size past the buffer throws
+	bool thrown = false;
+	try { str.resize_and_overwrite(4, [](char*, size_t n) { return n + 1; }); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+}
+
+/* clear() keeps a buffer up to the high-water mark, and one above it unless it's more than the ratio times the text */
+static void test_memory_policy()
+{
+	String::set_memory_policy(64, 4);
+	auto kept = [](size_t capacity, size_t used) {
+		String str;
+		str.reserve(capacity);
+		str.assign(used, 'a');
+		const size_t before = str.capacity();
+		str.clear();
+		return str.empty() && str.capacity() == before;
+	};
+	// At the mark, and past it with the text exactly a quarter of the capacity, the buffer stays
+	CHECK(kept(64, 0));
+	CHECK(kept(65, 16));
+	CHECK(kept(128, 32));
+	CHECK(!kept(65, 15));
+	CHECK(!kept(128, 31));
+	CHECK(!kept(1000, 0));
+
+	// Ratio 0 keeps every buffer
+	String::set_memory_policy(64, 0);
+	CHECK(kept(1000, 0));
+	// Ratio 1 frees a buffer above the mark, unless the text filled it
+	String::set_memory_policy(0, 1);
+	CHECK(kept(40, 40));
+	CHECK(!kept(40, 39));
+
+	// A freed buffer is a cleared String, that can grow again
+	String::set_memory_policy(64, 4);
+	String str;
+	str.reserve(1000);
+	str.clear();
+	CHECK(str.capacity() == 0 && str.c_str()[0] == '\0');
+	str += "again";
+	CHECK(str == "again");
+
+	// An adopted buffer cleared above the mark is freed with its deleter
+	freedBuffers = 0;
+	str.adopt(malloc_text("abc", 100), 3, 100, free_counted);
+	str.clear();
+	CHECK(freedBuffers == 1 && freedCapacity == 100 && str.capacity() == 0);
+	String::set_memory_policy(1 << 20, 4);
+}
+
+/* release_memory() frees the buffer whatever the policy, leaving an empty String */
+static void test_release_memory()
+{
+	String str("some text to free");
+	str.release_memory();
+	CHECK(str.empty() && str.capacity() == 0 && str.c_str()[0] == '\0');
+	str.release_memory();
+	CHECK(str.empty());
+	str = "back";
+	CHECK(str == "back");
+
+	freedBuffers = 0;
+	str.adopt(malloc_text("abc", 8), 3, 8, free_counted);
+	str.release_memory();
+	CHECK(freedBuffers == 1 && freedCapacity == 8 && str.empty());
+}
+
+int main()
+{
+	test_release_and_adopt();
+	test_deleter();
+	test_adopt_own_buffer();
+	test_moves();
+	test_errors();
+	test_prepare_and_commit();
+	test_resize_and_overwrite();
+	test_memory_policy();
+	test_release_memory();
+	return test_result("buffer_test");
+}
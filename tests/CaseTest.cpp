@@ -0,0 +1,154 @@
+#include "../String.h"
+#include "Test.h"
+
+#include <cctype>
+#include <cstring>
+#include <string>
+
+/* Return the text lowercased by std::tolower(), in the "C" locale it only changes ASCII letters */
+static std::string std_lower(const char* cptr, size_t n)
+{
+	std::string result(cptr, n);
+	for (char& ch : result)
+		ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+	return result;
+}
+
+/* Return the text uppercased by std::toupper() */
+static std::string std_upper(const char* cptr, size_t n)
+{
+	std::string result(cptr, n);
+	for (char& ch : result)
+		ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+	return result;
+}
+
+/* Build a String of the bytes, keeping the NULs among them */
+static String make_string(const char* cptr, size_t n)
+{
+	String str;
+	str.resize(n);
+	for (size_t i = 0; i < n; i++)
+		str[i] = cptr[i];
+	return str;
+}
+
+/* Reduce comparison results to their sign */
+static int sign(int value)
+{
+	return (value > 0) - (value < 0);
+}
+
+/* Find the pattern in the text the slow way, comparing the std::tolower() of every character */
+static size_t naive_ifind(const std::string& text, const std::string& pat, size_t pos)
+{
+	if (pos > text.size())
+		return String::npos;
+	return std_lower(text.data(), text.size()).find(std_lower(pat.data(), pat.size()), pos);
+}
+
+/* Every byte 0-255, at every offset of the 16 byte blocks and lengths around them, converted by
+to_lower(), to_upper(), lower() and upper(), against std::tolower() and std::toupper() */
+static void test_conversions()
+{
+	char bytes[64];
+	for (size_t offset = 0; offset < 16; offset++) {
+		for (size_t len = 0; len <= 48; len++) {
+			for (unsigned first = 0; first < 256; first += (len == 0) ? 256 : 1) {
+				// The text starts (offset) characters into the String, so it lands at every place of a block
+				for (size_t i = 0; i < offset + len; i++)
+					bytes[i] = static_cast<char>(i < offset ? 'Q' : first + (i - offset) * 37);
+				const size_t n = offset + len;
+				String str = make_string(bytes, n);
+				const std::string lowered = std_lower(bytes, n), uppered = std_upper(bytes, n);
+
+				String lower = str.lower(), upper = str.upper();
+				CHECK(lower.size() == n && std::memcmp(lower.data(), lowered.data(), n) == 0);
+				CHECK(upper.size() == n && std::memcmp(upper.data(), uppered.data(), n) == 0);
+				CHECK(lower.c_str()[n] == '\0' && upper.c_str()[n] == '\0');
+
+				String inPlace = str;
+				inPlace.to_lower();
+				CHECK(std::memcmp(inPlace.data(), lowered.data(), n) == 0);
+				inPlace = str;
+				inPlace.to_upper();
+				CHECK(std::memcmp(inPlace.data(), uppered.data(), n) == 0);
+			}
+		}
+	}
+}
+
+/* iequals() and icompare() on pairs of texts differing in case or in one byte, at every place of a block */
+static void test_comparisons()
+{
+	for (size_t len = 0; len <= 48; len++) {
+		for (unsigned ch = 0; ch < 256; ch++) {
+			std::string text(len, 'k');
+			for (size_t i = 0; i < len; i++)
+				text[i] = static_cast<char>(ch + i * 13);
+			std::string flipped = text;
+			for (size_t i = 0; i < len; i += 2)
+				flipped[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(flipped[i])));
+
+			String str = make_string(text.data(), len);
+			CHECK(str.iequals(make_string(flipped.data(), len)));
+			CHECK(str.icompare(make_string(flipped.data(), len)) == 0);
+
+			// One byte changed, at each position
+			for (size_t at = 0; at < len; at++) {
+				std::string changed = flipped;
+				changed[at] = static_cast<char>(changed[at] + 1 + random_below(255));
+				const std::string lhs = std_lower(text.data(), len), rhs = std_lower(changed.data(), len);
+				String other = make_string(changed.data(), len);
+				CHECK(str.iequals(other) == (lhs == rhs));
+				CHECK(sign(str.icompare(other)) == sign(lhs.compare(rhs)));
+			}
+		}
+	}
+
+	// The const char* versions stop at the NUL
+	String text("Hello, World");
+	CHECK(text.iequals("hELLO, wORLD"));
+	CHECK(!text.iequals("hello, world!"));
+	CHECK(text.icompare("HELLO") > 0);
+	CHECK(text.icompare("hello, worlds") < 0);
+	CHECK(text.icompare("HELLO, WORLD") == 0);
+}
+
+/* ifind() and String::isearch() against a search of the lowercased texts, with the text at every alignment */
+static void test_searches()
+{
+	const char alphabet[] = { 'a', 'A', 'b', 'B', '[', '@', '`', '{', 'z', 'Z', static_cast<char>(0xC1), static_cast<char>(0xE1) };
+	char storage[128];
+	for (int round = 0; round < 20000; round++) {
+		const size_t offset = random_below(16), len = random_below(64), patLen = random_below(6);
+		std::string text(len, ' '), pat(patLen, ' ');
+		for (char& ch : text)
+			ch = alphabet[random_below(sizeof(alphabet))];
+		for (char& ch : pat)
+			ch = alphabet[random_below(sizeof(alphabet))];
+		if (len >= patLen && patLen && random_below(2)) {
+			// Plant the pattern with its case flipped, so there's something to find
+			size_t at = random_below(len - patLen + 1);
+			for (size_t i = 0; i < patLen; i++)
+				text[at + i] = static_cast<char>(pat[i] ^ ((std::isalpha(static_cast<unsigned char>(pat[i])) && i % 2) ? 0x20 : 0));
+		}
+		const size_t pos = random_below(len + 3);
+
+		std::memcpy(storage + offset, text.data(), len);
+		const size_t expected = naive_ifind(text, pat, pos);
+		CHECK(String::isearch(storage + offset, len, pat.data(), patLen, pos) == expected);
+		String str = make_string(text.data(), len);
+		CHECK(str.ifind(make_string(pat.data(), patLen), pos) == expected);
+		CHECK(str.ifind(pat.c_str(), pos) == expected);
+	}
+	CHECK(String("abc").ifind(static_cast<const char*>(nullptr)) == String::npos);
+}
+
+int main()
+{
+	test_conversions();
+	test_comparisons();
+	test_searches();
+	return test_result("case_test");
+}
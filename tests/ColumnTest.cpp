@@ -0,0 +1,242 @@
+#include "../StringColumn.h"
+#include "../StringParallel.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Return random text, mostly short */
+static std::string random_text()
+{
+	std::string text(random_below(4) ? random_below(8) : random_below(100), ' ');
+	for (char& ch : text)
+		ch = static_cast<char>('a' + random_below(4));
+	return text;
+}
+
+/* Check the column against the values, that it should hold */
+static void check_equal(const StringColumn& column, const std::vector<std::string>& expected)
+{
+	CHECK(column.size() == expected.size());
+	if (column.size() != expected.size())
+		return;
+	size_t bytes = 0, i = 0;
+	for (const std::string& value : expected) {
+		if (column[i] != value) {
+			CHECK(column[i] == value);
+			return;
+		}
+		bytes += value.size();
+		i++;
+	}
+	CHECK(column.bytes() == bytes);
+	i = 0;
+	column.for_each([&](std::string_view value) { CHECK(value == expected[i++]); });
+}
+
+/* Appending views of the column's own values, while the blob has to grow for them */
+static void test_append_own_values()
+{
+	StringColumn column;
+	column.append("first value");
+	column.append("second value");
+	column.append_all(std::vector<std::string_view>{ column[0], column[1] });
+	check_equal(column, { "first value", "second value", "first value", "second value" });
+
+	// Mixed with other values, and with a blob that has room already
+	column.reserve(100, 1000);
+	std::string other(300, 'x');
+	column.append_all(std::vector<std::string_view>{ column[3], other, column[0] });
+	check_equal(column, { "first value", "second value", "first value", "second value", "second value", other, "first value" });
+
+	// The column itself
+	column.append_all(column);
+	CHECK(column.size() == 14 && column[7] == "first value" && column[13] == "first value");
+}
+
+/* Many small batches grow the blob geometrically, instead of to the exact size every time */
+static void test_repeated_batches()
+{
+	StringColumn column;
+	std::vector<std::string> expected;
+	size_t moves = 0;
+	for (size_t i = 0; i < 80000; i++) {
+		const char* before = column.data();
+		const std::string text = std::to_string(i);
+		column.append_all(std::vector<std::string_view>{ text, "batch" });
+		expected.push_back(text);
+		expected.push_back("batch");
+		moves += column.data() != before;
+	}
+	check_equal(column, expected);
+	CHECK(moves < 40);
+}
+
+/* Random appends, taking values from the column or from outside, against a std::vector<std::string> */
+static void test_random_appends()
+{
+	for (int round = 0; round < 200; round++) {
+		StringColumn column;
+		std::vector<std::string> expected;
+		for (int step = 0; step < 50; step++) {
+			switch (random_below(5)) {
+			case 0: {
+				const std::string text = random_text();
+				column.append(text);
+				expected.push_back(text);
+				break;
+			}
+			case 1:
+				if (!expected.empty()) {
+					const size_t at = random_below(expected.size());
+					column.append(column[at]);
+					expected.push_back(expected[at]);
+				}
+				break;
+			case 2: {
+				std::vector<std::string_view> views;
+				std::vector<std::string> texts, values;
+				texts.reserve(10);
+				for (size_t i = random_below(10); i > 0; i--) {
+					if (!expected.empty() && random_below(2)) {
+						const size_t at = random_below(expected.size());
+						views.push_back(column[at]);
+						values.push_back(expected[at]);
+					}
+					else {
+						texts.push_back(random_text());
+						views.push_back(texts.back());
+						values.push_back(texts.back());
+					}
+				}
+				column.append_all(views);
+				expected.insert(expected.end(), values.begin(), values.end());
+				break;
+			}
+			case 3:
+				if (!expected.empty()) {
+					column.pop_back();
+					expected.pop_back();
+				}
+				break;
+			default: {
+				std::stringstream stream;
+				column.serialize(stream);
+				StringColumn read = StringColumn::deserialize(stream);
+				check_equal(read, expected);
+				CHECK(read == column);
+				break;
+			}
+			}
+			check_equal(column, expected);
+		}
+
+		std::vector<std::string> sorted = expected;
+		std::sort(sorted.begin(), sorted.end());
+		column.sort();
+		check_equal(column, sorted);
+	}
+}
+
+/* Return the positions of the values, for which the predicate is true */
+template<typename Predicate>
+static std::vector<size_t> reference_select(const std::vector<std::string>& values, Predicate predicate)
+{
+	std::vector<size_t> found;
+	for (size_t i = 0; i < values.size(); i++)
+		if (predicate(values[i]))
+			found.push_back(i);
+	return found;
+}
+
+/* Check the selection against the positions, that it should hold */
+static void check_selection(const StringColumn::Selection& selection, const std::vector<size_t>& expected, size_t size)
+{
+	CHECK(selection.size() == size);
+	CHECK(selection.count() == expected.size());
+	CHECK(selection.positions() == expected);
+	for (int k = 0; k < 20 && size; k++) {
+		const size_t at = random_below(size);
+		CHECK(selection.test(at) == std::binary_search(expected.begin(), expected.end(), at));
+	}
+}
+
+/* The predicates and the combined selections against a loop over the values, for a column scanned in one piece and
+for one larger than two chunks of the pool. The values are made of two characters, so the needles are found often,
+also across the ends of the values */
+static void test_predicates()
+{
+	for (size_t total : { size_t(5000), 2 * String_Pool::min_chunk + 100000 }) {
+		StringColumn column;
+		std::vector<std::string> values;
+		size_t bytes = 0;
+		while (bytes < total) {
+			std::string value(random_below(5) ? random_below(12) : random_below(40), 'a');
+			for (char& ch : value)
+				ch = random_below(3) ? 'a' : 'b';
+			bytes += value.size();
+			column.append(value);
+			values.push_back(value);
+		}
+		CHECK(column.bytes() == bytes);
+
+		std::vector<std::string> needles = { "", "a", "b", "aaaaaaa", "aaaaaaaa", "aaaaaaaaa", "abababa", "abababab",
+			"ababababa", "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb" };
+		for (int k = 0; k < 12; k++) {
+			const std::string& value = values[random_below(values.size())];
+			needles.push_back(value.substr(random_below(value.size() + 1)));
+		}
+		std::vector<StringColumn::Selection> selections;
+		std::vector<std::vector<size_t>> expected;
+		for (const std::string& needle : needles) {
+			selections.push_back(column.equals(needle));
+			expected.push_back(reference_select(values, [&](const std::string& value) { return value == needle; }));
+			selections.push_back(column.starts_with(needle));
+			expected.push_back(reference_select(values, [&](const std::string& value) {
+				return value.compare(0, needle.size(), needle) == 0; }));
+			selections.push_back(column.contains(needle));
+			expected.push_back(reference_select(values, [&](const std::string& value) {
+				return value.find(needle) != std::string::npos; }));
+		}
+		for (size_t i = 0; i < selections.size(); i++)
+			check_selection(selections[i], expected[i], values.size());
+
+		for (int k = 0; k < 20; k++) {
+			const size_t lhs = random_below(selections.size()), rhs = random_below(selections.size());
+			std::vector<size_t> both, either;
+			std::set_intersection(expected[lhs].begin(), expected[lhs].end(), expected[rhs].begin(), expected[rhs].end(),
+				std::back_inserter(both));
+			std::set_union(expected[lhs].begin(), expected[lhs].end(), expected[rhs].begin(), expected[rhs].end(),
+				std::back_inserter(either));
+			check_selection(selections[lhs] & selections[rhs], both, values.size());
+			check_selection(selections[lhs] | selections[rhs], either, values.size());
+		}
+	}
+
+	// Selections of different columns don't combine, positions past the end aren't tested
+	StringColumn small;
+	small.append("");
+	small.append("x");
+	StringColumn::Selection selection = small.equals("");
+	check_selection(selection, { 0 }, 2);
+	bool thrown = false;
+	try { selection &= StringColumn().equals(""); } catch (const std::invalid_argument&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { selection.test(2); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+}
+
+int main()
+{
+	test_append_own_values();
+	test_repeated_batches();
+	test_random_appends();
+	test_predicates();
+	return test_result("column_test");
+}
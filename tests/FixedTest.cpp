@@ -0,0 +1,72 @@
+#include "../FixedString.h"
+#include "Test.h"
+
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+/*********************************************** COMPILE-TIME CHECKS ***************************************************/
+
+//Literals, concatenation and comparisons in constant expressions
+constexpr FixedString hello("hello");
+constexpr auto greeting = hello + FixedString(", ") + FixedString("world");
+static_assert(std::is_same_v<decltype(hello), const FixedString<5>>);
+static_assert(greeting.size() == 12 && greeting.view() == "hello, world" && greeting[7] == 'w');
+static_assert(greeting.c_str()[12] == '\0');
+static_assert(hello == FixedString("hello") && hello != FixedString("help!") && FixedString("abc") < FixedString("abd"));
+static_assert(FixedString("").empty() && FixedString<3>("abc", 3).view() == "abc");
+
+#if STRING_HAS_CONSTEXPR
+/* Build a String in a constant expression, only its copy in a FixedString can leave it */
+constexpr String make_key()
+{
+	String key("user");
+	key += '_';
+	key.append("name");
+	return key;
+}
+
+constexpr FixedString<make_key().size()> key(make_key());
+static_assert(key == FixedString("user_name") && key.size() == 9);
+#endif
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+/* FixedString as a template argument, the same text gives the same type */
+template<FixedString Name> struct Field
+{
+	static constexpr std::string_view name = Name;
+};
+
+static_assert(Field<"id">::name == "id" && Field<"">::name.empty());
+static_assert(std::is_same_v<Field<"id">, Field<FixedString("id")>> && !std::is_same_v<Field<"id">, Field<"ID">>);
+static_assert(Field<greeting>::name == "hello, world");
+#endif
+
+/*********************************************** RUN-TIME CHECKS ***************************************************/
+
+/* Lengths that don't match and positions past the end throw out_of_range, str() gives the text back */
+static void test_run_time()
+{
+	bool thrown = false;
+	try { FixedString<3> text("abcd", 4); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { FixedString<3> text(String("ab")); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { greeting[12]; } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+
+	const String str = greeting.str();
+	CHECK(str == "hello, world" && str.size() == greeting.size());
+	const FixedString<12> copy(str);
+	CHECK(copy == greeting);
+	std::string_view view = copy;
+	CHECK(view == "hello, world");
+}
+
+int main()
+{
+	test_run_time();
+	return test_result("fixed_test");
+}
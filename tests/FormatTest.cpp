@@ -0,0 +1,122 @@
+#include "../String.h"
+#include "Test.h"
+
+#include <cfloat>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/* Check if the String holds the text */
+static bool holds(const String& str, const std::string& text)
+{
+	return std::string_view(str.data(), str.size()) == text && str.c_str()[str.size()] == '\0';
+}
+
+/* Return the text printf() makes of the arguments */
+template<typename... Args>
+static std::string printed(const char* fmt, Args... args)
+{
+	char buffer[512];
+	std::snprintf(buffer, sizeof(buffer), fmt, args...);
+	return buffer;
+}
+
+/* Return the shortest representation of the value, that reads back to it */
+template<typename Floating>
+static std::string shortest(Floating value)
+{
+	char buffer[64];
+	return std::string(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+/* Every kind of argument and every replacement field, written out by hand */
+static void test_fields()
+{
+	CHECK(holds(String::format("plain text"), "plain text"));
+	CHECK(holds(String::format(""), ""));
+	CHECK(holds(String::format("{} and {}", 42, -7), "42 and -7"));
+	CHECK(holds(String::format("{:x} {:X} {:x}", 255, 48879u, -255), "ff BEEF -ff"));
+	CHECK(holds(String::format("{}|{:x}", LLONG_MIN, ULLONG_MAX), std::to_string(LLONG_MIN) + "|ffffffffffffffff"));
+	CHECK(holds(String::format("{:.2f} {:.0f} {:.3f}", 3.14159, 2.5, -0.0005), "3.14 2 -0.001"));
+	CHECK(holds(String::format("{} {} {}", 0.1, 1e100, 0.1f), "0.1 1e+100 0.1"));
+	CHECK(holds(String::format("{:.3} {:.10}", 3.14159, 1.0 / 3), "3.14 0.3333333333"));
+	CHECK(holds(String::format("{}{}{}", 'a', true, false), "atruefalse"));
+	const String str("String");
+	const std::string_view view("view");
+	CHECK(holds(String::format("{} {} {}", str, view, "literal"), "String view literal"));
+	CHECK(holds(String::format("{{}} {{{}}} }}{{", 5), "{} {5} }{"));
+}
+
+/* Random integers and floating-point values against printf() */
+static void test_random_values()
+{
+	for (int round = 0; round < 20000; round++) {
+		const unsigned long long bits = (static_cast<unsigned long long>(test_random()()) << 32) | test_random()();
+		const long long i = static_cast<long long>(bits) >> random_below(64);
+		const unsigned long long u = bits >> random_below(64);
+		CHECK(holds(String::format("{}:{}:{:x}:{:X}", i, u, u, u), printed("%lld:%llu:%llx:%llX", i, u, u, u)));
+
+		double d;
+		std::memcpy(&d, &bits, sizeof(d));
+		if (!std::isfinite(d) || std::fabs(d) > 1e30)
+			d = static_cast<double>(i) / (1 + random_below(1000));
+		CHECK(holds(String::format("{}", d), shortest(d)));
+		CHECK(holds(String::format("{:.2f}|{:.0f}|{:.17f}", d, d, d), printed("%.2f|%.0f|%.17f", d, d, d)));
+		CHECK(holds(String::format("{:.5}|{:.17}", d, d), printed("%.5g|%.17g", d, d)));
+		const float f = static_cast<float>(d);
+		CHECK(holds(String::format("{}", f), shortest(f)));
+	}
+	CHECK(holds(String::format("{:.99f}", DBL_MAX), printed("%.99f", DBL_MAX)));
+}
+
+/* format_to() appends to the text already there, also when an argument is a view of it */
+static void test_format_to()
+{
+	String out("x=");
+	format_to(out, "{}, y={:x}", 10, 255);
+	CHECK(holds(out, "x=10, y=ff"));
+	format_to(out, "; again: {}", std::string_view(out.data(), 4));
+	CHECK(holds(out, "x=10, y=ff; again: x=10"));
+	std::string expected;
+	String many;
+	for (int i = 0; i < 1000; i++) {
+		format_to(many, "[{}]", i);
+		expected += "[" + std::to_string(i) + "]";
+	}
+	CHECK(holds(many, expected));
+}
+
+#if !defined(__cpp_consteval)
+/* Without consteval, the format strings are checked when they are made, and wrong ones throw runtime_error */
+static void test_errors()
+{
+	auto throws = [](auto make) {
+		try { make(); } catch (const std::runtime_error&) { return true; }
+		return false;
+	};
+	CHECK(throws([] { String::format("{}"); }));
+	CHECK(throws([] { String::format("{} {}", 1); }));
+	CHECK(throws([] { String::format("", 1); }));
+	CHECK(throws([] { String::format("{:x}", 1.5); }));
+	CHECK(throws([] { String::format("{:.2f}", 1); }));
+	CHECK(throws([] { String::format("{:.100f}", 1.0); }));
+	CHECK(throws([] { String::format("{", 1); }));
+	CHECK(throws([] { String::format("}"); }));
+}
+#endif
+
+int main()
+{
+	test_fields();
+	test_random_values();
+	test_format_to();
+#if !defined(__cpp_consteval)
+	test_errors();
+#endif
+	return test_result("format_test");
+}
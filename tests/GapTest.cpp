@@ -0,0 +1,175 @@
+#include "../GapString.h"
+#include "Test.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/* Return random text of (n) characters */
+static std::string random_text(size_t n)
+{
+	std::string text(n, ' ');
+	for (char& ch : text)
+		ch = static_cast<char>('a' + random_below(6));
+	return text;
+}
+
+/* Check every way of reading the GapString against the text, that it should hold. The const reads leave the gap where it is */
+static void check_equal(const GapString& str, const std::string& expected)
+{
+	CHECK(str.size() == expected.size());
+	CHECK(str.empty() == expected.empty());
+	CHECK(str.capacity() >= str.size());
+	CHECK(str.gap_position() <= str.size());
+	String text = str.str();
+	CHECK(std::string(text.data(), text.size()) == expected);
+	for (size_t i = 0; i < expected.size(); i++) {
+		if (str[i] != expected[i]) {
+			CHECK(str[i] == expected[i]);
+			break;
+		}
+	}
+	if (!expected.empty())
+		CHECK(str.front() == expected.front() && str.back() == expected.back());
+}
+
+/* Random edits of a GapString and a std::string, checked against each other after every one. Most edits happen near
+the last one, like typing around a cursor, the others jump anywhere and move the gap far */
+static void test_edits()
+{
+	for (int round = 0; round < 200; round++) {
+		std::string expected = random_text(random_below(200));
+		GapString str(expected.c_str(), expected.size());
+		size_t cursor = random_below(expected.size() + 1);
+
+		for (int step = 0; step < 300; step++) {
+			if (random_below(8) == 0)
+				cursor = random_below(expected.size() + 1);
+			else if (cursor > expected.size())
+				cursor = expected.size();
+			const size_t pos = cursor;
+			const size_t len = random_below(4) ? random_below(expected.size() - pos + 1) % 8 : GapString::npos;
+			const std::string text = random_text(random_below(4) ? random_below(4) : random_below(300));
+			switch (random_below(14)) {
+			case 0:
+				str.insert(pos, text.c_str(), text.size());
+				expected.insert(pos, text);
+				cursor += text.size();
+				break;
+			case 1:
+				str.insert(pos, String(text.c_str()));
+				expected.insert(pos, text);
+				break;
+			case 2: {
+				const size_t n = random_below(5);
+				str.insert(pos, n, 'z');
+				expected.insert(pos, n, 'z');
+				break;
+			}
+			case 3:
+				str.erase(pos, len);
+				expected.erase(pos, len);
+				break;
+			case 4:
+				if (pos) {
+					str.erase(pos - 1, 1);
+					expected.erase(pos - 1, 1);
+					cursor--;
+				}
+				break;
+			case 5:
+				str.replace(pos, len, text.c_str(), text.size());
+				expected.replace(pos, len, text);
+				break;
+			case 6: {
+				const size_t n = random_below(5);
+				str.replace(pos, len, n, 'y');
+				expected.replace(pos, len, n, 'y');
+				break;
+			}
+			case 7:
+				str.append(text.c_str(), text.size());
+				expected += text;
+				break;
+			case 8:
+				str.push_back('x');
+				expected.push_back('x');
+				break;
+			case 9:
+				if (!expected.empty()) {
+					str.pop_back();
+					expected.pop_back();
+				}
+				break;
+			case 10: {
+				// Text of the GapString itself, from the buffer that the edit is changing
+				const char* own = str.c_str();
+				CHECK(std::strcmp(own, expected.c_str()) == 0);
+				const size_t from = random_below(expected.size() + 1), n = random_below(expected.size() - from + 1);
+				str.insert(pos, own + from, n);
+				expected.insert(pos, expected.substr(from, n));
+				break;
+			}
+			case 11:
+				if (!expected.empty()) {
+					const size_t at = random_below(expected.size());
+					str[at] = 'Q';
+					expected[at] = 'Q';
+				}
+				break;
+			case 12: {
+				GapString copy(str);
+				check_equal(copy, expected);
+				GapString moved(std::move(copy));
+				check_equal(moved, expected);
+				CHECK(moved == str && !(moved != str));
+				moved.push_back('!');
+				CHECK(moved != str);
+				str.swap(moved);
+				check_equal(moved, expected);
+				expected.push_back('!');
+				break;
+			}
+			default:
+				str.reserve(expected.size() + random_below(100));
+				break;
+			}
+			check_equal(str, expected);
+		}
+	}
+}
+
+/* Positions past the end throw out_of_range, reading an empty GapString throws runtime_error */
+static void test_errors()
+{
+	GapString str("abc");
+	bool thrown = false;
+	try { str.insert(4, "x"); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { str.erase(4); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { str.replace(4, 1, "x"); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { str.at(3); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	GapString empty;
+	thrown = false;
+	try { empty.pop_back(); } catch (const std::runtime_error&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { empty.front(); } catch (const std::runtime_error&) { thrown = true; }
+	CHECK(thrown);
+	check_equal(str, "abc");
+	CHECK(std::strcmp(empty.c_str(), "") == 0);
+}
+
+int main()
+{
+	test_edits();
+	test_errors();
+	return test_result("gap_test");
+}
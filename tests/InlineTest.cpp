@@ -0,0 +1,115 @@
+#include "../InlineString.h"
+#include "Test.h"
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/*********************************************** COMPILE-TIME CHECKS ***************************************************/
+
+//Trivially copyable with every policy, the length takes one byte up to 255 characters
+static_assert(std::is_trivially_copyable_v<InlineString<15>>);
+static_assert(std::is_trivially_copyable_v<InlineString<1000, Overflow_Policy::Truncate>>);
+static_assert(std::is_trivially_copyable_v<InlineString<7, Overflow_Policy::Assert>>);
+static_assert(std::is_same_v<InlineString<255>::length_type, uint8_t> && std::is_same_v<InlineString<256>::length_type, uint16_t>);
+static_assert(sizeof(InlineString<15>) == 17 && sizeof(InlineString<31>) == 33 && sizeof(InlineString<255>) == 257);
+static_assert(sizeof(InlineString<256>) == 260 && sizeof(InlineString<70000>) == 70008);
+
+/* Build an InlineString in a constant expression */
+constexpr InlineString<16> make_text()
+{
+	InlineString<16> text("abc");
+	text += "def";
+	text.push_back('!');
+	text.erase(1, 2);
+	return text;
+}
+
+static_assert(make_text() == "adef!" && make_text().size() == 5 && make_text().back() == '!');
+
+/*********************************************** RUN-TIME CHECKS ***************************************************/
+
+/* Throw leaves the text as it was and throws length_error, from every function that adds characters */
+static void test_throw()
+{
+	InlineString<8> text("abcdef");
+	auto throws = [&](auto change) {
+		try { change(); } catch (const std::length_error&) { return text == "abcdef" && text.c_str()[6] == '\0'; }
+		return false;
+	};
+	CHECK(throws([&] { text.append("xyz"); }));
+	CHECK(throws([&] { text.append(3, 'x'); }));
+	CHECK(throws([&] { text.append(String("xyz")); }));
+	CHECK(throws([&] { text.resize(9); }));
+	CHECK(throws([&] { InlineString<8> other("abcdefghi"); }));
+	text += "gh";
+	CHECK(text.full() && text == "abcdefgh");
+	bool thrown = false;
+	try { text.push_back('i'); } catch (const std::length_error&) { thrown = true; }
+	CHECK(thrown && text == "abcdefgh");
+}
+
+/* Truncate keeps the characters that fit, Assert does the same when asserts are off */
+static void test_truncate()
+{
+	InlineString<8, Overflow_Policy::Truncate> text("abcdef");
+	text.append("xyz");
+	CHECK(text == "abcdefxy" && text.full() && text.c_str()[8] == '\0');
+	text.push_back('!');
+	text.append(5, '?');
+	CHECK(text == "abcdefxy");
+	InlineString<4, Overflow_Policy::Truncate> cut(String("longer"));
+	CHECK(cut == "long");
+
+#ifdef NDEBUG
+	InlineString<4, Overflow_Policy::Assert> asserted("ab");
+	asserted.append("cdef");
+	CHECK(asserted == "abcd" && asserted.size() == 4);
+#endif
+	InlineString<4, Overflow_Policy::Assert> fits("ab");
+	fits.append("cd");
+	CHECK(fits == "abcd");
+}
+
+/* Appending the InlineString to itself reads the characters before they are overwritten */
+static void test_self_append()
+{
+	InlineString<16> text("abc");
+	text.append(text);
+	CHECK(text == "abcabc");
+	text += text.c_str();
+	CHECK(text == "abcabcabcabc");
+	bool thrown = false;
+	try { text += text; } catch (const std::length_error&) { thrown = true; }
+	CHECK(thrown && text == "abcabcabcabc");
+
+	InlineString<10, Overflow_Policy::Truncate> cut("12345678");
+	cut.append(cut);
+	CHECK(cut == "1234567812" && cut.c_str()[10] == '\0');
+}
+
+/* str() and InlineString(String) give the same text back, NUL characters included */
+static void test_round_trips()
+{
+	const std::string texts[] = { "", "a", "hello world", std::string("with\0nul", 8), std::string(255, 'x') };
+	for (const std::string& text : texts) {
+		const String str(text.begin(), text.end());
+		const InlineString<255> inlined(str);
+		CHECK(inlined.size() == text.size() && inlined.view() == text);
+		const String back = inlined.str();
+		CHECK(back == str && back.size() == text.size());
+		CHECK(inlined.compare(str) == 0);
+	}
+	bool thrown = false;
+	try { InlineString<3> small(String("abcd")); } catch (const std::length_error&) { thrown = true; }
+	CHECK(thrown);
+}
+
+int main()
+{
+	test_throw();
+	test_truncate();
+	test_self_append();
+	test_round_trips();
+	return test_result("inline_test");
+}
@@ -0,0 +1,125 @@
+#include "../String.h"
+#include "Test.h"
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+/* Check if the String holds the text */
+static bool holds(const String& str, const std::string& text)
+{
+	return std::string(str.data(), str.size()) == text && str.c_str()[str.size()] == '\0';
+}
+
+/* Return true if the call throws the given exception */
+template<typename Exception, typename Function>
+static bool throws(Function function)
+{
+	try { function(); } catch (const Exception&) { return true; }
+	return false;
+}
+
+/* The limits and random values are written like std::to_string(), and read back to the same value */
+static void test_round_trips()
+{
+	CHECK(holds(String::from_int(LLONG_MIN), std::to_string(LLONG_MIN)));
+	CHECK(holds(String::from_int(LLONG_MAX), std::to_string(LLONG_MAX)));
+	CHECK(holds(String::from_int(0), "0"));
+	CHECK(holds(String::from_uint(ULLONG_MAX), std::to_string(ULLONG_MAX)));
+	CHECK(String::from_int(LLONG_MIN).to_int() == LLONG_MIN);
+	CHECK(String::from_uint(ULLONG_MAX).to_uint() == ULLONG_MAX);
+
+	const double doubles[] = { DBL_MAX, -DBL_MAX, DBL_MIN, DBL_TRUE_MIN, DBL_EPSILON, 0.1, 1.0 / 3, -0.0, 1e23, 123456.789 };
+	for (double value : doubles) {
+		const double read = String::from_double(value).to_double();
+		CHECK(read == value && std::signbit(read) == std::signbit(value));
+	}
+	CHECK(holds(String::from_double(0.1), "0.1"));
+
+	for (int i = 0; i < 100000; i++) {
+		const unsigned long long bits = (static_cast<unsigned long long>(test_random()()) << 32) | test_random()();
+		const unsigned long long u = bits >> random_below(64);
+		const long long s = static_cast<long long>(bits) >> random_below(64);
+		CHECK(holds(String::from_uint(u), std::to_string(u)) && String::from_uint(u).to_uint() == u);
+		CHECK(holds(String::from_int(s), std::to_string(s)) && String::from_int(s).to_int() == s);
+		double d;
+		std::memcpy(&d, &bits, sizeof(d));
+		if (std::isfinite(d))
+			CHECK(String::from_double(d).to_double() == d);
+	}
+}
+
+/* append_number() appends to what the String holds, for every integer type and both floating ones */
+static void test_append_number()
+{
+	String str("n=");
+	str.append_number(static_cast<short>(-32768)).append_number(' ');
+	CHECK(holds(str, "n=-3276832"));
+	str.append_number(static_cast<unsigned char>(200)).append_number(true).append_number(LLONG_MIN).append_number(ULLONG_MAX);
+	CHECK(holds(str, "n=-32768322001" + std::to_string(LLONG_MIN) + std::to_string(ULLONG_MAX)));
+
+	String floating;
+	floating.append_number(0.1f).append_number(';').append_number(DBL_MAX);
+	CHECK(holds(floating, "0.1591.7976931348623157e+308"));
+	String many;
+	std::string expected;
+	for (int i = -1000; i < 1000; i++) {
+		many.append_number(i * 7919LL);
+		expected += std::to_string(i * 7919LL);
+	}
+	CHECK(holds(many, expected));
+}
+
+/* Leading whitespace and one plus sign are skipped, (idx) counts them with the digits */
+static void test_prefixes()
+{
+	size_t idx = 0;
+	CHECK(String("  \t+42xyz").to_int(&idx) == 42 && idx == 6);
+	CHECK(String("\n-17").to_int(&idx) == -17 && idx == 4);
+	CHECK(String(" +7").to_uint(&idx) == 7 && idx == 3);
+	CHECK(String(" +1.5e3rest").to_double(&idx) == 1500 && idx == 7);
+	CHECK(String("-2.5").to_double(&idx) == -2.5 && idx == 4);
+	CHECK(String("ff").to_int(&idx, 16) == 255 && idx == 2);
+	CHECK(String("-101").to_int(&idx, 2) == -5 && idx == 4);
+	CHECK(String("zz").to_uint(&idx, 36) == 35 * 36 + 35 && idx == 2);
+	// No "0x" prefix is read, only the 0 in front of it
+	CHECK(String("0x10").to_uint(&idx, 16) == 0 && idx == 1);
+}
+
+/* No number, a base from_chars() doesn't read and a value that doesn't fit throw, without changing (idx) */
+static void test_errors()
+{
+	size_t idx = 99;
+	CHECK(throws<std::invalid_argument>([&] { String("").to_int(&idx); }));
+	CHECK(throws<std::invalid_argument>([&] { String("   ").to_int(&idx); }));
+	CHECK(throws<std::invalid_argument>([&] { String("abc").to_uint(&idx); }));
+	CHECK(throws<std::invalid_argument>([&] { String("+-1").to_int(&idx); }));
+	CHECK(throws<std::invalid_argument>([&] { String("+").to_double(&idx); }));
+	CHECK(throws<std::invalid_argument>([&] { String("-5").to_uint(&idx); }));
+	CHECK(idx == 99);
+
+	for (int base : { -1, 0, 1, 37, 100 }) {
+		CHECK(throws<std::invalid_argument>([&] { String("10").to_int(&idx, base); }));
+		CHECK(throws<std::invalid_argument>([&] { String("10").to_uint(&idx, base); }));
+	}
+
+	CHECK(throws<std::out_of_range>([&] { String("9223372036854775808").to_int(&idx); }));
+	CHECK(throws<std::out_of_range>([&] { String("-9223372036854775809").to_int(&idx); }));
+	CHECK(throws<std::out_of_range>([&] { String("18446744073709551616").to_uint(&idx); }));
+	CHECK(throws<std::out_of_range>([&] { String("10000000000000000").to_uint(&idx, 36); }));
+	CHECK(throws<std::out_of_range>([&] { String("1e400").to_double(&idx); }));
+	CHECK(throws<std::out_of_range>([&] { String("-1e400").to_double(&idx); }));
+	CHECK(idx == 99);
+}
+
+int main()
+{
+	test_round_trips();
+	test_append_number();
+	test_prefixes();
+	test_errors();
+	return test_result("number_test");
+}
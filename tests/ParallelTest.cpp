@@ -0,0 +1,100 @@
+#include "../String.h"
+#include "../StringParallel.h"
+#include "Test.h"
+
+#include <string>
+#include <vector>
+
+/* Check the parallel search against find(), count() and find_all() of the same String */
+static void check_parallel(const String& text, const char* needle, size_t pos)
+{
+	const std::vector<size_t> expected = text.find_all(needle, pos);
+	CHECK(text.parallel_find_all(needle, pos) == expected);
+	CHECK(text.parallel_count(needle, pos) == text.count(needle, pos));
+	CHECK(text.parallel_count(needle, pos) == expected.size());
+	CHECK(text.parallel_find(needle, pos) == text.find(needle, pos));
+	const String str(needle);
+	CHECK(text.parallel_count(str, pos) == expected.size());
+	CHECK(text.parallel_find(str, pos) == text.find(str, pos));
+}
+
+/* Return the start of the chunk (i), the way parallel_matches() splits the text between (chunks) chunks */
+static size_t chunk_start(size_t size, size_t patLen, size_t pos, size_t chunks, size_t i)
+{
+	const size_t starts = size - patLen + 1 - pos;
+	return pos + starts * i / chunks;
+}
+
+/* Return the number of chunks the text is split into */
+static size_t chunk_count(size_t size, size_t patLen, size_t pos)
+{
+	const size_t chunks = (size - patLen + 1 - pos) / String_Pool::min_chunk, most = String_Pool::shared().size() * 4;
+	return (chunks < most) ? chunks : most;
+}
+
+/* Texts of a few chunks, made of one repeated piece, where the overlapping matches run through every chunk boundary.
+The text sizes and the starting positions move the boundaries around the matches */
+static void test_self_similar()
+{
+	struct Case { const char* piece; const char* needles[2]; };
+	const Case cases[] = { { "a", { "aa", "aaa" } }, { "ab", { "aba", "abab" } }, { "aab", { "aa", "abaa" } },
+		{ "abaab", { "aba", "abaab" } } };
+	for (const Case& c : cases) {
+		for (size_t extra = 0; extra < 3; extra++) {
+			std::string repeated;
+			const size_t size = 3 * String_Pool::min_chunk + extra;
+			while (repeated.size() < size)
+				repeated += c.piece;
+			const String text(repeated.c_str());
+			for (const char* needle : c.needles)
+				for (size_t pos : { size_t(0), size_t(1), size_t(5) })
+					check_parallel(text, needle, pos);
+		}
+	}
+}
+
+/* The only match straddles a chunk boundary, or starts right at it, or right before it */
+static void test_boundary_matches()
+{
+	const size_t size = 4 * String_Pool::min_chunk + 123;
+	const char needle[] = "xyzzy";
+	const size_t patLen = sizeof(needle) - 1;
+	for (size_t pos : { size_t(0), size_t(3), size_t(1000) }) {
+		const size_t chunks = chunk_count(size, patLen, pos);
+		CHECK(chunks >= 2);
+		for (size_t i = 1; i < chunks; i++) {
+			const size_t boundary = chunk_start(size, patLen, pos, chunks, i);
+			for (size_t at : { boundary - 3, boundary - 1, boundary, boundary + 1 }) {
+				String text(size, 'x');
+				text.replace(at, patLen, needle);
+				check_parallel(text, needle, pos);
+				CHECK(text.parallel_find(needle, pos) == at);
+				check_parallel(text, "yx", pos);
+			}
+		}
+	}
+}
+
+/* Random runs of two characters, searched from random positions */
+static void test_random_texts()
+{
+	for (int round = 0; round < 3; round++) {
+		std::string text;
+		const size_t size = 3 * String_Pool::min_chunk + random_below(String_Pool::min_chunk);
+		while (text.size() < size)
+			text.append(1 + random_below(6), random_below(3) ? 'a' : 'b');
+		const String str(text.c_str());
+		for (const char* needle : { "aa", "aba", "abba", "aab", "bab" }) {
+			check_parallel(str, needle, random_below(100));
+			check_parallel(str, needle, random_below(size));
+		}
+	}
+}
+
+int main()
+{
+	test_self_similar();
+	test_boundary_matches();
+	test_random_texts();
+	return test_result("parallel_test");
+}
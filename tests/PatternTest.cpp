@@ -0,0 +1,195 @@
+#include "../StringPattern.h"
+#include "../StringColumn.h"
+#include "Test.h"
+
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* One element of a pattern: a literal character, any character, any number of characters, or a set */
+struct Token
+{
+	enum Kind { Literal, Any, Star, Set } kind;
+	char ch = 0;
+	bool member[256] = {}; // Characters listed in the set, before it's negated and the case is ignored
+	bool negated = false;
+};
+
+/* Check if the token matches one character of the text, std::tolower() and std::toupper() fold the case */
+static bool token_matches(const Token& token, unsigned char ch, bool ignoreCase)
+{
+	if (token.kind == Token::Any)
+		return true;
+	if (token.kind == Token::Literal) {
+		unsigned char lit = static_cast<unsigned char>(token.ch);
+		return ignoreCase ? std::tolower(ch) == std::tolower(lit) : ch == lit;
+	}
+	bool in = token.member[ch] || (ignoreCase && (token.member[std::tolower(ch)] || token.member[std::toupper(ch)]));
+	return in != token.negated;
+}
+
+/* Match the whole text against the tokens the slow and simple way: (matched[i][j]) tells if the first (i) tokens
+match the first (j) characters */
+static bool reference_matches(const std::vector<Token>& tokens, const std::string& text, bool ignoreCase)
+{
+	std::vector<std::vector<char>> matched(tokens.size() + 1, std::vector<char>(text.size() + 1, 0));
+	matched[0][0] = 1;
+	for (size_t i = 1; i <= tokens.size(); i++) {
+		const Token& token = tokens[i - 1];
+		for (size_t j = 0; j <= text.size(); j++) {
+			if (token.kind == Token::Star)
+				matched[i][j] = matched[i - 1][j] || (j && matched[i][j - 1]);
+			else
+				matched[i][j] = j && matched[i - 1][j - 1] && token_matches(token, static_cast<unsigned char>(text[j - 1]), ignoreCase);
+		}
+	}
+	return matched[tokens.size()][text.size()];
+}
+
+/* Characters the patterns and the texts are made of, with both cases, wildcards and bytes past ASCII */
+static const char alphabet[] = { 'a', 'b', 'A', 'B', 'x', '-', '%', '_', '*', '?', '[', ']', '!', '\\', '#', '.',
+	static_cast<char>(0xC1), static_cast<char>(0xE1) };
+
+/* Return a random character of the alphabet */
+static char random_char()
+{
+	return alphabet[random_below(sizeof(alphabet))];
+}
+
+/* Build random tokens and write them as a LIKE or glob pattern */
+static std::string random_pattern(std::vector<Token>& tokens, bool glob, char escape)
+{
+	std::string pattern;
+	const size_t count = random_below(10);
+	for (size_t i = 0; i < count; i++) {
+		Token token{};
+		const size_t kind = random_below(10);
+		if (kind < 5) {
+			token.kind = Token::Literal;
+			token.ch = random_char();
+			bool special = glob ? (token.ch == '*' || token.ch == '?' || token.ch == '[' || token.ch == '\\')
+				: (token.ch == '%' || token.ch == '_' || token.ch == escape);
+			// Other characters may be escaped too, the escape then changes nothing
+			if (special || random_below(8) == 0)
+				pattern += glob ? '\\' : escape;
+			pattern += token.ch;
+		}
+		else if (kind < 7) {
+			token.kind = Token::Star;
+			pattern += glob ? '*' : '%';
+		}
+		else if (kind < 9 || !glob) {
+			token.kind = Token::Any;
+			pattern += glob ? '?' : '_';
+		}
+		else {
+			token.kind = Token::Set;
+			token.negated = random_below(2);
+			pattern += '[';
+			if (token.negated)
+				pattern += random_below(2) ? '!' : '^';
+			const char members[] = { 'a', 'b', 'A', 'B', 'x', 'z', '0', static_cast<char>(0xC1) };
+			for (size_t m = 1 + random_below(3); m > 0; m--) {
+				char low = members[random_below(sizeof(members))];
+				if (random_below(3) == 0) {
+					char high = members[random_below(sizeof(members))];
+					pattern += low;
+					pattern += '-';
+					pattern += high;
+					for (unsigned ch = static_cast<unsigned char>(low); ch <= static_cast<unsigned char>(high); ch++)
+						token.member[ch] = true;
+				}
+				else {
+					pattern += low;
+					token.member[static_cast<unsigned char>(low)] = true;
+				}
+			}
+			pattern += ']';
+		}
+		tokens.push_back(token);
+	}
+	return pattern;
+}
+
+/* Return random text, sometimes long enough that the parts between the stars are searched for */
+static std::string random_text()
+{
+	std::string text(random_below(4) ? random_below(10) : random_below(60), ' ');
+	for (char& ch : text)
+		ch = random_char();
+	return text;
+}
+
+/* Random LIKE and glob patterns, matched against random texts and checked against the reference matcher */
+static void test_random_patterns()
+{
+	for (int round = 0; round < 20000; round++) {
+		const bool glob = random_below(2), ignoreCase = random_below(3) == 0;
+		const char escape = random_below(2) ? '\\' : '#';
+		std::vector<Token> tokens;
+		const std::string pattern = random_pattern(tokens, glob, escape);
+		String_Pattern compiled(pattern, glob ? Pattern_Syntax::Glob : Pattern_Syntax::Like, ignoreCase, escape);
+		CHECK(compiled.ignores_case() == ignoreCase);
+
+		std::vector<std::string> texts;
+		for (int k = 0; k < 20; k++) {
+			std::string text = random_text();
+			// Some texts are made to match, from the tokens themselves
+			if (k % 4 == 0) {
+				text.clear();
+				for (const Token& token : tokens) {
+					if (token.kind == Token::Literal)
+						text += token.ch;
+					else if (token.kind != Token::Star || random_below(2))
+						text += random_char();
+				}
+			}
+			const bool expected = reference_matches(tokens, text, ignoreCase);
+			CHECK(compiled.matches(text) == expected);
+			CHECK(compiled.matches(String(text.c_str())) == reference_matches(tokens, text.c_str(), ignoreCase));
+			if (expected)
+				CHECK(text.size() >= compiled.min_length());
+			texts.push_back(text);
+		}
+
+		// The column selects the same values
+		if (round % 50 == 0) {
+			StringColumn column;
+			std::vector<std::string_view> views(texts.begin(), texts.end());
+			column.append_all(views);
+			std::vector<size_t> expected;
+			for (size_t i = 0; i < texts.size(); i++)
+				if (reference_matches(tokens, texts[i], ignoreCase))
+					expected.push_back(i);
+			CHECK(column.matching(compiled).positions() == expected);
+		}
+	}
+}
+
+/* A pattern ending with the escape throws, a [ without its ] is a literal */
+static void test_edge_cases()
+{
+	bool thrown = false;
+	try { String_Pattern bad("ab\\"); } catch (const std::invalid_argument&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { String_Pattern bad("ab#", Pattern_Syntax::Like, false, '#'); } catch (const std::invalid_argument&) { thrown = true; }
+	CHECK(thrown);
+
+	String_Pattern open("a[b", Pattern_Syntax::Glob);
+	CHECK(open.matches("a[b") && !open.matches("ab"));
+	String_Pattern first("[]a]", Pattern_Syntax::Glob);
+	CHECK(first.matches("]") && first.matches("a") && !first.matches("b"));
+	String_Pattern empty("");
+	CHECK(empty.matches("") && !empty.matches("a"));
+	CHECK(String_Pattern("%").matches("") && String_Pattern("%").matches("anything"));
+}
+
+int main()
+{
+	test_random_patterns();
+	test_edge_cases();
+	return test_result("pattern_test");
+}
@@ -0,0 +1,172 @@
+#include "../String.h"
+#include "Test.h"
+
+#include <deque>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __cpp_lib_concepts
+#include <ranges>
+
+/*********************************************** COMPILE-TIME CHECKS ***************************************************/
+
+//The iterators are contiguous, so the standard algorithms and ranges can treat the text as an array. Only a const String
+//is a contiguous range, data() gives a const pointer
+static_assert(std::contiguous_iterator<String::iterator> && std::contiguous_iterator<String::const_iterator>);
+static_assert(std::ranges::contiguous_range<const String> && std::ranges::random_access_range<String>);
+static_assert(std::random_access_iterator<String::reverse_iterator> && !std::contiguous_iterator<String::reverse_iterator>);
+#endif
+
+/*********************************************** RUN-TIME CHECKS ***************************************************/
+
+/* Check if the String holds the text, terminated */
+static bool holds(const String& str, const std::string& text)
+{
+	return std::string_view(str.data(), str.size()) == text && str.c_str()[str.size()] == '\0';
+}
+
+/* Return random bytes, NUL characters included */
+static std::string random_text(size_t len)
+{
+	std::string text(len, '\0');
+	for (char& ch : text)
+		ch = static_cast<char>(random_below(256));
+	return text;
+}
+
+/* Check every member taking a range with the range, against std::string */
+template<typename It>
+static void check_members(It first, It last, const std::string& range)
+{
+	const std::string base = random_text(random_below(40));
+	const size_t at = random_below(base.size() + 1), count = random_below(base.size() - at + 1);
+
+	CHECK(holds(String(first, last), range));
+	String str(base.begin(), base.end());
+	str.append(first, last);
+	CHECK(holds(str, base + range));
+	str.assign(base.begin(), base.end());
+	str.assign(first, last);
+	CHECK(holds(str, range));
+
+	str.assign(base.begin(), base.end());
+	const String::iterator past = str.insert(str.begin() + at, first, last);
+	CHECK(holds(str, std::string(base).insert(at, range)) && past == str.begin() + at + range.size());
+	str.assign(base.begin(), base.end());
+	str.replace(str.begin() + at, str.begin() + at + count, first, last);
+	CHECK(holds(str, std::string(base).replace(at, count, range)));
+}
+
+/* Ranges of every iterator category, contiguous or not */
+static void test_containers()
+{
+	for (int round = 0; round < 500; round++) {
+		const std::string text = random_text(random_below(4) ? random_below(100) : random_below(5000));
+		const std::vector<char> vector(text.begin(), text.end());
+		const std::list<char> list(text.begin(), text.end());
+		const std::deque<char> deque(text.begin(), text.end());
+		const String str(text.begin(), text.end());
+		check_members(text.data(), text.data() + text.size(), text);
+		check_members(text.begin(), text.end(), text);
+		check_members(vector.begin(), vector.end(), text);
+		check_members(list.begin(), list.end(), text);
+		check_members(list.rbegin(), list.rend(), std::string(text.rbegin(), text.rend()));
+		check_members(deque.begin(), deque.end(), text);
+		check_members(str.begin(), str.end(), text);
+		check_members(str.crbegin(), str.crend(), std::string(text.rbegin(), text.rend()));
+	}
+}
+
+/* istreambuf_iterator is read once, every character of the stream ends up in the String */
+static void test_stream()
+{
+	for (size_t len : { size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), size_t(1000), size_t(100000) }) {
+		const std::string text = random_text(len);
+		auto check = [&](auto make) {
+			std::istringstream stream(text);
+			const std::string base = random_text(random_below(40));
+			String str(base.begin(), base.end());
+			const std::string expected = make(str, std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>(), base);
+			CHECK(holds(str, expected));
+		};
+		check([&](String& str, auto first, auto last, const std::string&) {
+			str = String(first, last);
+			return text;
+		});
+		check([&](String& str, auto first, auto last, const std::string& base) {
+			str.append(first, last);
+			return base + text;
+		});
+		check([&](String& str, auto first, auto last, const std::string&) {
+			str.assign(first, last);
+			return text;
+		});
+		check([&](String& str, auto first, auto last, const std::string& base) {
+			const size_t at = base.size() / 2;
+			str.insert(str.begin() + at, first, last);
+			return std::string(base).insert(at, text);
+		});
+		check([&](String& str, auto first, auto last, const std::string& base) {
+			const size_t at = base.size() / 3, count = base.size() / 3;
+			str.replace(str.begin() + at, str.begin() + at + count, first, last);
+			return std::string(base).replace(at, count, text);
+		});
+	}
+}
+
+/* Ranges read from the String itself are read before the String changes, also when it has to grow */
+static void test_own_iterators()
+{
+	for (int round = 0; round < 2000; round++) {
+		const std::string text = random_text(1 + random_below(60));
+		String str(text.begin(), text.end());
+		if (random_below(2))
+			str.shrink_to_fit();
+		else
+			str.reserve(200);
+		const size_t first = random_below(text.size() + 1), last = first + random_below(text.size() - first + 1);
+		const size_t at = random_below(text.size() + 1), count = random_below(text.size() - at + 1);
+		const std::string range = text.substr(first, last - first);
+		const std::string reversed(range.rbegin(), range.rend());
+
+		switch (round % 6) {
+		case 0:
+			str.append(str.begin() + first, str.begin() + last);
+			CHECK(holds(str, text + range));
+			break;
+		case 1:
+			str.assign(str.cbegin() + first, str.cbegin() + last);
+			CHECK(holds(str, range));
+			break;
+		case 2:
+			str.insert(str.begin() + at, str.begin() + first, str.begin() + last);
+			CHECK(holds(str, std::string(text).insert(at, range)));
+			break;
+		case 3:
+			str.replace(str.begin() + at, str.begin() + at + count, str.begin() + first, str.begin() + last);
+			CHECK(holds(str, std::string(text).replace(at, count, range)));
+			break;
+		case 4:
+			str.insert(str.begin() + at, str.rbegin() + (text.size() - last), str.rbegin() + (text.size() - first));
+			CHECK(holds(str, std::string(text).insert(at, reversed)));
+			break;
+		default:
+			str.replace(str.begin() + at, str.begin() + at + count, str.rbegin() + (text.size() - last),
+				str.rbegin() + (text.size() - first));
+			CHECK(holds(str, std::string(text).replace(at, count, reversed)));
+			break;
+		}
+	}
+}
+
+int main()
+{
+	test_containers();
+	test_stream();
+	test_own_iterators();
+	return test_result("range_test");
+}
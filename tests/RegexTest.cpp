@@ -0,0 +1,392 @@
+#include "../StringRegex.h"
+#include "Test.h"
+
+#include <bitset>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Node of a random regex. The test builds the tree first, then writes it as a pattern, so the reference below
+works from the meaning of the pattern and doesn't parse it */
+struct Regex_Node
+{
+	enum Kind { Chars, Concat, Alternate, Repeat, Begin, End } kind;
+	std::bitset<256> chars; // Characters of Chars, with the case already ignored when it should be
+	std::vector<Regex_Node> children;
+	int min = 0; // Bounds of a Repeat, max is -1 when there's none
+	int max = -1;
+};
+
+typedef std::vector<bool> Positions;
+
+/* Return an empty node of the kind */
+static Regex_Node make_node(Regex_Node::Kind kind)
+{
+	Regex_Node node;
+	node.kind = kind;
+	return node;
+}
+
+/* Return the positions, where the node can stop matching after starting at one of the given positions.
+Repeats are applied until no new position appears, so empty loops end too */
+static Positions reference_ends(const Regex_Node& node, const std::string& text, const Positions& starts)
+{
+	const size_t n = text.size();
+	Positions ends(n + 1, false);
+	switch (node.kind) {
+	case Regex_Node::Chars:
+		for (size_t p = 0; p < n; p++)
+			if (starts[p] && node.chars[static_cast<unsigned char>(text[p])])
+				ends[p + 1] = true;
+		return ends;
+	case Regex_Node::Begin:
+		ends[0] = starts[0];
+		return ends;
+	case Regex_Node::End:
+		ends[n] = starts[n];
+		return ends;
+	case Regex_Node::Concat:
+		ends = starts;
+		for (const Regex_Node& child : node.children)
+			ends = reference_ends(child, text, ends);
+		return ends;
+	case Regex_Node::Alternate:
+		for (const Regex_Node& child : node.children) {
+			Positions childEnds = reference_ends(child, text, starts);
+			for (size_t p = 0; p <= n; p++)
+				ends[p] = ends[p] || childEnds[p];
+		}
+		return ends;
+	default: {
+		Positions current = starts;
+		for (int i = 0; i < node.min; i++)
+			current = reference_ends(node.children[0], text, current);
+		ends = current;
+		for (int i = node.min; node.max == -1 || i < node.max; i++) {
+			current = reference_ends(node.children[0], text, current);
+			bool added = false;
+			for (size_t p = 0; p <= n; p++) {
+				if (current[p] && !ends[p])
+					ends[p] = added = true;
+			}
+			if (!added)
+				break;
+		}
+		return ends;
+	}
+	}
+}
+
+/* Characters of the patterns and the texts, with the special ones of regexes, a newline and a byte past ASCII */
+static const char alphabet[] = { 'a', 'b', 'A', 'B', 'x', 'z', '0', '7', '_', ' ', '-', '\n', '.', '*', '+', '?', '(',
+	')', '[', ']', '{', '}', '|', '^', '$', '\\', static_cast<char>(0xC1) };
+
+/* Return a random character of the alphabet */
+static char random_char()
+{
+	return alphabet[random_below(sizeof(alphabet))];
+}
+
+/* Add the other case of every ASCII letter of the set */
+static std::bitset<256> fold_case(std::bitset<256> chars)
+{
+	for (unsigned ch = 'a'; ch <= 'z'; ch++) {
+		if (chars[ch] || chars[ch - 'a' + 'A'])
+			chars.set(ch).set(ch - 'a' + 'A');
+	}
+	return chars;
+}
+
+/* Return the characters of \d, \w or \s */
+static std::bitset<256> class_chars(char kind)
+{
+	std::bitset<256> chars;
+	for (unsigned ch = 0; ch < 256; ch++) {
+		bool digit = ch >= '0' && ch <= '9', letter = (ch | 0x20) >= 'a' && (ch | 0x20) <= 'z';
+		if ((kind == 'd' && digit) || (kind == 'w' && (digit || letter || ch == '_'))
+			|| (kind == 's' && (ch == ' ' || (ch >= '\t' && ch <= '\r'))))
+			chars.set(ch);
+	}
+	return chars;
+}
+
+/* Write a character of the alphabet so it's read literally, escaping the special ones */
+static void write_literal(std::string& pattern, char ch, bool inSet)
+{
+	const std::string special = inSet ? "\\]^-[" : "\\.*+?()[]{}|^$";
+	if (special.find(ch) != std::string::npos || (ch != '\n' && random_below(10) == 0 && !((ch | 0x20) >= 'a' && (ch | 0x20) <= 'z') && !(ch >= '0' && ch <= '9')))
+		pattern += '\\';
+	pattern += ch;
+}
+
+/* Build a random node of characters and write it: a literal, ., a class or a set */
+static Regex_Node random_chars(std::string& pattern, bool ignoreCase)
+{
+	Regex_Node node = make_node(Regex_Node::Chars);
+	const size_t kind = random_below(12);
+	if (kind < 6) {
+		const char ch = random_char();
+		node.chars.set(static_cast<unsigned char>(ch));
+		if (random_below(10) == 0) {
+			char hex[8];
+			std::snprintf(hex, sizeof(hex), "\\x%02X", static_cast<unsigned char>(ch));
+			pattern += hex;
+		}
+		else if (ch == '\n' && random_below(2)) {
+			pattern += "\\n";
+		}
+		else {
+			write_literal(pattern, ch, false);
+		}
+	}
+	else if (kind < 7) {
+		node.chars.set().reset('\n');
+		pattern += '.';
+	}
+	else if (kind < 9) {
+		const char classes[] = { 'd', 'w', 's' };
+		const char cls = classes[random_below(3)];
+		const bool negated = random_below(3) == 0;
+		node.chars = negated ? ~class_chars(cls) : class_chars(cls);
+		pattern += '\\';
+		pattern += negated ? static_cast<char>(cls - 'a' + 'A') : cls;
+	}
+	else {
+		const bool negated = random_below(3) == 0;
+		pattern += negated ? "[^" : "[";
+		for (size_t m = 1 + random_below(3); m > 0; m--) {
+			const size_t item = random_below(6);
+			if (item == 0) {
+				const char low = "abAx0"[random_below(5)], high = "bzBZ9"[random_below(5)];
+				if (low > high)
+					continue;
+				pattern += low;
+				pattern += '-';
+				pattern += high;
+				for (unsigned ch = static_cast<unsigned char>(low); ch <= static_cast<unsigned char>(high); ch++)
+					node.chars.set(ch);
+			}
+			else if (item == 1) {
+				const char cls = "dws"[random_below(3)];
+				pattern += '\\';
+				pattern += cls;
+				node.chars |= class_chars(cls);
+			}
+			else {
+				const char ch = random_char();
+				write_literal(pattern, ch, true);
+				node.chars.set(static_cast<unsigned char>(ch));
+			}
+		}
+		if (node.chars.none()) {
+			pattern += 'q';
+			node.chars.set('q');
+		}
+		pattern += ']';
+		// The set is negated after its case is folded, so [^a] leaves out A too
+		if (ignoreCase)
+			node.chars = fold_case(node.chars);
+		if (negated)
+			node.chars.flip();
+		return node;
+	}
+	if (ignoreCase)
+		node.chars = fold_case(node.chars);
+	return node;
+}
+
+/* Build a random regex tree of at most (depth) levels and write it as a pattern */
+static Regex_Node random_regex(std::string& pattern, int depth, bool ignoreCase)
+{
+	const size_t kind = depth > 0 ? random_below(10) : 0;
+	if (kind < 4)
+		return random_chars(pattern, ignoreCase);
+	if (kind == 4) {
+		const bool begin = random_below(2);
+		pattern += begin ? '^' : '$';
+		return make_node(begin ? Regex_Node::Begin : Regex_Node::End);
+	}
+	if (kind < 7) {
+		Regex_Node node = make_node(Regex_Node::Concat);
+		for (size_t i = random_below(4); i > 0; i--) {
+			std::string child;
+			Regex_Node childNode = random_regex(child, depth - 1, ignoreCase);
+			if (childNode.kind == Regex_Node::Alternate)
+				child = "(?:" + child + ")";
+			pattern += child;
+			node.children.push_back(childNode);
+		}
+		return node;
+	}
+	if (kind < 8) {
+		Regex_Node node = make_node(Regex_Node::Alternate);
+		for (size_t i = 2 + random_below(2); i > 0; i--) {
+			node.children.push_back(random_regex(pattern, depth - 1, ignoreCase));
+			if (i > 1)
+				pattern += '|';
+		}
+		return node;
+	}
+
+	Regex_Node node = make_node(Regex_Node::Repeat);
+	std::string child;
+	node.children.push_back(random_regex(child, depth - 1, ignoreCase));
+	const Regex_Node::Kind childKind = node.children[0].kind;
+	if (childKind != Regex_Node::Chars || random_below(6) == 0)
+		child = (random_below(2) ? "(" : "(?:") + child + ")";
+	pattern += child;
+	switch (random_below(6)) {
+	case 0: node.min = 0; node.max = -1; pattern += '*'; break;
+	case 1: node.min = 1; node.max = -1; pattern += '+'; break;
+	case 2: node.min = 0; node.max = 1; pattern += '?'; break;
+	case 3:
+		node.min = node.max = static_cast<int>(random_below(4));
+		pattern += '{';
+		pattern += std::to_string(node.min);
+		pattern += '}';
+		break;
+	case 4:
+		node.min = static_cast<int>(random_below(3));
+		pattern += '{';
+		pattern += std::to_string(node.min);
+		pattern += ",}";
+		break;
+	default:
+		node.min = static_cast<int>(random_below(3));
+		node.max = node.min + static_cast<int>(random_below(3));
+		pattern += '{';
+		pattern += std::to_string(node.min);
+		pattern += ',';
+		pattern += std::to_string(node.max);
+		pattern += '}';
+		break;
+	}
+	return node;
+}
+
+/* Write a random text, that the node matches, unless it has anchors in the wrong places */
+static void sample_text(const Regex_Node& node, std::string& text)
+{
+	switch (node.kind) {
+	case Regex_Node::Chars:
+		for (int tries = 0; tries < 8; tries++) {
+			const char ch = random_char();
+			if (node.chars[static_cast<unsigned char>(ch)]) {
+				text += ch;
+				return;
+			}
+		}
+		for (unsigned ch = random_below(256), i = 0; i < 256; i++, ch = (ch + 1) % 256) {
+			if (node.chars[ch]) {
+				text += static_cast<char>(ch);
+				return;
+			}
+		}
+		return;
+	case Regex_Node::Concat:
+		for (const Regex_Node& child : node.children)
+			sample_text(child, text);
+		return;
+	case Regex_Node::Alternate:
+		sample_text(node.children[random_below(node.children.size())], text);
+		return;
+	case Regex_Node::Repeat: {
+		int count = node.min + static_cast<int>(random_below(3));
+		if (node.max != -1 && count > node.max)
+			count = node.max;
+		for (int i = 0; i < count; i++)
+			sample_text(node.children[0], text);
+		return;
+	}
+	default:
+		return;
+	}
+}
+
+/* Random regexes against random texts and texts made to match them, every answer of String_Regex is checked against
+the ends the reference finds from every start */
+static void test_random_regexes()
+{
+	for (int round = 0; round < 3000; round++) {
+		const bool ignoreCase = random_below(4) == 0;
+		std::string pattern;
+		const Regex_Node root = random_regex(pattern, 4, ignoreCase);
+		String_Regex regex(pattern, ignoreCase);
+		CHECK(regex.ignores_case() == ignoreCase);
+
+		for (int k = 0; k < 12; k++) {
+			std::string text;
+			for (size_t i = random_below(k % 2 ? 4 : 30); i > 0; i--)
+				text += random_char();
+			if (k % 2) {
+				sample_text(root, text);
+				for (size_t i = random_below(4); i > 0; i--)
+					text += random_char();
+			}
+
+			// Ends of the matches from every start
+			const size_t n = text.size(), none = String::npos;
+			std::vector<size_t> longest(n + 1, none);
+			bool anywhere = false;
+			for (size_t start = 0; start <= n; start++) {
+				Positions starts(n + 1, false);
+				starts[start] = true;
+				const Positions ends = reference_ends(root, text, starts);
+				for (size_t p = start; p <= n; p++)
+					if (ends[p])
+						longest[start] = p;
+				anywhere = anywhere || longest[start] != String::npos;
+			}
+
+			CHECK(regex.matches(text) == (longest[0] == n));
+			CHECK(regex.search(text) == anywhere);
+			CHECK(regex.matches(String(text.c_str())) == regex.matches(std::string_view(text.c_str())));
+			for (size_t pos = 0; pos <= n + 1; pos++) {
+				size_t start = pos;
+				while (start <= n && longest[start] == String::npos)
+					start++;
+				const String_Regex::Match match = regex.find(text, pos);
+				if (start > n) {
+					CHECK(match.position == String::npos);
+					continue;
+				}
+				CHECK(match.position == start && match.length == longest[start] - start);
+				// Every match contains the required literal
+				if (match.position == start)
+					CHECK(text.substr(start, match.length).find(regex.required_literal().c_str()) != std::string::npos);
+			}
+		}
+
+		// A copy matches the same, with the DFA built so far
+		String_Regex copy(regex);
+		CHECK(copy.search(pattern) == regex.search(pattern));
+	}
+}
+
+/* Patterns, that String_Regex doesn't understand or that are wrong, throw invalid_argument */
+static void test_invalid_patterns()
+{
+	const char* patterns[] = { "(a", "a)", "*a", "+", "a|?", "{2}", "a*?", "a+?", "(?=a)", "(?!a)", "(?<n>a)", "a{3,1}",
+		"a{1001}", "[b-a]", "[a", "[^", "a\\", "\\1", "\\b", "\\xZ1", "\\x4" };
+	for (const char* pattern : patterns) {
+		bool thrown = false;
+		try { String_Regex regex(pattern); } catch (const std::invalid_argument&) { thrown = true; }
+		if (!thrown)
+			std::fprintf(stderr, "pattern didn't throw: %s\n", pattern);
+		CHECK(thrown);
+	}
+
+	// Characters, that are only special in places
+	CHECK(String_Regex("a{").matches("a{") && String_Regex("a{,2}").matches("a{,2}") && String_Regex("]}").matches("]}"));
+	CHECK(String_Regex("[]a]+").matches("]a]") && String_Regex("[a-]").matches("-"));
+	CHECK(String_Regex("[\\d-z]+").matches("1-z") && !String_Regex("[\\d-z]").matches("y"));
+}
+
+int main()
+{
+	test_random_regexes();
+	test_invalid_patterns();
+	return test_result("regex_test");
+}
@@ -0,0 +1,148 @@
+#include "../Rope.h"
+#include "Test.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Return random text of (n) characters, from a few letters so the edits are easy to follow when a check fails */
+static std::string random_text(size_t n)
+{
+	std::string text(n, ' ');
+	for (char& ch : text)
+		ch = static_cast<char>('a' + random_below(6));
+	return text;
+}
+
+/* Return a random length, mostly short, sometimes past a leaf or several of them */
+static size_t random_length()
+{
+	switch (random_below(4)) {
+	case 0:
+		return random_below(4);
+	case 1:
+		return random_below(64);
+	case 2:
+		return random_below(Rope::max_leaf + 10);
+	default:
+		return random_below(4 * Rope::max_leaf);
+	}
+}
+
+/* Check every way of reading the Rope against the text, that it should hold */
+static void check_equal(const Rope& rope, const std::string& expected)
+{
+	CHECK(rope.size() == expected.size());
+	CHECK(rope.empty() == expected.empty());
+	CHECK(rope.depth() < 64);
+	String flat = rope.flatten();
+	CHECK(std::string(flat.data(), flat.size()) == expected);
+
+	std::string chunks;
+	rope.for_each_chunk([&](const char* cptr, size_t n) { chunks.append(cptr, n); });
+	CHECK(chunks == expected);
+
+	if (!expected.empty()) {
+		CHECK(rope.front() == expected.front() && rope.back() == expected.back());
+		for (int i = 0; i < 16; i++) {
+			size_t pos = random_below(expected.size());
+			CHECK(rope[pos] == expected[pos] && rope.at(pos) == expected[pos]);
+			CHECK(*(rope.begin() + pos) == expected[pos]);
+		}
+	}
+	CHECK(std::string(rope.begin(), rope.end()) == expected);
+	CHECK(static_cast<size_t>(rope.end() - rope.begin()) == expected.size());
+}
+
+/* Random edits of a Rope and a std::string, checked against each other after every one. Copies taken on the way
+share the tree, so they're checked again at the end to be sure no edit changed them */
+static void test_edits()
+{
+	for (int round = 0; round < 200; round++) {
+		std::string expected = random_text(random_length());
+		Rope rope(expected.c_str(), expected.size());
+		std::vector<std::pair<Rope, std::string>> copies;
+
+		for (int step = 0; step < 60; step++) {
+			const size_t pos = random_below(expected.size() + 1);
+			const size_t len = random_below(4) ? random_below(expected.size() - pos + 1) : Rope::npos;
+			const std::string text = random_text(random_length());
+			switch (random_below(9)) {
+			case 0:
+				rope.append(text.c_str(), text.size());
+				expected += text;
+				break;
+			case 1:
+				rope += String(text.c_str());
+				expected += text;
+				break;
+			case 2:
+				rope.push_back('z');
+				expected.push_back('z');
+				break;
+			case 3:
+				rope.insert(pos, text.c_str(), text.size());
+				expected.insert(pos, text);
+				break;
+			case 4:
+				rope.insert(pos, Rope(text.c_str()));
+				expected.insert(pos, text);
+				break;
+			case 5:
+				rope.erase(pos, len);
+				expected.erase(pos, len);
+				break;
+			case 6:
+				rope.replace(pos, len, Rope(text.c_str()));
+				expected.replace(pos, len, text);
+				break;
+			case 7: {
+				Rope part = rope.substr(pos, len);
+				std::string expectedPart = expected.substr(pos, len);
+				check_equal(part, expectedPart);
+				rope = part + rope;
+				expected = expectedPart + expected;
+				break;
+			}
+			default:
+				copies.emplace_back(rope, expected);
+				break;
+			}
+			check_equal(rope, expected);
+		}
+		for (const auto& copy : copies) {
+			check_equal(copy.first, copy.second);
+			CHECK((copy.first == rope) == (copy.second == expected));
+			CHECK((copy.first != rope) == (copy.second != expected));
+		}
+	}
+}
+
+/* Positions past the end throw out_of_range, like String's */
+static void test_errors()
+{
+	Rope rope("abc");
+	bool thrown = false;
+	try { rope.insert(4, "x"); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { rope.erase(4); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { rope.substr(4); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { rope.at(3); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { Rope().front(); } catch (const std::runtime_error&) { thrown = true; }
+	CHECK(thrown);
+	check_equal(rope, "abc");
+}
+
+int main()
+{
+	test_edits();
+	test_errors();
+	return test_result("rope_test");
+}
@@ -0,0 +1,157 @@
+#include "../String.h"
+#include "../StringTrace.h"
+#include "Test.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/* Return the work counted since the counters were last reset, by this thread */
+static String_Stats counted()
+{
+	return String_Stats::thread_snapshot();
+}
+
+/* Growing a buffer counts a reallocation, that moves only the text that's kept */
+static void test_reallocations()
+{
+	String str("abcdef");
+	String_Stats::reset();
+	str.reserve(32);
+	CHECK(counted().allocations == 1 && counted().reallocations == 1 && counted().bytesCopied == 6);
+
+	str = "abcdef";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str.append(10, 'x');
+	CHECK(counted().reallocations == 1 && counted().bytesCopied == 6);
+
+	str = "abcdef";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str.push_back('g');
+	CHECK(counted().reallocations == 1 && counted().bytesCopied == 6);
+
+	str = "abcdef";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str.resize(20);
+	CHECK(counted().reallocations == 1 && counted().bytesCopied == 6);
+
+	// Replacing 4 of the 6 characters keeps only the other 2
+	str = "abcdef";
+	String_Stats::reset();
+	str.replace(1, 4, "0123456789");
+	CHECK(counted().reallocations == 1 && counted().bytesCopied == 2);
+}
+
+/* Assigning throws the old text away, only the assigned text can be a copy */
+static void test_assignments()
+{
+	const String big16("0123456789abcdef");
+
+	String str("abc");
+	String_Stats::reset();
+	str.assign(big16, 0, 16);
+	CHECK(counted().allocations == 1 && counted().reallocations == 0);
+	CHECK(counted().copies == 1 && counted().bytesCopied == 16);
+
+	str = "abc";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str.assign(big16, 4, 8);
+	CHECK(counted().reallocations == 0 && counted().bytesCopied == 8);
+
+	str = "abc";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str = big16;
+	CHECK(counted().reallocations == 0 && counted().bytesCopied == 16);
+
+	const char* ptr = "0123456789abcdef";
+	str = "abc";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str = ptr;
+	CHECK(counted().allocations == 1 && counted().reallocations == 0);
+
+	str = "abc";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str.assign(ptr, 12);
+	CHECK(counted().allocations == 1 && counted().reallocations == 0);
+
+	str = "abc";
+	str.shrink_to_fit();
+	String_Stats::reset();
+	str.assign(20, 'z');
+	CHECK(counted().allocations == 1 && counted().reallocations == 0 && counted().bytesCopied == 0);
+}
+
+/* format_to() measures the text first, so it appends without allocating when the capacity is enough, and with one
+allocation when it isn't */
+static void test_format_to()
+{
+	String str("value: ");
+	str.reserve(200);
+	String_Stats::reset();
+	format_to(str, "{} {:x} {:.3f} {}", 12345, 255u, 3.14159, "text");
+	CHECK(str == "value: 12345 ff 3.142 text");
+	CHECK(counted().allocations == 0 && counted().reallocations == 0);
+
+	const String more("more");
+	str.shrink_to_fit();
+	String_Stats::reset();
+	format_to(str, " {} {}", 1.5, more);
+	CHECK(str == "value: 12345 ff 3.142 text 1.5 more");
+	CHECK(counted().allocations == 1 && counted().reallocations == 1);
+}
+
+/* Sampling every byte catches the allocations, written as "frame;frame;... bytes" lines without the tracer's frames */
+static void test_trace()
+{
+	String_Trace::reset();
+	String_Trace::start(1);
+	CHECK(String_Trace::active());
+	for (int i = 0; i < 100; i++) {
+		String str(100 + i, 'x');
+		str += str;
+	}
+	String_Trace::stop();
+	const size_t taken = String_Trace::samples();
+	CHECK(taken > 0);
+	String kept(1000, 'y');
+	CHECK(!String_Trace::active() && String_Trace::samples() == taken);
+
+	const char* path = "stats_test.folded";
+	CHECK(String_Trace::write_folded(path));
+	std::ifstream file(path);
+	std::string line;
+	size_t lines = 0, stacks = 0;
+	while (std::getline(file, line)) {
+		lines++;
+		// Demangled names can have spaces, the bytes come after the last one
+		const size_t space = line.rfind(' ');
+		CHECK(space != std::string::npos && space > 0 && space + 1 < line.size());
+		if (space == std::string::npos)
+			continue;
+		CHECK(line.find_first_not_of("0123456789", space + 1) == std::string::npos && line[space + 1] != '0');
+		CHECK(line.find("String_Trace::") == std::string::npos);
+		stacks += line.find(';') < space;
+	}
+	file.close();
+	std::remove(path);
+	CHECK(lines > 0 && lines <= taken && stacks > 0);
+
+	String_Trace::reset();
+	CHECK(String_Trace::samples() == 0);
+}
+
+int main()
+{
+	test_reallocations();
+	test_assignments();
+	test_format_to();
+	test_trace();
+	return test_result("stats_test");
+}
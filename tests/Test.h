@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdio>
+#include <random>
+
+/*********************************************** TEST HELPERS ***************************************************/
+
+//Failed checks of the test program, only the first few are printed
+inline int testFailures = 0;
+static const int maxPrintedFailures = 20;
+
+/* Report the failed check, with the place it's at */
+inline void report_failure(const char* check, const char* file, int line)
+{
+	if (++testFailures <= maxPrintedFailures)
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, check);
+}
+
+/* Check the condition and go on with the test, even when it's false */
+#define CHECK(condition)                                       \
+	do {                                                       \
+		if (!(condition))                                      \
+			report_failure(#condition, __FILE__, __LINE__);    \
+	} while (false)
+
+/* Print the result of the test program and return its exit code */
+inline int test_result(const char* name)
+{
+	if (testFailures) {
+		std::fprintf(stderr, "%s: %d checks failed\n", name, testFailures);
+		return 1;
+	}
+	std::printf("%s: passed\n", name);
+	return 0;
+}
+
+/* Random numbers of the tests, the same on every run */
+inline std::mt19937& test_random()
+{
+	static std::mt19937 rng(12345);
+	return rng;
+}
+
+/* Return a random number in [0, n) */
+inline size_t random_below(size_t n)
+{
+	return test_random()() % n;
+}
@@ -0,0 +1,134 @@
+#include "../String.h"
+#include "Test.h"
+
+#include <string>
+#include <string_view>
+
+/* Return the characters of the text left after trimming the members from the chosen ends, the slow and simple way */
+static std::string reference_trim(const std::string& text, const std::string& members, bool left, bool right)
+{
+	size_t first = 0, last = text.size();
+	while (right && last > 0 && members.find(text[last - 1]) != std::string::npos)
+		last--;
+	while (left && first < last && members.find(text[first]) != std::string::npos)
+		first++;
+	return text.substr(first, last - first);
+}
+
+/* Check every trimming function with the set, and the ones without a set if the members are the whitespace */
+static void check_trim(const std::string& text, const std::string& members, bool whitespace)
+{
+	const String::Char_Set set(members.data(), members.size());
+	const String str(text.begin(), text.end());
+	const std::string both = reference_trim(text, members, true, true);
+	const std::string left = reference_trim(text, members, true, false);
+	const std::string right = reference_trim(text, members, false, true);
+
+	CHECK(str.trimmed(set) == both);
+	CHECK(str.ltrimmed(set) == left);
+	CHECK(str.rtrimmed(set) == right);
+	String trimmed(str), ltrimmed(str), rtrimmed(str);
+	trimmed.trim(set);
+	ltrimmed.ltrim(set);
+	rtrimmed.rtrim(set);
+	CHECK(std::string_view(trimmed.data(), trimmed.size()) == both && trimmed.c_str()[trimmed.size()] == '\0');
+	CHECK(std::string_view(ltrimmed.data(), ltrimmed.size()) == left && ltrimmed.c_str()[ltrimmed.size()] == '\0');
+	CHECK(std::string_view(rtrimmed.data(), rtrimmed.size()) == right && rtrimmed.c_str()[rtrimmed.size()] == '\0');
+
+	if (whitespace) {
+		CHECK(str.trimmed() == both && str.ltrimmed() == left && str.rtrimmed() == right);
+		trimmed = str;
+		ltrimmed = str;
+		rtrimmed = str;
+		trimmed.trim();
+		ltrimmed.ltrim();
+		rtrimmed.rtrim();
+		CHECK(std::string_view(trimmed.data(), trimmed.size()) == both);
+		CHECK(std::string_view(ltrimmed.data(), ltrimmed.size()) == left);
+		CHECK(std::string_view(rtrimmed.data(), rtrimmed.size()) == right);
+	}
+}
+
+/* Return (count) different random bytes, any of the 256 or only the ones past 0x7F */
+static std::string random_members(size_t count, bool high)
+{
+	bool taken[256] = {};
+	std::string members;
+	while (members.size() < count) {
+		const size_t ch = high ? 128 + random_below(128) : random_below(256);
+		if (!taken[ch]) {
+			taken[ch] = true;
+			members += static_cast<char>(ch);
+		}
+	}
+	return members;
+}
+
+/* Return a random byte, that isn't one of the members */
+static char random_outsider(const std::string& members)
+{
+	for (;;) {
+		const char ch = static_cast<char>(random_below(256));
+		if (members.find(ch) == std::string::npos)
+			return ch;
+	}
+}
+
+/* Runs of members at both ends, their lengths around multiples of 16, so the first character to keep is found in
+every place of a block, in the tail after the last whole block, or not at all. Sets of 16 members and fewer are
+scanned with vector comparisons, larger ones with the bitmap */
+static void test_random_sets()
+{
+	for (size_t count : { size_t(0), size_t(1), size_t(2), size_t(5), size_t(15), size_t(16), size_t(17), size_t(40),
+		size_t(200), size_t(255) }) {
+		for (int round = 0; round < 300; round++) {
+			// Bytes past 0x7F compare as negative in the vector kernels
+			const std::string members = random_members(count, count <= 128 && round % 3 == 0);
+			CHECK(String::Char_Set(members.data(), members.size()).small() == (count <= String::Char_Set::max_members));
+			std::string text;
+			size_t head = 16 * random_below(5) + random_below(4), tail = 16 * random_below(5) + random_below(4);
+			head -= (head > 0);
+			tail -= (tail > 0);
+			const size_t middle = random_below(40);
+			for (size_t i = 0; i < head + middle + tail; i++) {
+				const bool inside = (i < head || i >= head + middle) ? random_below(12) != 0 : random_below(3) == 0;
+				text += (inside && count) ? members[random_below(count)] : random_outsider(members);
+			}
+			check_trim(text, members, false);
+			// The same text without the characters to keep, every byte of it trimmed
+			std::string all;
+			for (char ch : text)
+				if (members.find(ch) != std::string::npos)
+					all += ch;
+			check_trim(all, members, false);
+		}
+	}
+}
+
+/* Every length from 0 to 70 of whitespace around a word, and of the word alone */
+static void test_whitespace()
+{
+	const std::string whitespace = " \t\n\v\f\r";
+	for (size_t head = 0; head < 70; head++) {
+		for (size_t tail : { size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), size_t(33), size_t(64) }) {
+			std::string text;
+			for (size_t i = 0; i < head; i++)
+				text += whitespace[random_below(whitespace.size())];
+			text += random_below(2) ? "word" : "a \t b";
+			for (size_t i = 0; i < tail; i++)
+				text += whitespace[random_below(whitespace.size())];
+			check_trim(text, whitespace, true);
+			check_trim(std::string(head + tail, ' '), whitespace, true);
+			// Other control characters and bytes past 0x7F aren't whitespace
+			check_trim(text + "\x85", whitespace, true);
+			check_trim("\xA0" + text, whitespace, true);
+		}
+	}
+}
+
+int main()
+{
+	test_random_sets();
+	test_whitespace();
+	return test_result("trim_test");
+}
@@ -0,0 +1,173 @@
+#include "../String.h"
+#include "Test.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Decode the sequence starting at (i) straight from the definition of UTF-8: the code point must fit in the shortest
+form, and it can't be a surrogate or past U+10FFFF. Return its length, or 0 if it is malformed */
+static size_t reference_sequence(const std::string& text, size_t i, char32_t& value)
+{
+	const unsigned char lead = static_cast<unsigned char>(text[i]);
+	size_t len;
+	if (lead < 0x80)
+		len = 1, value = lead;
+	else if ((lead & 0xE0) == 0xC0)
+		len = 2, value = lead & 0x1F;
+	else if ((lead & 0xF0) == 0xE0)
+		len = 3, value = lead & 0x0F;
+	else if ((lead & 0xF8) == 0xF0)
+		len = 4, value = lead & 0x07;
+	else
+		return 0;
+	if (text.size() - i < len)
+		return 0;
+	for (size_t k = 1; k < len; k++) {
+		const unsigned char next = static_cast<unsigned char>(text[i + k]);
+		if ((next & 0xC0) != 0x80)
+			return 0;
+		value = (value << 6) | (next & 0x3F);
+	}
+	const char32_t shortest[] = { 0, 0, 0x80, 0x800, 0x10000 };
+	if (value < shortest[len] || (value >= 0xD800 && value <= 0xDFFF) || value > 0x10FFFF)
+		return 0;
+	return len;
+}
+
+/* Check if the whole text is valid UTF-8, one sequence at a time */
+static bool reference_valid(const std::string& text)
+{
+	char32_t value;
+	for (size_t i = 0, len; i < text.size(); i += len)
+		if (!(len = reference_sequence(text, i, value)))
+			return false;
+	return true;
+}
+
+/* Return offsets of the bytes, that aren't continuation bytes */
+static std::vector<size_t> lead_offsets(const std::string& text)
+{
+	std::vector<size_t> leads;
+	for (size_t i = 0; i < text.size(); i++)
+		if ((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80)
+			leads.push_back(i);
+	return leads;
+}
+
+/* Check every UTF-8 function of the String against the references */
+static void check_utf8(const std::string& text)
+{
+	const String str(text.begin(), text.end());
+	CHECK(str.size() == text.size());
+	if (str.utf8_valid() != reference_valid(text)) {
+		CHECK(str.utf8_valid() == reference_valid(text));
+		return;
+	}
+	const std::vector<size_t> leads = lead_offsets(text);
+	CHECK(str.utf8_length() == leads.size());
+
+	// Malformed sequences are read as U+FFFD, one byte long
+	size_t i = 0;
+	bool decoded = true;
+	for (auto it = str.code_points().begin(), end = str.code_points().end(); it != end && decoded; ++it) {
+		char32_t value = 0;
+		size_t len = reference_sequence(text, i, value);
+		if (!len)
+			len = 1, value = 0xFFFD;
+		decoded = it.position() == str.data() + i && it.length() == len && *it == value;
+		i += len;
+	}
+	CHECK(decoded && i == text.size());
+
+	const size_t pos = random_below(leads.size() + 2), len = random_below(4) ? random_below(leads.size() + 2) : String::npos;
+	if (pos > leads.size()) {
+		bool thrown = false;
+		try { str.utf8_substr(pos, len); } catch (const std::out_of_range&) { thrown = true; }
+		CHECK(thrown);
+	}
+	else {
+		const size_t first = (pos < leads.size()) ? leads[pos] : text.size();
+		const size_t last = (len != String::npos && pos + len < leads.size()) ? leads[pos + len] : text.size();
+		const String sub = str.utf8_substr(pos, len);
+		CHECK(std::string(sub.data(), sub.size()) == text.substr(first, last - first));
+	}
+
+	const size_t n = random_below(text.size() + 2);
+	size_t kept = n;
+	if (kept < text.size())
+		while (kept > 0 && (static_cast<unsigned char>(text[kept]) & 0xC0) == 0x80)
+			kept--;
+	else
+		kept = text.size();
+	String truncated(str);
+	truncated.utf8_truncate(n);
+	CHECK(std::string(truncated.data(), truncated.size()) == text.substr(0, kept) && truncated.c_str()[kept] == '\0');
+}
+
+/* Well-formed and malformed sequences: overlongs, surrogates, values past U+10FFFF, bytes that never start one,
+lone continuation bytes and sequences cut short */
+static const std::vector<std::string> pieces = {
+	"a", "~", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+	"\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\xF3\xBF\xBF\xBF",
+	"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+	"\xED\xA0\x80", "\xED\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF7\xBF\xBF\xBF",
+	"\xF8\x88\x80\x80\x80", "\xFE", "\xFF", "\x80", "\xBF",
+	"\xC2", "\xE0\xA0", "\xE1", "\xF0\x90\x80", "\xF4\x8F", "\xF1"
+};
+
+/* Every piece at every place around the ends of 16 and 64 byte blocks, as the last thing in the text,
+or followed by ASCII and another piece */
+static void test_block_ends()
+{
+	for (const std::string& piece : pieces) {
+		for (size_t at = 0; at < 72; at++) {
+			std::string text(at, 'x');
+			text += piece;
+			check_utf8(text);
+			check_utf8(text + "yz");
+			check_utf8(text + pieces[random_below(pieces.size())]);
+			// Cut short right at the end of the block, or one byte past it
+			for (size_t end : { size_t(16), size_t(17), size_t(32), size_t(64), size_t(65) })
+				if (end < text.size())
+					check_utf8(text.substr(0, end));
+		}
+	}
+}
+
+/* Every two-byte text and every lead byte with every second byte, between ASCII that puts them across a block end */
+static void test_byte_pairs()
+{
+	for (unsigned first = 0; first < 256; first++) {
+		for (unsigned second = 0; second < 256; second++) {
+			std::string pair{ static_cast<char>(first), static_cast<char>(second) };
+			check_utf8(pair);
+			check_utf8(std::string(15, 'x') + pair);
+			check_utf8(std::string(14, 'x') + pair + "\x80\x80");
+			check_utf8(std::string(63, 'x') + pair + "\xBF");
+		}
+	}
+}
+
+/* Random texts made of the pieces, long enough for many blocks */
+static void test_random_texts()
+{
+	for (int round = 0; round < 20000; round++) {
+		std::string text;
+		const size_t count = random_below(40);
+		const bool valid = random_below(2);
+		for (size_t i = 0; i < count; i++) {
+			const std::string& piece = pieces[random_below(valid ? 11 : pieces.size())];
+			text += (random_below(3) == 0) ? std::string(random_below(40), 'a') : piece;
+		}
+		check_utf8(text);
+	}
+}
+
+int main()
+{
+	test_block_ends();
+	test_byte_pairs();
+	test_random_texts();
+	return test_result("utf8_test");
+}
@@ -0,0 +1,204 @@
+#include "../StringVector.h"
+#include "Test.h"
+
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/* Return random text, empty, short or long */
+static std::string random_text()
+{
+	std::string text(random_below(3) ? random_below(12) : random_below(200), ' ');
+	for (char& ch : text)
+		ch = static_cast<char>('a' + random_below(26));
+	return text;
+}
+
+/* Check the StringVector against the std::vector, that it should hold the same texts */
+static void check_equal(const StringVector& vec, const std::vector<std::string>& expected)
+{
+	CHECK(vec.size() == expected.size());
+	CHECK(vec.empty() == expected.empty());
+	CHECK(vec.capacity() >= vec.size());
+	CHECK(static_cast<size_t>(vec.end() - vec.begin()) == vec.size());
+	if (vec.size() != expected.size())
+		return;
+	for (size_t i = 0; i < expected.size(); i++) {
+		const String& str = vec[i];
+		if (std::string(str.data(), str.size()) != expected[i] || str.c_str()[str.size()] != '\0') {
+			CHECK(std::string(str.data(), str.size()) == expected[i]);
+			break;
+		}
+	}
+	if (!expected.empty()) {
+		CHECK(std::string(vec.front().c_str()) == expected.front());
+		CHECK(std::string(vec.back().c_str()) == expected.back());
+	}
+}
+
+/* Random operations on a StringVector and a std::vector<std::string>, checked against each other after every one.
+Some of them take their argument from the vector itself, while it grows */
+static void test_operations()
+{
+	for (int round = 0; round < 100; round++) {
+		StringVector vec;
+		std::vector<std::string> expected;
+
+		for (int step = 0; step < 400; step++) {
+			const std::string text = random_text();
+			switch (random_below(12)) {
+			case 0:
+			case 1: {
+				String str(text.c_str());
+				vec.push_back(str);
+				expected.push_back(text);
+				break;
+			}
+			case 2:
+				vec.push_back(String(text.c_str()));
+				expected.push_back(text);
+				break;
+			case 3:
+				vec.emplace_back(text.c_str(), text.size());
+				expected.push_back(text);
+				break;
+			case 4:
+				// A copy of its own String, made before the old buffer goes away
+				if (!expected.empty()) {
+					const size_t at = random_below(expected.size());
+					vec.emplace_back(vec[at]);
+					expected.push_back(expected[at]);
+				}
+				break;
+			case 5: {
+				// Views into the vector's own Strings, and new text
+				std::vector<std::string_view> views;
+				const size_t count = random_below(20);
+				std::vector<std::string> texts;
+				texts.reserve(count);
+				for (size_t i = 0; i < count; i++) {
+					if (!expected.empty() && random_below(2)) {
+						const size_t at = random_below(expected.size());
+						views.emplace_back(vec[at].data(), vec[at].size());
+						texts.push_back(expected[at]);
+					}
+					else {
+						texts.push_back(random_text());
+						views.emplace_back(texts.back());
+					}
+				}
+				vec.emplace_back_all(views);
+				expected.insert(expected.end(), texts.begin(), texts.end());
+				break;
+			}
+			case 6:
+				if (!expected.empty()) {
+					vec.pop_back();
+					expected.pop_back();
+				}
+				break;
+			case 7:
+				if (!expected.empty()) {
+					const size_t at = random_below(expected.size());
+					vec[at] += text.c_str();
+					expected[at] += text;
+				}
+				break;
+			case 8:
+				vec.reserve(vec.size() + random_below(50));
+				break;
+			case 9:
+				vec.shrink_to_fit();
+				CHECK(vec.capacity() == vec.size());
+				break;
+			case 10: {
+				StringVector copy(vec);
+				check_equal(copy, expected);
+				CHECK(copy == vec && !(copy != vec));
+				StringVector moved(std::move(copy));
+				check_equal(moved, expected);
+				StringVector assigned;
+				assigned.push_back(String("old"));
+				assigned = moved;
+				check_equal(assigned, expected);
+				moved.push_back(String("extra"));
+				CHECK(moved != vec);
+				swap(vec, moved);
+				expected.push_back("extra");
+				check_equal(moved, std::vector<std::string>(expected.begin(), expected.end() - 1));
+				break;
+			}
+			default:
+				if (random_below(20) == 0) {
+					vec.clear();
+					expected.clear();
+				}
+				break;
+			}
+			check_equal(vec, expected);
+		}
+	}
+}
+
+/* Many small batches grow the vector geometrically, like emplace_back() does, instead of to the exact size every time */
+static void test_repeated_batches()
+{
+	StringVector vec;
+	std::vector<std::string> expected;
+	size_t growths = 0;
+	for (size_t i = 0; i < 80000; i++) {
+		const size_t before = vec.capacity();
+		const std::string text = std::to_string(i);
+		std::string_view views[] = { text, "batch" };
+		vec.emplace_back_all(views);
+		expected.push_back(text);
+		expected.push_back("batch");
+		growths += vec.capacity() != before;
+	}
+	check_equal(vec, expected);
+	CHECK(growths < 30);
+}
+
+/* A single-pass range is read once, one view at a time */
+static void test_input_range()
+{
+	StringVector vec;
+	vec.push_back(String("first"));
+	std::istringstream stream("alpha beta gamma delta");
+	struct Words
+	{
+		std::istream& is;
+		std::istream_iterator<std::string> begin() const { return std::istream_iterator<std::string>(is); }
+		std::istream_iterator<std::string> end() const { return std::istream_iterator<std::string>(); }
+	} words{ stream };
+	vec.emplace_back_all(words);
+	check_equal(vec, { "first", "alpha", "beta", "gamma", "delta" });
+}
+
+/* Reading past the end throws out_of_range, reading an empty vector throws runtime_error */
+static void test_errors()
+{
+	StringVector vec;
+	bool thrown = false;
+	try { vec.at(0); } catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { vec.back(); } catch (const std::runtime_error&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { vec.pop_back(); } catch (const std::runtime_error&) { thrown = true; }
+	CHECK(thrown);
+}
+
+int main()
+{
+	test_operations();
+	test_repeated_batches();
+	test_input_range();
+	test_errors();
+	return test_result("vector_test");
+}